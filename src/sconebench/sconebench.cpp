@@ -0,0 +1,336 @@
+/*
+** sconebench.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include <tclap/CmdLine.h>
+#include "scone/core/Benchmark.h"
+#include "scone/core/Exception.h"
+#include "scone/core/Log.h"
+#include "scone/core/system_tools.h"
+#include "scone/core/version.h"
+#include "scone/sconelib_config.h"
+#include "xo/container/prop_node_tools.h"
+#include "xo/container/container_algorithms.h"
+#include "xo/filesystem/filesystem.h"
+#include "xo/serialization/serialize.h"
+#include "xo/string/string_tools.h"
+#include "xo/system/log_sink.h"
+#include "xo/system/system_tools.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <algorithm>
+
+using namespace scone;
+namespace fs = std::filesystem;
+
+// summary statistics of a single benchmark component
+struct ComponentStats
+{
+	double median = 0, mean = 0, std = 0;
+	size_t n = 0;
+};
+
+ComponentStats compute_stats( const std::vector< double >& samples )
+{
+	ComponentStats s;
+	s.n = samples.size();
+	if ( s.n > 0 )
+	{
+		s.median = xo::median( samples );
+		std::tie( s.mean, s.std ) = xo::mean_std( samples );
+	}
+	return s;
+}
+
+// Welch's t-statistic, positive when b is slower than a
+double welch_t( const ComponentStats& a, const ComponentStats& b )
+{
+	auto se = std::sqrt( a.std * a.std / std::max<size_t>( a.n, 1 ) + b.std * b.std / std::max<size_t>( b.n, 1 ) );
+	return se > 0 ? ( b.mean - a.mean ) / se : 0.0;
+}
+
+string json_string( const string& s )
+{
+	string r = "\"";
+	for ( char c : s )
+	{
+		if ( c == '"' || c == '\\' )
+			r += string( "\\" ) + c;
+		else if ( static_cast<unsigned char>( c ) < 0x20 )
+			r += xo::stringf( "\\u%04x", int( c ) );
+		else r += c;
+	}
+	return r + "\"";
+}
+
+// json has no representation for nan and inf, these are written as null
+string json_number( double v )
+{
+	if ( !std::isfinite( v ) )
+		return "null";
+	std::ostringstream str;
+	str << v;
+	return str.str();
+}
+
+// number written by json_number(), null is read as nan
+double json_number( const PropNode& pn, const string& key )
+{
+	return pn.get< string >( key ) == "null" ? std::numeric_limits< double >::quiet_NaN() : pn.get< double >( key );
+}
+
+// minimal json reader for benchmark result files; objects and arrays become children, other values are stored as strings
+PropNode parse_json( std::istream& str )
+{
+	auto skip_ws = [&]() { while ( std::isspace( str.peek() ) ) str.get(); };
+	auto read_string = [&]() {
+		string s;
+		str.get(); // opening quote
+		for ( int c = str.get(); c != '"' && str.good(); c = str.get() )
+		{
+			if ( c == '\\' )
+			{
+				c = str.get();
+				if ( c == 'n' ) c = '\n';
+				else if ( c == 't' ) c = '\t';
+				else if ( c == 'r' ) c = '\r';
+				else if ( c == 'u' ) {
+					char hex[ 5 ] = { 0 };
+					str.read( hex, 4 );
+					c = int( std::strtol( hex, nullptr, 16 ) );
+				}
+			}
+			s += char( c );
+		}
+		return s;
+	};
+
+	PropNode pn;
+	skip_ws();
+	if ( str.peek() == '{' || str.peek() == '[' )
+	{
+		char close = str.get() == '{' ? '}' : ']';
+		for ( skip_ws(); str.good() && str.peek() != close; skip_ws() )
+		{
+			string key;
+			if ( close == '}' )
+			{
+				key = read_string();
+				skip_ws();
+				SCONE_ERROR_IF( str.get() != ':', "Invalid json, expected ':' after " + key );
+			}
+			pn.add_child( key, parse_json( str ) );
+			skip_ws();
+			if ( str.peek() == ',' )
+				str.get();
+		}
+		SCONE_ERROR_IF( str.get() != close, "Invalid json, missing closing bracket" );
+	}
+	else if ( str.peek() == '"' )
+		pn.set_value( read_string() );
+	else
+	{
+		string value;
+		while ( str.good() && str.peek() != ',' && str.peek() != '}' && str.peek() != ']' && !std::isspace( str.peek() ) )
+			value += char( str.get() );
+		pn.set_value( value );
+	}
+	return pn;
+}
+
+// unique name of a benchmark configuration, consistent between runs
+string config_name( const string& scenario, int threads, double step_size )
+{
+	std::ostringstream str;
+	str << scenario << " T" << threads << " Z" << step_size;
+	return str.str();
+}
+
+// find the properties of the model inside a scenario
+PropNode* find_model_props( PropNode& pn )
+{
+	for ( auto& [key, child] : pn )
+	{
+		if ( xo::str_begins_with( key, "Model" ) && child.count_children() > 0 )
+			return &child;
+		if ( auto* model_pn = find_model_props( child ) )
+			return model_pn;
+	}
+	return nullptr;
+}
+
+std::vector< path > find_scenarios( const std::vector< string >& args )
+{
+	std::vector< path > scenarios;
+	for ( const auto& arg : args )
+	{
+		if ( fs::is_directory( arg ) )
+		{
+			std::vector< path > dir_scenarios;
+			for ( fs::directory_iterator fileit( arg ); fileit != fs::directory_iterator(); ++fileit )
+			{
+				auto scenario_file = xo::path( fileit->path().string() );
+				if ( scenario_file.extension_no_dot() == "scone" )
+					dir_scenarios.push_back( scenario_file );
+			}
+			std::sort( dir_scenarios.begin(), dir_scenarios.end(), [&]( auto&& a, auto&& b ) { return a.str() < b.str(); } );
+			scenarios.insert( scenarios.end(), dir_scenarios.begin(), dir_scenarios.end() );
+		}
+		else scenarios.push_back( path( arg ) );
+	}
+	return scenarios;
+}
+
+// main
+int main( int argc, char* argv[] )
+{
+	xo::log::console_sink console_sink( xo::log::level::info );
+	scone::Initialize();
+
+	try
+	{
+		TCLAP::CmdLine cmd( "SCONE Benchmark Suite", ' ', xo::to_str( scone::GetSconeVersion() ), true );
+		TCLAP::ValueArg< int > threadsArg( "t", "threads", "Benchmark using 1 up to this number of threads, doubling each run", false, 1, ">0", cmd );
+		TCLAP::MultiArg< double > stepArg( "z", "step_size", "Fixed control and integration step size to benchmark (multiple allowed); default uses the scenario settings", false, "step size", cmd );
+		TCLAP::ValueArg< int > evalsArg( "n", "evals", "Number of evaluations per thread", false, 4, ">0", cmd );
+		TCLAP::ValueArg< String > outArg( "o", "output", "Output file for benchmark results", false, "sconebench.json", "*.json", cmd );
+		TCLAP::ValueArg< String > baselineArg( "b", "baseline", "Baseline results to compare against", false, "", "*.json", cmd );
+		TCLAP::ValueArg< double > sigArg( "p", "significance", "Welch t-statistic above which a difference is significant", false, 3.0, ">0", cmd );
+		TCLAP::ValueArg< int > logArg( "l", "log", "Set the log level", false, 3, "1-7", cmd );
+		TCLAP::UnlabeledMultiArg< string > scenarioArg( "scenarios", "Scenario files or folders; default = scenarios/Tutorials and scenarios/UnitTests", false, "*.scone", cmd );
+		cmd.parse( argc, argv );
+
+		console_sink.set_log_level( xo::log::level( logArg.getValue() ) );
+
+		std::vector< string > scenario_args = scenarioArg.getValue();
+		if ( scenario_args.empty() )
+			for ( const auto& dir : { "scenarios/Tutorials", "scenarios/UnitTests" } )
+				scenario_args.push_back( ( GetFolder( SCONE_ROOT_FOLDER ) / dir ).str() );
+		auto scenarios = find_scenarios( scenario_args );
+
+		std::vector< double > step_sizes = stepArg.getValue();
+		if ( step_sizes.empty() )
+			step_sizes.push_back( 0.0 ); // use scenario settings
+
+		// read baseline, indexed by configuration and component name
+		std::map< string, ComponentStats > baseline;
+		std::map< string, double > baseline_rates;
+		if ( baselineArg.isSet() )
+		{
+			std::ifstream bstr( baselineArg.getValue() );
+			SCONE_ERROR_IF( !bstr.good(), "Could not open " + baselineArg.getValue() );
+			auto bpn = parse_json( bstr );
+			for ( const auto& [key, rpn] : bpn.get_child( "results" ) )
+			{
+				auto config = config_name( rpn.get< string >( "scenario" ), rpn.get< int >( "threads" ), rpn.get< double >( "step_size" ) );
+				baseline_rates[ config ] = json_number( rpn, "evaluations_per_second" );
+				for ( const auto& [name, cpn] : rpn.get_child( "components" ) )
+					baseline[ config + " " + name ] = ComponentStats{ json_number( cpn, "median" ), json_number( cpn, "mean" ), json_number( cpn, "std" ), cpn.get< size_t >( "n" ) };
+			}
+		}
+
+		// run all configurations
+		std::ostringstream results;
+		size_t regressions = 0;
+		for ( const auto& scenario_file : scenarios )
+		{
+			for ( auto step_size : step_sizes )
+			{
+				for ( int thread_count = 1; thread_count <= threadsArg.getValue(); thread_count *= 2 )
+				{
+					auto config = config_name( scenario_file.stem().str(), thread_count, step_size );
+					try
+					{
+						auto scenario_pn = xo::load_file_with_include( scenario_file, "INCLUDE" );
+						if ( step_size > 0 )
+						{
+							auto* model_pn = find_model_props( scenario_pn );
+							SCONE_ERROR_IF( !model_pn, "Could not find Model in " + scenario_file.str() );
+							model_pn->set( "max_step_size", step_size );
+							model_pn->set( "use_fixed_control_step_size", true );
+							model_pn->set( "fixed_control_step_size", step_size );
+						}
+
+						log::info( "Benchmarking ", config );
+						auto [samples, rate] = BenchmarkScenarioSamples( scenario_pn, scenario_file, thread_count, evalsArg.getValue() );
+
+						if ( results.tellp() > 0 )
+							results << ",\n";
+						results << "\t\t{\n\t\t\t\"scenario\": " << json_string( scenario_file.stem().str() )
+							<< ",\n\t\t\t\"threads\": " << thread_count
+							<< ",\n\t\t\t\"step_size\": " << json_number( step_size )
+							<< ",\n\t\t\t\"evaluations_per_second\": " << json_number( rate )
+							<< ",\n\t\t\t\"components\": {";
+
+						if ( auto it = baseline_rates.find( config ); it != baseline_rates.end() )
+							log::info( xo::stringf( "%-32s\t%10.2f evals/s\t%+6.2f%%", "Throughput", rate, 100.0 * ( rate / it->second - 1.0 ) ) );
+						else log::info( xo::stringf( "%-32s\t%10.2f evals/s", "Throughput", rate ) );
+
+						for ( index_t i = 0; i < samples.size(); ++i )
+						{
+							const auto& [name, values] = samples[ i ];
+							auto s = compute_stats( values );
+							results << ( i > 0 ? "," : "" ) << "\n\t\t\t\t" << json_string( name ) << ": { "
+								<< "\"median\": " << json_number( s.median ) << ", \"mean\": " << json_number( s.mean )
+								<< ", \"std\": " << json_number( s.std ) << ", \"n\": " << s.n << " }";
+
+							// compare to baseline
+							auto unit = name == "ModelCreate" || name == "Evaluation" ? "ms" : ( xo::str_ends_with( name, "Allocations" ) ? " allocs" : "ns" );
+							if ( auto it = baseline.find( config + " " + name ); it != baseline.end() )
+							{
+								auto t = welch_t( it->second, s );
+								bool significant = std::abs( t ) > sigArg.getValue();
+								regressions += significant && t > 0;
+								auto l = significant ? ( t > 0 ? log::level::error : log::level::warning ) : log::level::info;
+								log::message( l, xo::stringf( "%-32s\t%10.2f%s\t%+6.2f%%\tt=%+.2f%s", name.c_str(), s.median, unit,
+									100.0 * ( s.mean / it->second.mean - 1.0 ), t, significant ? ( t > 0 ? " REGRESSION" : " IMPROVEMENT" ) : "" ) );
+							}
+							else log::info( xo::stringf( "%-32s\t%10.2f%s\t(no baseline)", name.c_str(), s.median, unit ) );
+						}
+						results << "\n\t\t\t}\n\t\t}";
+					}
+					catch ( std::exception& e )
+					{
+						log::warning( "Skipping ", config, ": ", e.what() );
+					}
+				}
+			}
+		}
+
+		// write results
+		std::ofstream ostr( outArg.getValue() );
+		ostr << "{\n\t\"version\": " << json_string( xo::to_str( scone::GetSconeVersion() ) )
+			<< ",\n\t\"computer\": " << json_string( xo::get_computer_name() )
+			<< ",\n\t\"evals_per_thread\": " << evalsArg.getValue()
+			<< ",\n\t\"results\": [\n" << results.str() << "\n\t]\n}\n";
+		log::info( "Results written to ", outArg.getValue() );
+
+		if ( regressions > 0 )
+		{
+			log::error( regressions, " significant regressions compared to ", baselineArg.getValue() );
+			return 1;
+		}
+	}
+	catch ( std::exception& e )
+	{
+		log::critical( e.what() );
+		return -1;
+	}
+	catch ( TCLAP::ExitException& e )
+	{
+		return e.getExitStatus();
+	}
+
+	return 0;
+}
@@ -12,6 +12,8 @@
 #include "scone/core/Log.h"
 #include "scone/core/version.h"
 #include "scone/optimization/opt_tools.h"
+#include "scone/optimization/ProcessEvaluator.h"
+#include "scone/optimization/StatusChannel.h"
 #include "scone/sconelib_config.h"
 #include "spot/optimizer_pool.h"
 #include "xo/container/prop_node_tools.h"
@@ -24,10 +26,15 @@
 using namespace scone;
 
 // load scenario and handle custom arguments
-PropNode load_scenario( const path& scenario_file, const TCLAP::UnlabeledMultiArg< string >& propArg )
+// arguments without '=' are only allowed in batch evaluation, where they are files expanded from wildcards
+PropNode load_scenario( const path& scenario_file, const TCLAP::UnlabeledMultiArg< string >& propArg, bool skip_files = false )
 {
 	PropNode scenario_pn = xo::load_file_with_include( scenario_file, "INCLUDE" );
 	for ( auto kvstring : propArg ) {
+		if ( kvstring.find( '=' ) == string::npos ) {
+			SCONE_ERROR_IF( !skip_files, "Invalid property argument, expected <key>=<value>: " + kvstring );
+			continue;
+		}
 		auto kvp = xo::make_key_value_str( kvstring );
 		scenario_pn.set_query( kvp.first, kvp.second, '.' );
 	}
@@ -45,15 +52,20 @@ int main(int argc, char* argv[])
 		TCLAP::CmdLine cmd( "SCONE Command Line Utility", ' ', xo::to_str( scone::GetSconeVersion() ), true );
 		TCLAP::ValueArg< String > optArg( "o", "optimize", "Optimize a scenario file", true, "", "*.scone" );
 		TCLAP::ValueArg< String > parArg( "e", "evaluate", "Evaluate a result from an optimization", false, "", "*.par" );
+		TCLAP::MultiArg< String > batchArg( "E", "evaluate_batch", "Evaluate multiple results concurrently; accepts .par files, wildcards and folders (the most recent .par file of each folder and subfolder is used)", false, "*.par" );
+		TCLAP::ValueArg< int > jobsArg( "j", "jobs", "Number of threads used for batch evaluation; default = number of cores", false, 0, ">=0", cmd );
 		TCLAP::ValueArg< String > benchArg( "b", "benchmark", "Benchmark a scenario or parameter file", false, "", "*.scone" );
+		TCLAP::SwitchArg workerArg( "", "worker", "Run as evaluation worker process, receiving scenarios and parameters through stdin", false );
 		TCLAP::ValueArg< int > bxArg( "x", "benchmarkx", "Number of benchmarks to perform", false, 8, ">0", cmd );
+		TCLAP::ValueArg< int > btArg( "t", "benchmark_threads", "Benchmark scaling with 1 up to this number of threads; results are written to -r if set", false, 0, ">0", cmd );
 		TCLAP::ValueArg< String > outArg( "r", "result", "Output file for evaluation result", false, "", "Output file (*.sto)", cmd );
 		TCLAP::ValueArg< int > logArg( "l", "log", "Set the log level", false, 1, "1-7", cmd );
 		TCLAP::SwitchArg statusOutput( "s", "status", "Output full status updates", cmd, false );
 		TCLAP::SwitchArg quietOutput( "q", "quiet", "Do not output simulation progress", cmd, false );
+		TCLAP::ValueArg< String > statusFileArg( "", "status_file", "Write binary status updates of each generation to this file, instead of to the console", false, "", "file", cmd );
 		TCLAP::UnlabeledMultiArg< string > propArg( "property", "Override specific scenario property, using <key>=<value>", false, "<key>=<value>", cmd, true );
 
-		auto xor_args = std::vector<TCLAP::Arg*>{ &optArg, &parArg , &benchArg };
+		auto xor_args = std::vector<TCLAP::Arg*>{ &optArg, &parArg, &batchArg, &benchArg, &workerArg };
 		cmd.xorAdd( xor_args );
 		cmd.parse( argc, argv );
 
@@ -64,7 +76,14 @@ int main(int argc, char* argv[])
 				console_sink.set_log_level( xo::log::level( logArg.getValue() ) );
 
 			// do optimization or evaluation
-			if ( optArg.isSet() )
+			if ( workerArg.isSet() )
+			{
+				// only report warnings and errors from worker processes, unless requested otherwise
+				if ( !logArg.isSet() )
+					console_sink.set_log_level( xo::log::level::warning );
+				return ProcessEvaluator::RunWorker();
+			}
+			else if ( optArg.isSet() )
 			{
 				path scenario_file = FindScenario( optArg.getValue() );
 				auto scenario_pn = load_scenario( scenario_file, propArg );
@@ -72,6 +91,8 @@ int main(int argc, char* argv[])
 					scenario_pn.front().second.set( "output_root", outArg.getValue() );
 				OptimizerUP o = CreateOptimizer( scenario_pn, scenario_file.parent_path() );
 				LogUnusedProperties( scenario_pn );
+				if ( statusFileArg.isSet() )
+					o->SetStatusChannel( std::make_shared< StatusChannel >( path( statusFileArg.getValue() ), StatusChannel::WriteMode ) );
 				if ( statusOutput.getValue() )
 					o->SetOutputMode( Optimizer::status_console_output );
 				else o->SetOutputMode( quietOutput.getValue() ? Optimizer::no_output : Optimizer::console_output );
@@ -90,12 +111,32 @@ int main(int argc, char* argv[])
 				if ( propArg.isSet() && outArg.isSet() )
 					save_file( scenario_pn, out_path.replace_extension( "scone" ) );
 			}
+			else if ( batchArg.isSet() )
+			{
+				// shell wildcards expand to multiple arguments, which end up as unlabeled arguments
+				auto batch_args = batchArg.getValue();
+				for ( const auto& arg : propArg )
+					if ( arg.find( '=' ) == string::npos )
+						batch_args.push_back( arg );
+				auto par_files = FindParFiles( batch_args );
+				SCONE_ERROR_IF( par_files.empty(), "Could not find any .par files" );
+				log::info( "Evaluating ", par_files.size(), " files" );
+				auto summary = EvaluateScenarioBatch( par_files, jobsArg.getValue(),
+					[&]( const path& scenario_file ) { return load_scenario( scenario_file, propArg, true ); } );
+				log::info( summary );
+			}
 			else if ( benchArg.isSet() )
 			{
 				path scenario_file = FindScenario( benchArg.getValue() );
 				auto scenario_pn = load_scenario( scenario_file, propArg );
 				log::info( "Benchmarking ", benchArg.getValue() );
-				BenchmarkScenario( scenario_pn, path( benchArg.getValue() ), bxArg.getValue() );
+				if ( btArg.isSet() )
+				{
+					auto results = BenchmarkScenarioScaling( scenario_pn, path( benchArg.getValue() ), btArg.getValue(), bxArg.getValue() );
+					if ( outArg.isSet() )
+						save_file( results, path( outArg.getValue() ) );
+				}
+				else BenchmarkScenario( scenario_pn, path( benchArg.getValue() ), bxArg.getValue() );
 			}
 		}
 		catch ( std::exception& e )
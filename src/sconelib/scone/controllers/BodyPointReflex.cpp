@@ -37,6 +37,10 @@ namespace scone
 		INIT_PAR_NAMED( props, par, KA, "KA", 0.0 );
 
 		INIT_PAR_NAMED( props, par, C0, "C0", 0.0 );
+
+		m_DelayedPos.ReserveDelay( delay );
+		m_DelayedVel.ReserveDelay( delay );
+		m_DelayedAcc.ReserveDelay( delay );
 	}
 
 	void BodyPointReflex::ComputeControls( double timestamp )
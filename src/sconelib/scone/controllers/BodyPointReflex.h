@@ -54,6 +54,7 @@ namespace scone
 		Real C0;
 
 		virtual void StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_NO_INTERNAL_STATE
 
 	private:
 		Real u_p;
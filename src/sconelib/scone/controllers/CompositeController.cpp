@@ -71,6 +71,22 @@ namespace scone
 		return files;
 	}
 
+	std::any CompositeController::GetInternalState() const
+	{
+		std::vector< ControllerCheckpoint > states;
+		for ( auto& c : controllers_ )
+			states.push_back( c->GetCheckpoint() );
+		return states;
+	}
+
+	void CompositeController::SetInternalState( const std::any& state )
+	{
+		auto& states = std::any_cast< const std::vector< ControllerCheckpoint >& >( state );
+		SCONE_ERROR_IF( states.size() != controllers_.size(), "Checkpoint does not match the number of child controllers of " + GetName() );
+		for ( index_t i = 0; i < controllers_.size(); ++i )
+			controllers_[ i ]->RestoreCheckpoint( states[ i ] );
+	}
+
 	String CompositeController::GetClassSignature() const
 	{
 		std::vector< String > strset;
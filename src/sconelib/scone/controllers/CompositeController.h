@@ -28,6 +28,8 @@ namespace scone
 
 	protected:
 		virtual bool ComputeControls( Model& model, double timestamp ) override;
+		virtual std::any GetInternalState() const override;
+		virtual void SetInternalState( const std::any& state ) override;
 
 		virtual String GetClassSignature() const override;
 		std::vector< ControllerUP > controllers_;
@@ -23,6 +23,8 @@ namespace scone
 	{
 		m_pConditionalDofPos = &model.AcquireDelayedSensor< DofPositionSensor >( dof );
 		m_pConditionalDofVel = &model.AcquireDelayedSensor< DofVelocitySensor >( dof );
+		m_pConditionalDofPos->ReserveDelay( delay );
+		m_pConditionalDofVel->ReserveDelay( delay );
 
 		ScopedParamSetPrefixer prefixer( par, GetParName( props, loc ) + "-" + props.get< String >( "dof" ) + "." );
 		INIT_PAR( props, par, pos_max, 1e12 );
@@ -44,4 +44,27 @@ namespace scone
 			return PerformAnalysis( model, timestamp );
 		else return false;
 	}
+
+	std::any Controller::GetInternalState() const
+	{
+		SCONE_THROW( "Controller " + GetName() + " does not support checkpoints" );
+	}
+
+	void Controller::SetInternalState( const std::any& state )
+	{
+		SCONE_THROW( "Controller " + GetName() + " does not support checkpoints" );
+	}
+
+	void Controller::RestoreCheckpoint( const ControllerCheckpoint& cp )
+	{
+		try
+		{
+			disabled_ = cp.disabled;
+			SetInternalState( cp.state );
+		}
+		catch ( const std::bad_any_cast& )
+		{
+			SCONE_THROW( "Checkpoint does not match the structure of controller " + GetName() );
+		}
+	}
 }
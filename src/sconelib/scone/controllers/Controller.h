@@ -16,8 +16,18 @@
 #include "xo/filesystem/path.h"
 #include "scone/core/HasName.h"
 
+#include <any>
+#include <tuple>
+
 namespace scone
 {
+	/// Internal state of a Controller during simulation, used in a ModelCheckpoint.
+	struct ControllerCheckpoint
+	{
+		bool disabled;
+		std::any state;
+	};
+
 	/// Base class for SCONE Controllers. See derived classes for specific functionality.
 	class SCONE_API Controller : public HasSignature, public HasData, public HasName
 	{
@@ -51,10 +61,30 @@ namespace scone
 
 		virtual const String& GetName() const override { return name; }
 
+		// Get or restore the internal state of the controller, used for model checkpoints
+		ControllerCheckpoint GetCheckpoint() const { return { disabled_, GetInternalState() }; }
+		void RestoreCheckpoint( const ControllerCheckpoint& cp );
+
 	protected:
 		virtual bool ComputeControls( Model& model, double timestamp ) { return false; }
 		virtual bool PerformAnalysis( const Model& model, double timestamp ) { return false; }
 
+		// Internal state that changes during simulation, throws by default so that checkpoints never silently miss state.
+		// Use SCONE_INTERNAL_STATE or SCONE_NO_INTERNAL_STATE to opt in.
+		virtual std::any GetInternalState() const;
+		virtual void SetInternalState( const std::any& state );
+
 		bool disabled_;
 	};
 }
+
+/// Implement GetInternalState() and SetInternalState() for a list of copyable member variables.
+#define SCONE_INTERNAL_STATE( ... ) \
+	virtual std::any GetInternalState() const override { return std::make_tuple( __VA_ARGS__ ); } \
+	virtual void SetInternalState( const std::any& state ) override { \
+		std::tie( __VA_ARGS__ ) = std::any_cast< const decltype( std::make_tuple( __VA_ARGS__ ) )& >( state ); }
+
+/// Implement GetInternalState() and SetInternalState() for classes whose output only depends on the model and parameters.
+#define SCONE_NO_INTERNAL_STATE \
+	virtual std::any GetInternalState() const override { return {}; } \
+	virtual void SetInternalState( const std::any& state ) override {}
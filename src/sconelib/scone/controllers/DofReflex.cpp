@@ -45,6 +45,11 @@ namespace scone
 
 		if ( auto p0pn = props.try_get< String >( "P0_source" ) )
 			m_pTargetPosSource = &model.AcquireDelayedSensor< DofPositionSensor >( *FindByNameTrySided( model.GetDofs(), *p0pn, loc.side_ ) );
+
+		m_DelayedPos.ReserveDelay( delay );
+		m_DelayedVel.ReserveDelay( delay );
+		if ( m_pTargetPosSource )
+			m_pTargetPosSource->ReserveDelay( delay );
 	}
 
 	DofReflex::~DofReflex()
@@ -52,6 +52,9 @@ namespace scone
 
 		virtual void StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const override;
 
+		// the filter includes its coefficients, so filter_cutoff_frequency must match the checkpoint
+		SCONE_INTERNAL_STATE( m_Filter )
+
 	private:
 		Real u_p;
 		Real u_v;
@@ -21,7 +21,8 @@ namespace scone
 		Controller( props, par, model, target_area ),
 		INIT_MEMBER( props, symmetric, target_area.symmetric_ ),
 		INIT_MEMBER( props, include, "*" ),
-		INIT_MEMBER( props, exclude, "" )
+		INIT_MEMBER( props, exclude, "" ),
+		m_FunctionValues( &model.GetArena() )
 	{
 		INIT_PROP( props, symmetric, target_area.symmetric_ );
 
@@ -67,6 +68,7 @@ namespace scone
 			m_Functions.push_back( CreateFunction( fp, par ) );
 			ai.function_idx = m_Functions.size() - 1;
 		}
+		m_FunctionValues.resize( m_Functions.size() );
 	}
 
 	bool FeedForwardController::ComputeControls( Model& model, double time )
@@ -74,16 +76,15 @@ namespace scone
 		SCONE_PROFILE_FUNCTION( model.GetProfiler() );
 
 		// evaluate functions
-		std::vector< double > funcresults( m_Functions.size() );
 		for ( size_t idx = 0; idx < m_Functions.size(); ++idx )
-			funcresults[ idx ] = m_Functions[ idx ]->GetValue( time );
+			m_FunctionValues[ idx ] = m_Functions[ idx ]->GetValue( time );
 
 		// apply results to all actuators
 		auto& actuators = model.GetActuators();
 		for ( ActInfo& ai : m_ActInfos )
 		{
 			// apply results directly to control value
-			actuators[ ai.actuator_idx ]->AddInput( funcresults[ ai.function_idx ] );
+			actuators[ ai.actuator_idx ]->AddInput( m_FunctionValues[ ai.function_idx ] );
 		}
 
 		return false;
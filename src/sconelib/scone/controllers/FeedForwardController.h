@@ -15,6 +15,8 @@
 #include "scone/core/Function.h"
 #include "scone/model/Leg.h"
 
+#include <memory_resource>
+
 namespace OpenSim
 {
 	class PiecewiseLinearFunction;
@@ -40,6 +42,7 @@ namespace scone
 
 		virtual bool ComputeControls( Model& model, double timestamp ) override;
 		virtual String GetClassSignature() const override;
+		SCONE_NO_INTERNAL_STATE
 
 	private:
 		// actuator info
@@ -55,6 +58,7 @@ namespace scone
 		};
 
 		std::vector< FunctionUP > m_Functions;
+		std::pmr::vector< double > m_FunctionValues; // allocated from the model arena
 		std::vector< ActInfo > m_ActInfos;
 	};
 }
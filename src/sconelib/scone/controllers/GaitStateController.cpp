@@ -29,6 +29,17 @@ namespace scone
 		GaitStateController::LandingState, "Landing"
 		);
 
+	namespace
+	{
+		// leg states and conditional controller states, used for model checkpoints
+		struct GaitStateCheckpoint
+		{
+			using LegStatus = std::tuple< TimedValue< GaitStateController::GaitState >, Real, Real, Real, bool, bool, bool, bool, bool >;
+			std::vector< LegStatus > legs;
+			std::vector< std::tuple< bool, double, ControllerCheckpoint > > controllers;
+		};
+	}
+
 	GaitStateController::LegState::LegState( Model& m, Leg& l, const PropNode& props, Params& par ) :
 		leg( l ),
 		load_sensor( m.AcquireDelayedSensor< LegLoadSensor >( l ) ),
@@ -76,6 +87,7 @@ namespace scone
 		{
 			ScopedParamSetPrefixer prefixer( par, symmetric ? "" : leg->GetName() + '.' );
 			m_LegStates.push_back( LegStateUP( new LegState( model, *leg, props, par ) ) );
+			m_LegStates.back()->load_sensor.ReserveDelay( leg_load_sensor_delay );
 			//log::TraceF( "leg %d leg_length=%.5f", m_LegStates.back()->leg.GetIndex(), m_LegStates.back()->leg_length );
 		}
 
@@ -295,6 +307,37 @@ namespace scone
 		}
 	}
 
+	std::any GaitStateController::GetInternalState() const
+	{
+		GaitStateCheckpoint cp;
+		for ( auto& ls : m_LegStates )
+			cp.legs.emplace_back( ls->state, ls->leg_load, ls->sagittal_pos, ls->coronal_pos, ls->allow_stance_transition, ls->allow_swing_transition,
+				ls->allow_late_stance_transition, ls->allow_liftoff_transition, ls->allow_landing_transition );
+		for ( auto& cc : m_ConditionalControllers )
+			cp.controllers.emplace_back( cc->active, cc->active_since, cc->controller->GetCheckpoint() );
+		return cp;
+	}
+
+	void GaitStateController::SetInternalState( const std::any& state )
+	{
+		auto& cp = std::any_cast< const GaitStateCheckpoint& >( state );
+		SCONE_ERROR_IF( cp.legs.size() != m_LegStates.size() || cp.controllers.size() != m_ConditionalControllers.size(),
+			"Checkpoint does not match the legs and controllers of " + GetName() );
+		for ( index_t i = 0; i < m_LegStates.size(); ++i )
+		{
+			auto& ls = *m_LegStates[ i ];
+			std::tie( ls.state, ls.leg_load, ls.sagittal_pos, ls.coronal_pos, ls.allow_stance_transition, ls.allow_swing_transition,
+				ls.allow_late_stance_transition, ls.allow_liftoff_transition, ls.allow_landing_transition ) = cp.legs[ i ];
+		}
+		for ( index_t i = 0; i < m_ConditionalControllers.size(); ++i )
+		{
+			auto& cc = *m_ConditionalControllers[ i ];
+			cc.active = std::get< 0 >( cp.controllers[ i ] );
+			cc.active_since = std::get< 1 >( cp.controllers[ i ] );
+			cc.controller->RestoreCheckpoint( std::get< 2 >( cp.controllers[ i ] ) );
+		}
+	}
+
 	String GaitStateController::GetConditionName( const ConditionalController& cc ) const
 	{
 		String s = m_LegStates[ cc.leg_index ]->leg.GetName();
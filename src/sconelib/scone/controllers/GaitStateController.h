@@ -105,6 +105,8 @@ namespace scone
 
 		virtual void UpdateLegStates( Model& model, double timestamp );
 		void UpdateControllerStates( Model& model, double timestamp );
+		virtual std::any GetInternalState() const override;
+		virtual void SetInternalState( const std::any& state ) override;
 
 		static StringMap< GaitState > m_StateNames;
 
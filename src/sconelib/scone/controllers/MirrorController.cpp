@@ -43,5 +43,17 @@ namespace scone
 		return c0->GetSignature();
 	}
 
+	std::any MirrorController::GetInternalState() const
+	{
+		return std::make_pair( c0->GetCheckpoint(), c1->GetCheckpoint() );
+	}
+
+	void MirrorController::SetInternalState( const std::any& state )
+	{
+		auto& states = std::any_cast< const std::pair< ControllerCheckpoint, ControllerCheckpoint >& >( state );
+		c0->RestoreCheckpoint( states.first );
+		c1->RestoreCheckpoint( states.second );
+	}
+
 }
 
@@ -26,6 +26,8 @@ namespace scone
 
 	protected:
 		virtual String GetClassSignature() const override;
+		virtual std::any GetInternalState() const override;
+		virtual void SetInternalState( const std::any& state ) override;
 
 	private:
 		ControllerUP c0, c1;
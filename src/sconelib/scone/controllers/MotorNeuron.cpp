@@ -27,7 +27,6 @@ namespace scone
 
 	void MotorNeuron::UpdateActuator()
 	{
-		auto v = GetOutput();
-		muscle_->AddInput( v );
+		muscle_->AddInput( output_ );
 	}
 }
@@ -22,7 +22,13 @@ namespace scone
 	m_pLengthSensor( nullptr ),
 	m_pVelocitySensor( nullptr ),
 	m_pSpindleSensor( nullptr ),
-	m_pActivationSensor( nullptr )
+	m_pActivationSensor( nullptr ),
+	m_Model( model ),
+	m_ForceInput( no_index ),
+	m_LengthInput( no_index ),
+	m_VelocityInput( no_index ),
+	m_SpindleInput( no_index ),
+	m_ActivationInput( no_index )
 	{
 		// init names
 		String par_name = GetParName( props, loc );
@@ -66,6 +72,14 @@ namespace scone
 		if ( KA != 0.0 )
 			m_pActivationSensor = &model.AcquireDelayedSensor< MuscleActivationSensor >( source );
 
+		// sensor values are read every control step from the delayed sensor inputs of the model
+		auto add_input = [&]( SensorDelayAdapter* s ) { return s ? model.AddDelayedSensorInput( *s, delay ) : no_index; };
+		m_ForceInput = add_input( m_pForceSensor );
+		m_LengthInput = add_input( m_pLengthSensor );
+		m_VelocityInput = add_input( m_pVelocitySensor );
+		m_SpindleInput = add_input( m_pSpindleSensor );
+		m_ActivationInput = add_input( m_pActivationSensor );
+
 		//log::TraceF( "MuscleReflex SRC=%s TRG=%s KL=%.2f KF=%.2f C0=%.2f", source.GetName().c_str(), m_Target.GetName().c_str(), length_gain, force_gain, u_constant );
 	}
 
@@ -76,39 +90,47 @@ namespace scone
 	void MuscleReflex::ComputeControls( double timestamp )
 	{
 		// add stretch reflex
-		u_l = GetValue( m_pLengthSensor, KL, L0, allow_neg_L );
+		u_l = GetValue( m_LengthInput, KL, L0, allow_neg_L );
 
 		// add velocity reflex
-		u_v = GetValue( m_pVelocitySensor, KV, V0, allow_neg_V );
+		u_v = GetValue( m_VelocityInput, KV, V0, allow_neg_V );
 
 		// add force reflex
-		u_f = GetValue( m_pForceSensor, KF, F0, allow_neg_F );
+		u_f = GetValue( m_ForceInput, KF, F0, allow_neg_F );
 
 		// add spindle reflex
-		u_s = GetValue( m_pSpindleSensor, KS, S0, allow_neg_S );
+		u_s = GetValue( m_SpindleInput, KS, S0, allow_neg_S );
 
 		// add spindle reflex
-		u_a = GetValue( m_pActivationSensor, KA, A0, allow_neg_A );
+		u_a = GetValue( m_ActivationInput, KA, A0, allow_neg_A );
 
 		// sum it up
 		u_total = u_l + u_v + u_f + u_s + u_a + C0;
 		AddTargetControlValue( u_total );
 	}
 
+	Real MuscleReflex::GetValue( index_t input, Real gain, Real ofs, bool allow_neg ) const
+	{
+		if ( input != no_index ) {
+			Real sensoryFeedback = ( m_Model.GetDelayedSensorInput( input ) - ofs );
+			sensoryFeedback = ( !allow_neg && sensoryFeedback < 0.0 ) ? 0.0 : sensoryFeedback;
+			return gain * sensoryFeedback;
+		}
+		else return 0.0;
+	}
+
 	void MuscleReflex::StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const
 	{
-		auto name = GetReflexName( actuator_.GetName(), source.GetName() );
-
-		if ( m_pLengthSensor )
-			frame[ name + ".RL" ] = u_l;
-		if ( m_pVelocitySensor )
-			frame[ name + ".RV" ] = u_v;
-		if ( m_pForceSensor )
-			frame[ name + ".RF" ] = u_f;
-		if ( m_pSpindleSensor )
-			frame[ name + ".RS" ] = u_s;
-		if ( m_pActivationSensor )
-			frame[ name + ".RA" ] = u_a;
+		const SensorDelayAdapter* sensors[] = { m_pLengthSensor, m_pVelocitySensor, m_pForceSensor, m_pSpindleSensor, m_pActivationSensor };
+		const char* postfixes[] = { ".RL", ".RV", ".RF", ".RS", ".RA" };
+		const Real values[] = { u_l, u_v, u_f, u_s, u_a };
+
+		// only register channels for sensors that are used
+		auto& ch = m_StoreDataChannels.Get( frame, 5, [&]( index_t i ) {
+			return sensors[ i ] ? GetReflexName( actuator_.GetName(), source.GetName() ) + postfixes[ i ] : String(); } );
+		for ( index_t i = 0; i < 5; ++i )
+			if ( sensors[ i ] )
+				frame[ ch[ i ] ] = values[ i ];
 		//frame[ name + ".R" ] = u_total;
 	}
 }
@@ -69,6 +69,7 @@ namespace scone
 		bool allow_neg_S;
 
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_NO_INTERNAL_STATE
 
 	protected:
 
@@ -80,19 +81,15 @@ namespace scone
 		Real u_total = 0;
 
 	private:
-		Real GetValue( SensorDelayAdapter* s, Real gain, Real ofs, bool allow_neg ) {
-			if ( s ) {
-				Real sensoryFeedback = ( s->GetValue( delay ) - ofs );
-				sensoryFeedback = ( !allow_neg && sensoryFeedback < 0.0 ) ? 0.0 : sensoryFeedback;
-				return gain * sensoryFeedback;
-			}
-			else return 0.0;
-		}
+		Real GetValue( index_t input, Real gain, Real ofs, bool allow_neg ) const;
 
 		SensorDelayAdapter* m_pForceSensor;
 		SensorDelayAdapter* m_pLengthSensor;
 		SensorDelayAdapter* m_pVelocitySensor;
 		SensorDelayAdapter* m_pSpindleSensor;
 		SensorDelayAdapter* m_pActivationSensor;
+		const Model& m_Model;
+		index_t m_ForceInput, m_LengthInput, m_VelocityInput, m_SpindleInput, m_ActivationInput; // see Model::AddDelayedSensorInput()
+		mutable StoreDataChannels m_StoreDataChannels;
 	};
 }
@@ -11,6 +11,8 @@
 #include <algorithm>
 #include <numeric>
 #include <fstream>
+#include <functional>
+#include <unordered_map>
 
 #include "xo/container/container_tools.h"
 #include "xo/container/table.h"
@@ -19,6 +21,7 @@
 #include "xo/string/string_cast.h"
 #include "xo/string/string_tools.h"
 #include "xo/utility/hash.h"
+#include "xo/numerical/math.h"
 
 #include "scone/core/HasName.h"
 #include "scone/core/profiler_config.h"
@@ -95,6 +98,8 @@ namespace scone
 
 			// restore original state
 			model.SetState( org_state, 0.0 );
+
+			CompileNetwork();
 		}
 		catch ( std::exception& e )
 		{
@@ -249,10 +254,107 @@ namespace scone
 		return result;
 	}
 
+	void NeuralController::CompileNetwork()
+	{
+		// add neurons depth-first, so that each neuron comes after its inputs
+		std::unordered_map< const Neuron*, index_t > node_indices;
+		std::function< index_t( const Neuron* ) > add_node = [&]( const Neuron* neuron ) {
+			if ( auto it = node_indices.find( neuron ); it != node_indices.end() )
+				return it->second;
+			for ( auto& i : neuron->inputs_ )
+				add_node( i.neuron );
+
+			NetworkNode node{ neuron, sum_node, m_NodeInputs.size(), m_NodeInputs.size() + neuron->inputs_.size() };
+			if ( dynamic_cast< const SensorNeuron* >( neuron ) )
+				node.type = sensor_node;
+			else if ( dynamic_cast< const PatternNeuron* >( neuron ) )
+				node.type = pattern_node;
+			else if ( auto* in = dynamic_cast< const InterNeuron* >( neuron ); in && in->use_distance_ )
+				node.type = distance_node;
+
+			for ( auto& i : neuron->inputs_ )
+			{
+				auto source = node_indices.at( i.neuron );
+				SCONE_THROW_IF( i.offset != 0.0 && m_Nodes[ source ].type == distance_node, "Input offsets are not supported for gaussian neuron " + i.neuron->GetName() );
+				m_NodeInputs.push_back( NetworkInput{ source, i.gain, i.offset, &i } );
+			}
+
+			m_Nodes.push_back( node );
+			return node_indices[ neuron ] = m_Nodes.size() - 1;
+		};
+
+		for ( auto& n : m_MotorNeurons )
+			add_node( n.get() );
+
+		m_NodeValues.resize( m_Nodes.size() );
+		m_NodeOutputs.resize( m_Nodes.size() );
+	}
+
+	double NeuralController::GetInputOutput( const NetworkInput& input ) const
+	{
+		if ( input.offset == 0.0 )
+			return m_NodeOutputs[ input.source ];
+
+		// input offsets are applied inside the source neuron
+		auto& src = m_Nodes[ input.source ];
+		switch ( src.type )
+		{
+		case sensor_node: return src.neuron->activation_function( m_NodeValues[ input.source ] - static_cast< const SensorNeuron* >( src.neuron )->sensor_gain_ * input.offset );
+		case sum_node: return src.neuron->activation_function( m_NodeValues[ input.source ] + input.offset );
+		default: return m_NodeOutputs[ input.source ];
+		}
+	}
+
+	void NeuralController::UpdateNetwork( bool track_contributions )
+	{
+		for ( index_t idx = 0; idx < m_Nodes.size(); ++idx )
+		{
+			auto& node = m_Nodes[ idx ];
+			double value = node.neuron->offset_;
+			double output = 0.0;
+			switch ( node.type )
+			{
+			case sensor_node:
+			{
+				auto* sn = static_cast< const SensorNeuron* >( node.neuron );
+				value = sn->sensor_gain_ * ( sn->GetSensorValue() - sn->offset_ );
+				output = sn->activation_function( value );
+				break;
+			}
+			case pattern_node:
+				value = output = node.neuron->GetOutput();
+				break;
+			case distance_node:
+			{
+				double dist = 0.0;
+				for ( auto i = node.input_begin; i != node.input_end; ++i )
+					dist += xo::squared( GetInputOutput( m_NodeInputs[ i ] ) - m_NodeInputs[ i ].offset );
+				output = node.neuron->offset_ + gaussian_width( sqrt( dist ), static_cast< const InterNeuron* >( node.neuron )->width_ );
+				break;
+			}
+			case sum_node:
+				for ( auto i = node.input_begin; i != node.input_end; ++i )
+				{
+					auto& ni = m_NodeInputs[ i ];
+					auto input = ni.gain * GetInputOutput( ni );
+					if ( track_contributions )
+						ni.input->contribution += abs( input );
+					value += input;
+				}
+				output = node.neuron->activation_function( value );
+				break;
+			}
+			m_NodeValues[ idx ] = node.neuron->input_ = value;
+			m_NodeOutputs[ idx ] = node.neuron->output_ = output;
+		}
+	}
+
 	bool NeuralController::ComputeControls( Model& model, double timestamp )
 	{
 		SCONE_PROFILE_FUNCTION( model.GetProfiler() );
 
+		// contributions are only used in WriteResults()
+		UpdateNetwork( model.GetStoreData() );
 		for ( auto& n : m_MotorNeurons )
 			n->UpdateActuator();
 
@@ -273,7 +375,7 @@ namespace scone
 			auto prefix = "MN." + neuron->GetName( false ) + '.';
 			frame[ prefix + "input" ] = neuron->input_;
 			for ( auto& i : neuron->inputs_ )
-				frame[ prefix + i.neuron->GetName( false ) ] = i.gain * i.neuron->GetOutput();
+				frame[ prefix + i.neuron->GetName( false ) ] = i.gain * i.neuron->output_;
 		}
 	}
 
@@ -92,6 +92,29 @@ namespace scone
 		void AddInterNeuronLayer( const PropNode& pn, Params& par );
 		void AddMotorNeuronLayer( const PropNode& pn, Params& par );
 
+		// flattened neuron graph, evaluated once per control step in topological order
+		enum node_t { sensor_node, pattern_node, sum_node, distance_node };
+		struct NetworkNode {
+			const Neuron* neuron;
+			node_t type;
+			index_t input_begin;
+			index_t input_end;
+		};
+		struct NetworkInput {
+			index_t source;
+			double gain;
+			double offset;
+			const Neuron::Input* input; // used for contribution tracking
+		};
+		void CompileNetwork();
+		void UpdateNetwork( bool track_contributions );
+		double GetInputOutput( const NetworkInput& input ) const;
+
+		std::vector< NetworkNode > m_Nodes;
+		std::vector< NetworkInput > m_NodeInputs;
+		std::vector< double > m_NodeValues; // input before activation
+		std::vector< double > m_NodeOutputs;
+
 		std::vector< PatternNeuronUP > m_PatternNeurons;
 		std::vector< SensorNeuronUP > m_SensorNeurons;
 		xo::flat_map< string, std::vector< InterNeuronUP > > m_InterNeurons;
@@ -109,7 +109,10 @@ namespace scone::NN
 		snl.muscle_ = ms ? &ms->muscle_ : nullptr;
 		if ( accurate_neural_delays_ )
 			snl.buffer_channel_ = make_delay_buffer_channel( sensor_buffers_, delay, model.fixed_control_step_size );
-		else snl.delayed_sensor_ = &model.AcquireSensorDelayAdapter( sensor );
+		else {
+			snl.delayed_sensor_ = &model.AcquireSensorDelayAdapter( sensor );
+			snl.input_ = model.AddDelayedSensorInput( *snl.delayed_sensor_, delay );
+		}
 
 		return neuron;
 	}
@@ -166,7 +169,7 @@ namespace scone::NN
 		else
 		{
 			for ( const auto& sl : sensor_links_ )
-				sensor_neurons[ sl.neuron_idx_ ].output_ = sl.delayed_sensor_->GetValue( sl.delay_ ) + sensor_neurons[ sl.neuron_idx_ ].offset_;
+				sensor_neurons[ sl.neuron_idx_ ].output_ = model.GetDelayedSensorInput( sl.input_ ) + sensor_neurons[ sl.neuron_idx_ ].offset_;
 		}
 
 		// update links and inter neurons
@@ -252,6 +255,53 @@ namespace scone::NN
 		return xo::stringf( "NN%d", links );
 	}
 
+	namespace
+	{
+		// neuron sums and outputs and delay buffers, used for model checkpoints
+		struct NeuralNetworkCheckpoint
+		{
+			std::vector< std::vector< std::pair< double, double > > > neurons;
+			DelayBufferMap sensor_buffers, actuator_buffers;
+		};
+
+		// buffers are assigned in-place, because links refer to the existing map entries
+		void AssignDelayBuffers( DelayBufferMap& buffers, const DelayBufferMap& values )
+		{
+			SCONE_ERROR_IF( buffers.size() != values.size(), "Checkpoint does not match neural delay buffers" );
+			for ( auto& [delay, buf] : values )
+				buffers.at( delay ) = buf;
+		}
+	}
+
+	std::any NeuralNetworkController::GetInternalState() const
+	{
+		NeuralNetworkCheckpoint cp;
+		for ( const auto& layer : layers_ )
+		{
+			auto& states = cp.neurons.emplace_back();
+			for ( const auto& n : layer.neurons_ )
+				states.emplace_back( n.sum_, n.output_ );
+		}
+		cp.sensor_buffers = sensor_buffers_;
+		cp.actuator_buffers = actuator_buffers_;
+		return cp;
+	}
+
+	void NeuralNetworkController::SetInternalState( const std::any& state )
+	{
+		auto& cp = std::any_cast< const NeuralNetworkCheckpoint& >( state );
+		SCONE_ERROR_IF( cp.neurons.size() != layers_.size(), "Checkpoint does not match the neuron layers of " + GetName() );
+		for ( index_t layer_idx = 0; layer_idx < layers_.size(); ++layer_idx )
+		{
+			auto& neurons = layers_[ layer_idx ].neurons_;
+			SCONE_ERROR_IF( cp.neurons[ layer_idx ].size() != neurons.size(), "Checkpoint does not match the neuron layers of " + GetName() );
+			for ( index_t i = 0; i < neurons.size(); ++i )
+				std::tie( neurons[ i ].sum_, neurons[ i ].output_ ) = cp.neurons[ layer_idx ][ i ];
+		}
+		AssignDelayBuffers( sensor_buffers_, cp.sensor_buffers );
+		AssignDelayBuffers( actuator_buffers_, cp.actuator_buffers );
+	}
+
 	const String& NeuralNetworkController::GetParAlias( const String& name )
 	{
 		auto it = xo::find_if( parameter_aliases_, [&]( const auto& e ) { return xo::str_begins_with( name, e.first ); } );
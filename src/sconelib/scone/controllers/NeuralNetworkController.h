@@ -88,6 +88,7 @@ namespace scone
 			SensorDelayAdapter* delayed_sensor_;
 			Sensor* sensor_;
 			TimeInSeconds delay_;
+			index_t input_; // see Model::AddDelayedSensorInput()
 			index_t neuron_idx_;
 			const Muscle* muscle_;
 			DelayBufferChannel buffer_channel_;
@@ -117,6 +118,8 @@ namespace scone
 		protected:
 			bool ComputeControls( Model& model, double timestamp ) override;
 			String GetClassSignature() const override;
+			std::any GetInternalState() const override;
+			void SetInternalState( const std::any& state ) override;
 
 		private:
 			NeuronLayer& AddNeuronLayer( const PropNode& pn, const String& default_activation );
@@ -16,7 +16,7 @@ namespace scone
 	NoiseController::NoiseController( const PropNode& props, Params& par, Model& model, const Location& loc ) :
 	Controller( props, par, model, loc ),
 	random_seed( props.get< unsigned int >( "random_seed", 123 ) ),
-	rng_( random_seed )
+	rng_( random_seed + model.random_seed_offset )
 	{
 		INIT_PROP( props, base_noise, 0 );
 		INIT_PROP( props, proportional_noise, 0 );
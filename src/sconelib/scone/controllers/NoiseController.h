@@ -27,12 +27,13 @@ namespace scone
 		/// Proportional standard deviation of the normal distribution; default = 0.
 		double proportional_noise;
 
-		/// Random seed for noise sampling; default = 123.
+		/// Random seed for noise sampling, to which the ''random_seed_offset'' of the model is added; default = 123.
 		unsigned int random_seed;
 
 	protected:
 		virtual bool ComputeControls( Model& model, double timestamp ) override;
 		virtual String GetClassSignature() const override;
+		SCONE_INTERNAL_STATE( rng_ )
 
 		xo::random_number_generator rng_;
 	};
@@ -18,7 +18,7 @@ namespace scone
 		Controller( props, par, model, target_area ),
 		body( *FindByName( model.GetBodies(), props.get< String >( "body" ) ) ),
 		random_seed( props.get( "random_seed", 5489 ) ),
-		rng_( random_seed ),
+		rng_( random_seed + model.random_seed_offset ),
 		active_( false ),
 		current_force(),
 		current_moment()
@@ -38,7 +38,7 @@ namespace scone
 		/// Perturbation moment to apply; default = [ 0 0 0 ].
 		Vec3 moment;
 
-		/// Random seed used for the perturbation sequence; default = 5489.
+		/// Random seed used for the perturbation sequence, to which the ''random_seed_offset'' of the model is added; default = 5489.
 		unsigned int random_seed;
 
 		/// Fixed time [s] between two perturbations; default 2.
@@ -56,6 +56,9 @@ namespace scone
 	protected:
 		virtual String GetClassSignature() const override;
 
+		// the perturbation schedule is restored, so forked continuations can vary force and moment, but not timing
+		SCONE_INTERNAL_STATE( perturbations, rng_, active_ )
+
 	private:
 		struct Perturbation {
 			TimeInSeconds start;
@@ -38,6 +38,16 @@ namespace scone
 		SCONE_THROW_NOT_IMPLEMENTED;
 	}
 
+	std::any Reflex::GetInternalState() const
+	{
+		SCONE_THROW( "Reflex for " + actuator_.GetName() + " does not support checkpoints" );
+	}
+
+	void Reflex::SetInternalState( const std::any& state )
+	{
+		SCONE_THROW( "Reflex for " + actuator_.GetName() + " does not support checkpoints" );
+	}
+
 	scone::Real Reflex::AddTargetControlValue( Real u )
 	{
 		xo::clamp( u, min_control_value, max_control_value );
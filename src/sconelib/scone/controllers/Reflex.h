@@ -14,6 +14,7 @@
 #include "scone/core/PropNode.h"
 #include "scone/model/Location.h"
 #include "scone/optimization/Params.h"
+#include "Controller.h"
 
 namespace scone
 {
@@ -40,6 +41,10 @@ namespace scone
 		virtual void ComputeControls( double timestamp );
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override {}
 
+		// Internal state that changes during simulation, used for model checkpoints; throws by default, see SCONE_INTERNAL_STATE
+		virtual std::any GetInternalState() const;
+		virtual void SetInternalState( const std::any& state );
+
 	protected:
 		/// clamp control value between min_control_value and max_control_value and add to target actuator
 		Real AddTargetControlValue( Real u );
@@ -71,4 +71,20 @@ namespace scone
 		for ( auto& r : m_Reflexes )
 			r->StoreData( frame, flags );
 	}
+
+	std::any ReflexController::GetInternalState() const
+	{
+		std::vector< std::any > states;
+		for ( auto& r : m_Reflexes )
+			states.push_back( r->GetInternalState() );
+		return states;
+	}
+
+	void ReflexController::SetInternalState( const std::any& state )
+	{
+		auto& states = std::any_cast< const std::vector< std::any >& >( state );
+		SCONE_ERROR_IF( states.size() != m_Reflexes.size(), "Checkpoint does not match the number of reflexes of " + GetName() );
+		for ( index_t i = 0; i < m_Reflexes.size(); ++i )
+			m_Reflexes[ i ]->SetInternalState( states[ i ] );
+	}
 }
@@ -39,6 +39,10 @@ namespace scone
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
 
+	protected:
+		virtual std::any GetInternalState() const override;
+		virtual void SetInternalState( const std::any& state ) override;
+
 	private:
 		std::vector< ReflexUP > m_Reflexes;
 	};
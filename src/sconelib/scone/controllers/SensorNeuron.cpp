@@ -23,6 +23,8 @@ namespace scone
 	SensorNeuron::SensorNeuron( const PropNode& pn, Params& par, NeuralController& nc, const String& name, index_t idx, Side side, const String& act_func ) :
 	Neuron( pn, name, idx, side, act_func ),
 	input_sensor_(),
+	model_( nc.GetModel() ),
+	input_( no_index ),
 	use_sample_delay_( false ),
 	sample_delay_frames_( 0 ),
 	sample_delay_window_( 21 ),
@@ -80,13 +82,20 @@ namespace scone
 			sensor_gain_ *= -1;
 
 		xo_error_if( !input_sensor_, "Unknown type " + type_ );
+		if ( use_sample_delay_ )
+			input_sensor_->ReserveSamples( sample_delay_frames_, sample_delay_window_ );
+		else input_ = model.AddDelayedSensorInput( *input_sensor_, delay_ );
 		source_name_ = name;
 	}
 
+	double SensorNeuron::GetSensorValue() const
+	{
+		return use_sample_delay_ ? input_sensor_->GetAverageValue( sample_delay_frames_, sample_delay_window_ ) : model_.GetDelayedSensorInput( input_ );
+	}
+
 	double SensorNeuron::GetOutput( double offset ) const
 	{
-		auto input = use_sample_delay_ ? input_sensor_->GetAverageValue( sample_delay_frames_, sample_delay_window_ ) : input_sensor_->GetValue( delay_ );
-		return output_ = activation_function( sensor_gain_ * ( input - offset_ - offset ) );
+		return output_ = activation_function( sensor_gain_ * ( GetSensorValue() - offset_ - offset ) );
 	}
 
 	string SensorNeuron::GetName( bool mirrored ) const
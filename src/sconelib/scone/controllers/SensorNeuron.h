@@ -15,10 +15,13 @@ namespace scone
 	{
 		SensorNeuron( const PropNode& pn, Params& par, NeuralController& nc, const String& name, index_t idx, Side side, const String& act_func );
 		double GetOutput( double offset = 0.0 ) const override;
+		double GetSensorValue() const;
 		virtual string GetName( bool mirrored ) const override;
 		virtual string GetParName() const override;
 
 		SensorDelayAdapter* input_sensor_;
+		const Model& model_;
+		index_t input_; // see Model::AddDelayedSensorInput(), not used with sample delays
 		TimeInSeconds delay_;
 		bool use_sample_delay_;
 		int sample_delay_frames_;
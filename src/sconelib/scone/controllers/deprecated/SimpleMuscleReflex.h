@@ -21,6 +21,7 @@ namespace scone
 
 		virtual void ComputeControls( double timestamp ) override;
 		virtual void StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const override {}
+		SCONE_NO_INTERNAL_STATE
 
 	private:
 		SensorDelayAdapter* m_Source;
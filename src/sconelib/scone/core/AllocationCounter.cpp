@@ -0,0 +1,126 @@
+/*
+** AllocationCounter.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "AllocationCounter.h"
+
+#ifdef SCONE_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#	include <malloc.h>
+#endif
+
+namespace scone
+{
+	static thread_local size_t g_ThreadAllocationCount = 0;
+
+	static void* counted_malloc( std::size_t size ) noexcept
+	{
+		++g_ThreadAllocationCount;
+		return std::malloc( size ? size : 1 );
+	}
+
+	static void* counted_aligned_malloc( std::size_t size, std::align_val_t al ) noexcept
+	{
+		++g_ThreadAllocationCount;
+		auto alignment = static_cast<std::size_t>( al );
+		size = ( ( size ? size : 1 ) + alignment - 1 ) / alignment * alignment;
+#ifdef _MSC_VER
+		return _aligned_malloc( size, alignment );
+#else
+		return std::aligned_alloc( alignment, size );
+#endif
+	}
+
+	static void aligned_free( void* p ) noexcept
+	{
+#ifdef _MSC_VER
+		_aligned_free( p );
+#else
+		std::free( p );
+#endif
+	}
+}
+
+// replacements of the global allocation functions, which count allocations per thread
+// on Windows, these only affect allocations made from within sconelib
+void* operator new( std::size_t size )
+{
+	if ( void* p = scone::counted_malloc( size ) )
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size )
+{
+	return operator new( size );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return scone::counted_malloc( size );
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return scone::counted_malloc( size );
+}
+
+void* operator new( std::size_t size, std::align_val_t al )
+{
+	if ( void* p = scone::counted_aligned_malloc( size, al ) )
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size, std::align_val_t al )
+{
+	return operator new( size, al );
+}
+
+void* operator new( std::size_t size, std::align_val_t al, const std::nothrow_t& ) noexcept
+{
+	return scone::counted_aligned_malloc( size, al );
+}
+
+void* operator new[]( std::size_t size, std::align_val_t al, const std::nothrow_t& ) noexcept
+{
+	return scone::counted_aligned_malloc( size, al );
+}
+
+void operator delete( void* p ) noexcept { std::free( p ); }
+void operator delete[]( void* p ) noexcept { std::free( p ); }
+void operator delete( void* p, std::size_t ) noexcept { std::free( p ); }
+void operator delete[]( void* p, std::size_t ) noexcept { std::free( p ); }
+void operator delete( void* p, const std::nothrow_t& ) noexcept { std::free( p ); }
+void operator delete[]( void* p, const std::nothrow_t& ) noexcept { std::free( p ); }
+
+void operator delete( void* p, std::align_val_t ) noexcept { scone::aligned_free( p ); }
+void operator delete[]( void* p, std::align_val_t ) noexcept { scone::aligned_free( p ); }
+void operator delete( void* p, std::size_t, std::align_val_t ) noexcept { scone::aligned_free( p ); }
+void operator delete[]( void* p, std::size_t, std::align_val_t ) noexcept { scone::aligned_free( p ); }
+void operator delete( void* p, std::align_val_t, const std::nothrow_t& ) noexcept { scone::aligned_free( p ); }
+void operator delete[]( void* p, std::align_val_t, const std::nothrow_t& ) noexcept { scone::aligned_free( p ); }
+
+namespace scone
+{
+	size_t GetThreadAllocationCount() { return g_ThreadAllocationCount; }
+	bool IsAllocationCountingEnabled() { return true; }
+}
+
+#else
+
+namespace scone
+{
+	size_t GetThreadAllocationCount() { return 0; }
+	bool IsAllocationCountingEnabled() { return false; }
+}
+
+#endif
@@ -0,0 +1,22 @@
+/*
+** AllocationCounter.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "platform.h"
+#include <cstddef>
+
+namespace scone
+{
+	/// Number of heap allocations made by the current thread.
+	/// Allocations are only counted when built with SCONE_COUNT_ALLOCATIONS, otherwise this always returns zero.
+	SCONE_API size_t GetThreadAllocationCount();
+
+	/// Check if heap allocations are counted in this build.
+	SCONE_API bool IsAllocationCountingEnabled();
+}
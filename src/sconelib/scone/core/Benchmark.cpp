@@ -5,6 +5,8 @@
 #include "scone/optimization/Optimizer.h"
 #include "scone/optimization/SimulationObjective.h"
 #include "scone/core/profiler_config.h"
+#include "scone/core/Exception.h"
+#include "scone/core/AllocationCounter.h"
 
 #include "xo/time/timer.h"
 #include "xo/container/prop_node_tools.h"
@@ -13,8 +15,13 @@
 #include "xo/container/container_algorithms.h"
 #include "xo/time/time.h"
 #include "xo/thread/thread_priority.h"
+#include "xo/string/string_cast.h"
+#include "xo/system/system_tools.h"
 #include "Log.h"
 
+#include <thread>
+#include <atomic>
+
 namespace scone
 {
 	void BenchmarkScenario( const PropNode& scenario_pn, const path& file, size_t evals )
@@ -107,4 +114,139 @@ namespace scone
 			}
 		}
 	}
+
+	std::pair< BenchmarkSamples, double > BenchmarkScenarioSamples( const PropNode& scenario_pn, const path& file, size_t thread_count, size_t evals_per_thread )
+	{
+		auto opt = CreateOptimizer( scenario_pn, file.parent_path() );
+		auto mo = dynamic_cast<ModelObjective*>( &opt->GetObjective() );
+		SCONE_THROW_IF( !mo, "Benchmark requires a ModelObjective" );
+		const auto par = SearchPoint( mo->info() );
+
+		// each thread collects its own samples, which are merged afterwards
+		std::vector< xo::flat_map< string, std::vector< double > > > thread_samples( thread_count );
+		std::atomic< size_t > errors{ 0 };
+		std::vector< std::thread > threads;
+		xo::timer t;
+		for ( index_t thread_idx = 0; thread_idx < thread_count; ++thread_idx )
+		{
+			threads.emplace_back( [&, thread_idx]() {
+				auto& samples = thread_samples[ thread_idx ];
+				try
+				{
+					for ( index_t idx = 0; idx < evals_per_thread; ++idx )
+					{
+						xo::timer eval_timer;
+						auto thread_par = par;
+						auto model = mo->CreateModelFromParams( thread_par );
+						model->SetStoreData( true ); // include the Storage component
+						model->SetBenchmarking( true );
+						auto create_time = eval_timer();
+
+						// count allocations in the second half of the simulation, when the model is in a steady state
+						auto end_time = model->GetSimulationEndTime();
+						model->AdvanceSimulationTo( end_time / 2 );
+						auto start_allocs = GetThreadAllocationCount();
+						auto start_step = model->GetIntegrationStep();
+						model->AdvanceSimulationTo( end_time );
+						auto step_allocs = GetThreadAllocationCount() - start_allocs;
+						auto steps = model->GetIntegrationStep() - start_step;
+						auto eval_time = eval_timer();
+
+						samples[ "ModelCreate" ].push_back( create_time.milliseconds() );
+						samples[ "Evaluation" ].push_back( eval_time.milliseconds() );
+						for ( const auto& [name, bm] : model->GetBenchmarks() )
+							samples[ name ].push_back( bm.first.nanosecondsd() / bm.second );
+						if ( IsAllocationCountingEnabled() && steps > 0 )
+						{
+							samples[ "StepAllocations" ].push_back( double( step_allocs ) / steps );
+							for ( const auto& [name, allocs] : model->GetBenchmarkAllocations() )
+								samples[ name ].push_back( allocs );
+						}
+					}
+				}
+				catch ( std::exception& e )
+				{
+					log::error( "Error during evaluation: ", e.what() );
+					++errors;
+				}
+			} );
+		}
+		for ( auto& thread : threads )
+			thread.join();
+		auto duration = t().seconds();
+		SCONE_ERROR_IF( errors > 0, "Benchmark failed with " + xo::to_str( errors.load() ) + " errors" );
+
+		xo::flat_map< string, std::vector< double > > merged;
+		for ( const auto& samples : thread_samples )
+			for ( const auto& [name, values] : samples )
+				merged[ name ].insert( merged[ name ].end(), values.begin(), values.end() );
+
+		return { BenchmarkSamples( merged.begin(), merged.end() ), thread_count * evals_per_thread / duration };
+	}
+
+	PropNode BenchmarkScenarioScaling( const PropNode& scenario_pn, const path& file, size_t max_threads, size_t evals_per_thread )
+	{
+		auto opt = CreateOptimizer( scenario_pn, file.parent_path() );
+		auto mo = dynamic_cast<ModelObjective*>( &opt->GetObjective() );
+		SCONE_THROW_IF( !mo, "Scaling benchmark requires a ModelObjective" );
+		const auto par = SearchPoint( mo->info() );
+
+		// warm-up, initializes the model configuration
+		{
+			auto warmup_par = par;
+			auto model = mo->CreateModelFromParams( warmup_par );
+			model->SetStoreData( false );
+			model->AdvanceSimulationTo( model->GetSimulationEndTime() );
+		}
+
+		PropNode results;
+		results.set( "scenario", file.filename().str() );
+		results.set( "computer", xo::get_computer_name() );
+		results.set( "hardware_concurrency", std::thread::hardware_concurrency() );
+		results.set( "evals_per_thread", evals_per_thread );
+		double single_thread_rate = 0.0;
+		log::info( xo::stringf( "%8s\t%10s\t%8s\t%10s", "threads", "evals/s", "speedup", "efficiency" ) );
+		for ( size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2 )
+		{
+			std::atomic< size_t > errors{ 0 };
+			std::vector< std::thread > threads;
+			xo::timer t;
+			for ( index_t thread_idx = 0; thread_idx < thread_count; ++thread_idx )
+			{
+				threads.emplace_back( [&]() {
+					try
+					{
+						for ( index_t idx = 0; idx < evals_per_thread; ++idx )
+						{
+							auto thread_par = par;
+							auto model = mo->CreateModelFromParams( thread_par );
+							model->SetStoreData( false );
+							model->AdvanceSimulationTo( model->GetSimulationEndTime() );
+						}
+					}
+					catch ( std::exception& e )
+					{
+						log::error( "Error during evaluation: ", e.what() );
+						++errors;
+					}
+				} );
+			}
+			for ( auto& thread : threads )
+				thread.join();
+			auto duration = t().seconds();
+			SCONE_ERROR_IF( errors > 0, "Scaling benchmark failed with " + xo::to_str( errors.load() ) + " errors" );
+
+			auto rate = thread_count * evals_per_thread / duration;
+			if ( thread_count == 1 )
+				single_thread_rate = rate;
+			auto speedup = rate / single_thread_rate;
+			log::info( xo::stringf( "%8d\t%10.2f\t%7.2fx\t%9.1f%%", int( thread_count ), rate, speedup, 100.0 * speedup / thread_count ) );
+			auto& rpn = results.add_child( "T" + xo::to_str( thread_count ) );
+			rpn.set( "threads", thread_count );
+			rpn.set( "evaluations_per_second", rate );
+			rpn.set( "speedup", speedup );
+			rpn.set( "efficiency", speedup / thread_count );
+		}
+		return results;
+	}
 }
@@ -6,11 +6,28 @@
 #include "xo/filesystem/path.h"
 #include "types.h"
 
+#include <vector>
+#include <utility>
+
 namespace scone
 {
 	/// Creates and evaluates SimulationObjective. Logs unused properties.
 	SCONE_API void BenchmarkScenario( const PropNode& scenario_pn, const xo::path& file, size_t evals );
 
+	/// Evaluates SimulationObjective concurrently, using 1 up to max_threads threads (doubling each run).
+	/// Each evaluation includes model creation and simulation, without storing data. A single evaluation is performed beforehand,
+	/// so that the first (serialized) initialization of the model configuration is not included in the results.
+	/// Logs and returns evaluations per second, speedup and efficiency for each thread count.
+	SCONE_API PropNode BenchmarkScenarioScaling( const PropNode& scenario_pn, const xo::path& file, size_t max_threads, size_t evals_per_thread );
+
+	/// Timing samples of a benchmark run for each component: ''ModelCreate'' and ''Evaluation'' in ms, per-step components in ns.
+	/// Builds with SCONE_COUNT_ALLOCATIONS also include heap allocations per step and per component call.
+	using BenchmarkSamples = std::vector< std::pair< String, std::vector< double > > >;
+
+	/// Evaluates a scenario evals_per_thread times on each of thread_count threads, collecting timing samples per component.
+	/// Also returns the end-to-end number of evaluations per second.
+	SCONE_API std::pair< BenchmarkSamples, double > BenchmarkScenarioSamples( const PropNode& scenario_pn, const xo::path& file, size_t thread_count, size_t evals_per_thread );
+
 	struct SCONE_API Benchmark {
 		String name_;
 		xo::time time_;
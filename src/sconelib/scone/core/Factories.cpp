@@ -43,6 +43,7 @@
 
 #include "scone/optimization/CmaOptimizerSpot.h"
 #include "scone/optimization/CmaPoolOptimizer.h"
+#include "scone/optimization/AsyncCmaOptimizer.h"
 #include "scone/optimization/ImitationObjective.h"
 #include "scone/optimization/SimilarityObjective.h"
 #include "scone/optimization/SimulationObjective.h"
@@ -162,7 +163,8 @@ namespace scone
 		static OptimizerFactory g_OptimizerFactory = OptimizerFactory()
 			.register_type< CmaOptimizerSpot >( "CmaOptimizer" )
 			.register_type< CmaOptimizerSpot >()
-			.register_type< CmaPoolOptimizer >();
+			.register_type< CmaPoolOptimizer >()
+			.register_type< AsyncCmaOptimizer >();
 
 		return g_OptimizerFactory;
 	}
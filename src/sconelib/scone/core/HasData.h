@@ -11,6 +11,8 @@
 #include "Storage.h"
 #include "xo/container/flag_set.h"
 
+#include <initializer_list>
+
 namespace scone
 {
 	enum class StoreDataTypes {
@@ -38,6 +40,40 @@ namespace scone
 
 	using StoreDataFlags = xo::flag_set< StoreDataTypes >;
 
+	/// Precompiled channel indices for a group of labels, registered once for each Storage.
+	/// Use this in StoreData() to write values by index instead of creating labels each frame.
+	class StoreDataChannels
+	{
+	public:
+		StoreDataChannels() : m_SchemaId( 0 ) {}
+
+		/// Register count channels with labels from label_fn( index ), if not already done for this Storage.
+		/// Channels with an empty label are not registered.
+		template< typename F > const StoreDataChannels& Get( Storage< Real >::Frame& frame, size_t count, F label_fn ) {
+			auto& sto = frame.GetStorage();
+			if ( m_SchemaId != sto.GetSchemaId() || m_Indices.size() != count ) {
+				m_Indices.clear();
+				for ( index_t i = 0; i < count; ++i ) {
+					String label = label_fn( i );
+					m_Indices.push_back( label.empty() ? NoIndex : sto.GetOrAddChannel( label ) );
+				}
+				m_SchemaId = sto.GetSchemaId();
+			}
+			return *this;
+		}
+
+		/// Register channels with labels prefix + postfix, if not already done for this Storage.
+		const StoreDataChannels& Get( Storage< Real >::Frame& frame, const String& prefix, std::initializer_list< const char* > postfixes ) {
+			return Get( frame, postfixes.size(), [&]( index_t i ) { return prefix + postfixes.begin()[ i ]; } );
+		}
+
+		index_t operator[]( index_t i ) const { return m_Indices[ i ]; }
+
+	private:
+		size_t m_SchemaId;
+		std::vector< index_t > m_Indices;
+	};
+
 	/// Objects derived from this class can store data for analysis
 	class SCONE_API HasData
 	{
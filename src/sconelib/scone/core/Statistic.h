@@ -73,6 +73,7 @@ namespace scone
 		}
 
 		double GetPrevTime() { return m_PrevTime; }
+		TimeInSeconds GetStartTime() const { return m_StartTime; }
 
 		T GetAverage() const
 		{
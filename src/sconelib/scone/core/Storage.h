@@ -13,8 +13,10 @@
 #include "Exception.h"
 #include "Vec3.h"
 
-#include <memory>
+#include <atomic>
+#include <deque>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -22,40 +24,65 @@
 
 namespace scone
 {
+	/// Time series storage with named channels.
+	/// Values are stored column-wise in a single contiguous block, so each channel is a contiguous array.
 	template< typename ValueT = Real, typename TimeT = TimeInSeconds >
 	class Storage
 	{
 	public:
+		/// Read-only view on the values of a frame, which are stored per channel
+		class ValueView
+		{
+		public:
+			ValueView( const ValueT* const* channels, size_t size, index_t frame_idx ) : m_Channels( channels ), m_Size( size ), m_Index( frame_idx ) {}
+
+			size_t size() const { return m_Size; }
+			const ValueT& operator[]( index_t idx ) const { return m_Channels[ idx ][ m_Index ]; }
+
+			/// Copy the values to a vector, which only allocates if its capacity is insufficient
+			void CopyTo( std::vector< ValueT >& values ) const {
+				values.resize( m_Size );
+				for ( index_t idx = 0; idx < m_Size; ++idx )
+					values[ idx ] = m_Channels[ idx ][ m_Index ];
+			}
+			std::vector< ValueT > ToVector() const { std::vector< ValueT > values; CopyTo( values ); return values; }
+
+		private:
+			const ValueT* const* m_Channels;
+			size_t m_Size;
+			index_t m_Index;
+		};
+
+		/// Lightweight view on a single frame of a Storage
 		class Frame
 		{
 		public:
 			friend class Storage;
 
-			Frame( Storage& store, TimeT t, ValueT default_value = ValueT( 0 ) ) :
-			m_Store( store ),
-			m_Time( t ),
-			m_Values( store.GetChannelCount(), default_value ) { }
+			Frame( Storage& store, index_t frame_idx ) : m_Store( &store ), m_Index( frame_idx ) {}
 
-			TimeT GetTime() const { return m_Time; }
+			TimeT GetTime() const { return m_Store->m_Times[ m_Index ]; }
+			index_t GetIndex() const { return m_Index; }
 
-			ValueT& operator[]( index_t idx ) { return m_Values[ idx ]; }
+			Storage& GetStorage() { return *m_Store; }
+			const Storage& GetStorage() const { return *m_Store; }
 
-			const ValueT& operator[]( index_t idx ) const { return m_Values[ idx ]; }
+			ValueT& operator[]( index_t idx ) { return m_Store->Value( idx, m_Index ); }
+
+			const ValueT& operator[]( index_t idx ) const { return GetStorage().Value( idx, m_Index ); }
 
 			ValueT& operator[]( const String& label ) {
-				index_t idx = m_Store.GetChannelIndex( label );
-				if ( idx == NoIndex )
-					idx = m_Store.AddChannel( label );
-				return m_Values[ idx ];
+				return m_Store->Value( m_Store->GetOrAddChannel( label ), m_Index );
 			}
 
 			const ValueT& operator[]( const String& label ) const {
-				index_t idx = m_Store.GetChannelIndex( label );
+				index_t idx = m_Store->GetChannelIndex( label );
 				SCONE_ASSERT( idx != NoIndex );
-				return m_Values[ idx ];
+				return GetStorage().Value( idx, m_Index );
 			}
 
-			const std::vector< ValueT >& GetValues() const { return m_Values; }
+			/// View on the values of this frame, valid until the next AddFrame() or AddChannel()
+			ValueView GetValues() const { return ValueView( m_Store->m_Channels.data(), m_Store->GetChannelCount(), m_Index ); }
 
 			void SetVec3( const String& label, const Vec3& vec ) {
 				(*this)[ label + "_x" ] = vec.x;
@@ -64,91 +91,145 @@ namespace scone
 			}
 
 			Vec3 GetVec3( index_t idx ) const {
-				SCONE_ASSERT( idx != NoIndex && idx + 2 < m_Values.size() );
-				return Vec3( m_Values[ idx ], m_Values[ idx + 1 ], m_Values[ idx + 2 ] );
+				SCONE_ASSERT( idx != NoIndex && idx + 2 < m_Store->GetChannelCount() );
+				return Vec3( (*this)[ idx ], (*this)[ idx + 1 ], (*this)[ idx + 2 ] );
 			}
 
 		private:
-			Storage< ValueT, TimeT >& m_Store;
-			TimeT m_Time;
-			std::vector< ValueT > m_Values;
+			Storage< ValueT, TimeT >* m_Store;
+			index_t m_Index;
 		};
-		typedef std::unique_ptr< Frame > FrameUP;
 
-		Storage() {}
-		Storage( const Storage& other ) {
+		Storage() : m_FrameCapacity( 0 ), m_ExternalValues( nullptr ), m_SchemaId( NewSchemaId() ) {}
+		Storage( const Storage& other ) : Storage() {
 			*this = other;
 		};
-		Storage( Storage&& other ) {
+		Storage( Storage&& other ) : Storage() {
 			*this = std::move( other );
 		};
-		Storage( const std::vector< String >& labels ) : m_Labels( labels ) {
+		Storage( const std::vector< String >& labels ) : Storage() {
+			m_Labels = labels;
 			for ( index_t i = 0; i < m_Labels.size(); ++i )
 				m_LabelIndexMap[ m_Labels[ i ] ] = i;
+			UpdateChannels();
 		}
 		Storage& operator=( const Storage& other ) {
 			m_Labels = other.m_Labels;
 			m_LabelIndexMap = other.m_LabelIndexMap;
-			m_Data.clear();
-			m_Data.reserve( other.m_Data.size() );
-			for ( auto it = other.m_Data.begin(); it != other.m_Data.end(); ++it )
-				m_Data.push_back( std::make_unique<Frame>( **it ) );
-			m_InterpolationCache.clear();
+			m_Times = other.m_Times;
+			m_Values = other.m_Values;
+			m_FrameCapacity = other.m_FrameCapacity;
+			m_ExternalValues = other.m_ExternalValues;
+			m_ExternalOwner = other.m_ExternalOwner;
+			m_ChannelCopies = other.m_ChannelCopies;
+			m_SchemaId = NewSchemaId(); // channels may diverge from other
+			UpdateChannels();
+			UpdateFrames();
 			return *this;
 		};
 		Storage& operator=( Storage&& other ) {
 			m_Labels = std::move( other.m_Labels );
 			m_LabelIndexMap = std::move( other.m_LabelIndexMap );
-			m_Data = std::move( other.m_Data );
-			m_InterpolationCache.clear();
+			m_Times = std::move( other.m_Times );
+			m_Values = std::move( other.m_Values );
+			m_FrameCapacity = other.m_FrameCapacity;
+			m_ExternalValues = other.m_ExternalValues;
+			m_ExternalOwner = std::move( other.m_ExternalOwner );
+			m_ChannelCopies = std::move( other.m_ChannelCopies );
+			m_SchemaId = other.m_SchemaId;
+			UpdateChannels();
+			UpdateFrames();
+			other.Clear();
 			return *this;
 		};
 
-		void Clear() { m_Labels.clear(); m_LabelIndexMap.clear(); m_Data.clear(); m_InterpolationCache.clear(); }
+		void Clear() { m_Labels.clear(); m_LabelIndexMap.clear(); m_Values.clear(); m_FrameCapacity = 0; m_SchemaId = NewSchemaId(); ClearFrames(); UpdateChannels(); }
+		void ClearFrames() {
+			m_Times.clear(); m_Frames.clear(); m_InterpolationCache.clear();
+			if ( m_ExternalOwner ) { m_FrameCapacity = 0; m_ExternalValues = nullptr; m_ExternalOwner.reset(); m_ChannelCopies.clear(); m_Values.clear(); UpdateChannels(); }
+		}
+
+		/// Use read-only channel-major values that are owned by an external object (e.g. a memory mapped file).
+		/// Values are not copied until the storage is modified, in which case only the modified channel is copied.
+		/// Note that non-const access to a value (e.g. through a non-const Frame) also copies its channel.
+		void SetExternalData( const std::vector< String >& labels, std::vector< TimeT > times, const ValueT* values, std::shared_ptr< const void > owner ) {
+			*this = Storage( labels );
+			m_Times = std::move( times );
+			m_FrameCapacity = m_Times.size();
+			m_ExternalValues = values;
+			m_ExternalOwner = std::move( owner );
+			UpdateChannels();
+			UpdateFrames();
+		}
+		bool HasExternalData() const { return m_ExternalOwner != nullptr; }
+
+		/// Remove all frames after the first frame_count frames, channels are kept
+		void TruncateFrames( size_t frame_count ) {
+			if ( frame_count >= GetFrameCount() )
+				return;
+			m_Times.resize( frame_count );
+			while ( m_Frames.size() > frame_count )
+				m_Frames.pop_back();
+			m_InterpolationCache.clear();
+		}
+
+		/// Allocate memory for a number of frames, to prevent reallocation when frames are added
+		void Reserve( size_t frame_count ) { if ( frame_count > m_FrameCapacity ) SetFrameCapacity( frame_count ); }
 
 		Storage CopySlice( size_t start, size_t size, size_t stride ) const {
 			SCONE_ASSERT( stride > 0 );
-			Storage r;
-			r.m_Labels = m_Labels;
-			r.m_LabelIndexMap = m_LabelIndexMap;
+			Storage r( m_Labels );
 			if ( size == 0 || size > GetFrameCount() / stride )
 				size = ( GetFrameCount() + stride - 1 ) / stride;
-			r.m_Data.reserve( size );
-			for ( size_t i = start; r.m_Data.size() < size && i < m_Data.size(); i += stride )
-				r.m_Data.push_back( std::make_unique<Frame>( *m_Data[ i ] ) );
+			r.Reserve( size );
+			for ( size_t i = start; r.GetFrameCount() < size && i < GetFrameCount(); i += stride ) {
+				auto& f = r.AddFrame( m_Times[ i ] );
+				for ( index_t c = 0; c < GetChannelCount(); ++c )
+					f[ c ] = Value( c, i );
+			}
 			return r;
 		}
 
 		Frame& AddFrame( TimeT time, ValueT default_value = ValueT( 0 ) ) {
-			SCONE_THROW_IF( !m_Data.empty() && time <= m_Data.back()->GetTime(), "Frame must have higher timestamp" );
-			m_Data.push_back( std::make_unique<Frame>( *this, time, default_value ) );
-			m_InterpolationCache.clear(); // cached iterators have become invalid
-			return *m_Data.back();
+			SCONE_THROW_IF( !m_Times.empty() && time <= m_Times.back(), "Frame must have higher timestamp" );
+			if ( m_Times.size() == m_FrameCapacity || m_ExternalOwner )
+				SetFrameCapacity( std::max< size_t >( 64, 2 * m_FrameCapacity ) );
+			index_t frame_idx = m_Times.size();
+			m_Times.push_back( time );
+			for ( index_t c = 0; c < GetChannelCount(); ++c )
+				Value( c, frame_idx ) = default_value;
+			m_Frames.emplace_back( *this, frame_idx );
+			m_InterpolationCache.clear(); // cached interpolations have become invalid
+			return m_Frames.back();
 		}
-		
-		bool IsEmpty() const { return m_Data.empty(); }
 
-		Frame& Back() { SCONE_ASSERT( !m_Data.empty() ); return *m_Data.back(); }
-		const Frame& Back() const { SCONE_ASSERT( !m_Data.empty() ); return *m_Data.back(); }
+		bool IsEmpty() const { return m_Frames.empty(); }
 
-		Frame& GetFrame( index_t frame_idx ) { SCONE_ASSERT( frame_idx < m_Data.size() ); return *m_Data[ frame_idx ]; }
-		const Frame& GetFrame( index_t frame_idx ) const { SCONE_ASSERT( frame_idx < m_Data.size() ); return *m_Data[ frame_idx ]; }
+		Frame& Back() { SCONE_ASSERT( !m_Frames.empty() ); return m_Frames.back(); }
+		const Frame& Back() const { SCONE_ASSERT( !m_Frames.empty() ); return m_Frames.back(); }
+
+		Frame& GetFrame( index_t frame_idx ) { SCONE_ASSERT( frame_idx < m_Frames.size() ); return m_Frames[ frame_idx ]; }
+		const Frame& GetFrame( index_t frame_idx ) const { SCONE_ASSERT( frame_idx < m_Frames.size() ); return m_Frames[ frame_idx ]; }
 
 		std::vector< ValueT > GetChannelData( index_t idx ) const {
-			std::vector< ValueT > result( GetFrameCount() );
-			for ( index_t f = 0; f < GetFrameCount(); ++f )
-				result[ f ] = GetFrame( f )[ idx ];
-			return result;
+			auto* values = GetChannelValues( idx );
+			return std::vector< ValueT >( values, values + GetFrameCount() );
 		}
 
-		size_t GetFrameCount() const { return m_Data.size(); }
+		/// Contiguous array with all values of a channel, valid until the next AddFrame() or AddChannel()
+		const ValueT* GetChannelValues( index_t idx ) const { SCONE_ASSERT( idx < GetChannelCount() ); return m_Channels[ idx ]; }
+
+		size_t GetFrameCount() const { return m_Times.size(); }
+		const std::vector< TimeT >& GetTimes() const { return m_Times; }
 
 		index_t AddChannel( const String& label, ValueT default_value = ValueT( 0 ) ) {
 			SCONE_ASSERT_MSG( GetChannelIndex( label ) == NoIndex, "Channel " + label + " already exists" );
+			MakeWritable();
 			m_Labels.push_back( label );
 			m_LabelIndexMap[ label ] = m_Labels.size() - 1;
-			for ( auto it = m_Data.begin(); it != m_Data.end(); ++it )
-				(*it)->m_Values.resize( m_Labels.size(), default_value ); // resize existing data
+			m_Values.resize( m_Labels.size() * m_FrameCapacity, default_value );
+			std::fill_n( m_Values.end() - m_FrameCapacity, GetFrameCount(), default_value ); // set existing data
+			UpdateChannels();
 			return m_Labels.size() - 1;
 		}
 
@@ -159,25 +240,98 @@ namespace scone
 			else return it->second;
 		}
 
+		/// Get the index of a channel, add a new channel if it doesn't exist
+		index_t GetOrAddChannel( const String& label, ValueT default_value = ValueT( 0 ) ) {
+			index_t idx = GetChannelIndex( label );
+			return idx != NoIndex ? idx : AddChannel( label, default_value );
+		}
+
+		/// Identifier that changes whenever existing channel indices become invalid
+		size_t GetSchemaId() const { return m_SchemaId; }
+
 		size_t GetChannelCount() const { return m_Labels.size(); }
 		const std::vector< String >& GetLabels() const { return m_Labels; }
-		const std::vector< FrameUP >& GetData() const { return m_Data; }
+		const std::deque< Frame >& GetData() const { return m_Frames; }
 
 		ValueT GetInterpolatedValue( TimeT time, index_t idx ) const {
-			SCONE_ASSERT( !m_Data.empty() );
+			SCONE_ASSERT( !m_Frames.empty() );
 			return GetInterpolatedFrame( time ).value( idx );
 		}
 
 	private:
+		ValueT& Value( index_t channel_idx, index_t frame_idx ) {
+			if ( m_ExternalOwner )
+				MakeChannelWritable( channel_idx );
+			return const_cast<ValueT*>( m_Channels[ channel_idx ] )[ frame_idx ]; // points to m_Values or m_ChannelCopies
+		}
+		const ValueT& Value( index_t channel_idx, index_t frame_idx ) const { return m_Channels[ channel_idx ][ frame_idx ]; }
+
+		// copy all external values, so that channels or frames can be added
+		void MakeWritable() { if ( m_ExternalOwner ) SetFrameCapacity( m_FrameCapacity ); }
+
+		// copy the external values of a single channel, so it can be modified
+		void MakeChannelWritable( index_t channel_idx ) {
+			if ( m_ChannelCopies.size() != GetChannelCount() )
+				m_ChannelCopies.resize( GetChannelCount() );
+			auto& copy = m_ChannelCopies[ channel_idx ];
+			if ( copy.empty() && GetFrameCount() > 0 ) {
+				copy.assign( m_Channels[ channel_idx ], m_Channels[ channel_idx ] + GetFrameCount() );
+				m_Channels[ channel_idx ] = copy.data();
+			}
+		}
+
+		// update the pointers to the values of each channel
+		void UpdateChannels() {
+			m_Channels.resize( GetChannelCount() );
+			for ( index_t c = 0; c < GetChannelCount(); ++c ) {
+				if ( !m_ExternalOwner )
+					m_Channels[ c ] = m_Values.data() + c * m_FrameCapacity;
+				else if ( c < m_ChannelCopies.size() && !m_ChannelCopies[ c ].empty() )
+					m_Channels[ c ] = m_ChannelCopies[ c ].data();
+				else m_Channels[ c ] = m_ExternalValues + c * m_FrameCapacity;
+			}
+		}
+
+		void SetFrameCapacity( size_t capacity ) {
+			SCONE_ASSERT( capacity >= GetFrameCount() );
+			std::vector< ValueT > values( GetChannelCount() * capacity );
+			for ( index_t c = 0; c < GetChannelCount(); ++c )
+				std::copy_n( GetChannelValues( c ), GetFrameCount(), values.begin() + c * capacity );
+			m_Values = std::move( values );
+			m_FrameCapacity = capacity;
+			m_ExternalValues = nullptr;
+			m_ExternalOwner.reset();
+			m_ChannelCopies.clear();
+			UpdateChannels();
+		}
+
+		void UpdateFrames() {
+			m_Frames.clear();
+			for ( index_t i = 0; i < m_Times.size(); ++i )
+				m_Frames.emplace_back( *this, i );
+			m_InterpolationCache.clear();
+		}
+
+		static size_t NewSchemaId() { static std::atomic< size_t > id{ 0 }; return ++id; }
+
 		std::vector< String > m_Labels;
-		std::vector< std::unique_ptr< Frame > > m_Data;
 		std::unordered_map< String, index_t > m_LabelIndexMap;
+		std::vector< TimeT > m_Times;
+		std::vector< ValueT > m_Values; // channel-major, each channel has m_FrameCapacity values
+		size_t m_FrameCapacity;
+		const ValueT* m_ExternalValues; // read-only values, used instead of m_Values
+		std::shared_ptr< const void > m_ExternalOwner;
+		std::vector< std::vector< ValueT > > m_ChannelCopies; // modified channels of external values
+		std::vector< const ValueT* > m_Channels; // values of each channel, in m_Values, m_ExternalValues or m_ChannelCopies
+		std::deque< Frame > m_Frames;
+		size_t m_SchemaId;
 
 		// interpolation related stuff
 		struct InterpolatedFrame {
 			double upper_weight;
-			typename std::vector< FrameUP >::const_iterator upper_frame, lower_frame;
-			ValueT value( index_t channel_idx ) const { return upper_weight * (**upper_frame)[ channel_idx ] + ( 1.0 - upper_weight ) * (**lower_frame)[ channel_idx ]; }
+			const Storage* store;
+			index_t upper_frame, lower_frame;
+			ValueT value( index_t channel_idx ) const { return upper_weight * store->Value( channel_idx, upper_frame ) + ( 1.0 - upper_weight ) * store->Value( channel_idx, lower_frame ); }
 		};
 
 	public:
@@ -187,16 +341,23 @@ namespace scone
 			if ( cacheIt != m_InterpolationCache.end() )
 				return cacheIt->second;
 
-			// compute new one
+			// compute new one and store in cache
+			return m_InterpolationCache[ time ] = ComputeInterpolatedFrame( time );
+		}
+
+		/// Interpolated frame without using the cache, safe for read-only storage that is shared between threads
+		InterpolatedFrame ComputeInterpolatedFrame( TimeT time ) const {
+			SCONE_ASSERT( !m_Times.empty() );
 			InterpolatedFrame bf;
-			bf.upper_frame = std::upper_bound( m_Data.cbegin(), m_Data.cend(), time, []( TimeT lhs, const FrameUP &rhs) { return lhs < rhs->GetTime(); } );
-			if ( bf.upper_frame == m_Data.cend() )
+			bf.store = this;
+			bf.upper_frame = std::upper_bound( m_Times.cbegin(), m_Times.cend(), time ) - m_Times.cbegin();
+			if ( bf.upper_frame == m_Times.size() )
 			{
 				// timestamp too high, point to most recent frame
-				bf.lower_frame = bf.upper_frame = m_Data.begin() + m_Data.size() - 1;
+				bf.lower_frame = bf.upper_frame = m_Times.size() - 1;
 				bf.upper_weight = 1.0;
 			}
-			else if ( bf.upper_frame == m_Data.cbegin() )
+			else if ( bf.upper_frame == 0 )
 			{
 				// timestamp too low, point to oldest frame
 				bf.lower_frame = bf.upper_frame;
@@ -206,12 +367,9 @@ namespace scone
 			{
 				// we have an actual interpolation
 				bf.lower_frame = bf.upper_frame - 1;
-				bf.upper_weight = ( time - (*bf.lower_frame)->GetTime() ) / ( (*bf.upper_frame)->GetTime() - (*bf.lower_frame)->GetTime() );
+				bf.upper_weight = ( time - m_Times[ bf.lower_frame ] ) / ( m_Times[ bf.upper_frame ] - m_Times[ bf.lower_frame ] );
 			}
 
-			// store in cache
-			m_InterpolationCache[ time ] = bf;
-
 			return bf;
 		}
 
@@ -13,6 +13,24 @@
 #include "xo/filesystem/filesystem.h"
 #include <sstream>
 #include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#	define NOMINMAX
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
 
 #ifdef XO_COMP_MSVC
 #pragma warning( disable: 4996 )
@@ -30,9 +48,9 @@ namespace scone
 
 		for ( auto& frame : storage.GetData() )
 		{
-			str << frame->GetTime();
+			str << frame.GetTime();
 			for ( size_t idx = 0; idx < storage.GetChannelCount(); ++idx )
-				str << "\t" << ( *frame )[idx];
+				str << "\t" << frame[ idx ];
 			str << "\n";
 		}
 	}
@@ -46,9 +64,9 @@ namespace scone
 
 		for ( auto& frame : storage.GetData() )
 		{
-			fprintf( f, "%g", frame->GetTime() );
+			fprintf( f, "%g", frame.GetTime() );
 			for ( size_t idx = 0; idx < storage.GetChannelCount(); ++idx )
-				fprintf( f, "\t%g", ( *frame )[ idx ] );
+				fprintf( f, "\t%g", frame[ idx ] );
 			fprintf( f, "\n" );
 		}
 	}
@@ -120,6 +138,281 @@ namespace scone
 			ReadStorageTxt( storage, str ); // read as txt once we have found the header
 	}
 
+	namespace
+	{
+		// binary storage header, followed by text (name and labels, separated by newlines),
+		// padding to 8 bytes, frame times, and channel values (channel-major)
+		// all values are stored in the byte order of the writer, which is detected through byte_order
+		struct StorageBinHeader
+		{
+			char magic[ 8 ];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t value_size;
+			std::uint32_t reserved;
+			std::uint64_t frame_count;
+			std::uint64_t channel_count;
+			std::uint64_t text_size;
+		};
+		constexpr char storage_bin_magic[ 8 ] = { 'S', 'C', 'O', 'N', 'E', 'S', 'T', 'B' };
+		constexpr std::uint32_t storage_bin_version = 2;
+		constexpr std::uint32_t storage_bin_byte_order = 0x01020304;
+		size_t storage_bin_padding( size_t text_size ) { return ( 8 - text_size % 8 ) % 8; }
+
+		// multiply and add sizes, returns false on overflow
+		bool checked_mul( std::uint64_t a, std::uint64_t b, std::uint64_t& result ) {
+			if ( a != 0 && b > UINT64_MAX / a )
+				return false;
+			result = a * b;
+			return true;
+		}
+		bool checked_add( std::uint64_t a, std::uint64_t b, std::uint64_t& result ) {
+			if ( b > UINT64_MAX - a )
+				return false;
+			result = a + b;
+			return true;
+		}
+
+		// read-only memory mapped file
+		class MappedFile
+		{
+		public:
+			MappedFile( const xo::path& file ) : data_( nullptr ), size_( 0 ) {
+#ifdef _WIN32
+				// FILE_SHARE_DELETE allows WriteStorageBin() to replace the file while it is mapped
+				file_ = CreateFileA( file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+				SCONE_ERROR_IF( file_ == INVALID_HANDLE_VALUE, "Could not open file " + file.str() );
+				LARGE_INTEGER size;
+				GetFileSizeEx( file_, &size );
+				size_ = static_cast<size_t>( size.QuadPart );
+				mapping_ = size_ > 0 ? CreateFileMappingA( file_, nullptr, PAGE_READONLY, 0, 0, nullptr ) : nullptr;
+				if ( mapping_ )
+					data_ = static_cast<const char*>( MapViewOfFile( mapping_, FILE_MAP_READ, 0, 0, 0 ) );
+#else
+				int fd = open( file.c_str(), O_RDONLY );
+				SCONE_ERROR_IF( fd == -1, "Could not open file " + file.str() );
+				struct stat st;
+				if ( fstat( fd, &st ) == 0 && st.st_size > 0 ) {
+					size_ = static_cast<size_t>( st.st_size );
+					void* ptr = mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+					data_ = ptr != MAP_FAILED ? static_cast<const char*>( ptr ) : nullptr;
+				}
+				close( fd );
+#endif
+				if ( !data_ ) {
+					Unmap();
+					SCONE_ERROR( "Could not map file " + file.str() );
+				}
+			}
+			~MappedFile() { Unmap(); }
+			MappedFile( const MappedFile& ) = delete;
+			MappedFile& operator=( const MappedFile& ) = delete;
+
+			const char* data() const { return data_; }
+			size_t size() const { return size_; }
+
+		private:
+			void Unmap() {
+#ifdef _WIN32
+				if ( data_ ) UnmapViewOfFile( data_ );
+				if ( mapping_ ) CloseHandle( mapping_ );
+				if ( file_ != INVALID_HANDLE_VALUE ) CloseHandle( file_ );
+				mapping_ = nullptr;
+				file_ = INVALID_HANDLE_VALUE;
+#else
+				if ( data_ ) munmap( const_cast<char*>( data_ ), size_ );
+#endif
+				data_ = nullptr;
+			}
+
+			const char* data_;
+			size_t size_;
+#ifdef _WIN32
+			HANDLE file_ = INVALID_HANDLE_VALUE;
+			HANDLE mapping_ = nullptr;
+#endif
+		};
+	}
+
+	void WriteStorageBin( const Storage<Real, TimeInSeconds>& storage, const xo::path& file, const String& name )
+	{
+		String text = name;
+		for ( const auto& label : storage.GetLabels() )
+			text += '\n' + label;
+
+		StorageBinHeader header;
+		std::memcpy( header.magic, storage_bin_magic, sizeof( header.magic ) );
+		header.version = storage_bin_version;
+		header.byte_order = storage_bin_byte_order;
+		header.value_size = sizeof( Real );
+		header.reserved = 0;
+		header.frame_count = storage.GetFrameCount();
+		header.channel_count = storage.GetChannelCount();
+		header.text_size = text.size();
+
+		// write to a temporary file that replaces the target when complete, because the target may be mapped by a reader
+		// (truncating a mapped file causes SIGBUS on Linux, on Windows the file cannot be opened for writing)
+		const auto tmp_file = file.str() + ".tmp";
+		FILE* f = fopen( tmp_file.c_str(), "wb" );
+		SCONE_ERROR_IF( !f, "Could not open file " + tmp_file );
+		const char padding[ 8 ] = {};
+		fwrite( &header, sizeof( header ), 1, f );
+		fwrite( text.data(), 1, text.size(), f );
+		fwrite( padding, 1, storage_bin_padding( text.size() ), f );
+		fwrite( storage.GetTimes().data(), sizeof( TimeInSeconds ), storage.GetFrameCount(), f );
+		for ( index_t idx = 0; idx < storage.GetChannelCount(); ++idx )
+			fwrite( storage.GetChannelValues( idx ), sizeof( Real ), storage.GetFrameCount(), f );
+		bool ok = !ferror( f );
+		ok &= fclose( f ) == 0;
+		if ( !ok )
+		{
+			std::remove( tmp_file.c_str() );
+			SCONE_ERROR( "Error writing file " + tmp_file );
+		}
+#ifdef _WIN32
+		ok = MoveFileExA( tmp_file.c_str(), file.c_str(), MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+		ok = std::rename( tmp_file.c_str(), file.c_str() ) == 0;
+#endif
+		if ( !ok )
+		{
+			std::remove( tmp_file.c_str() );
+			SCONE_ERROR( "Could not replace file " + file.str() );
+		}
+	}
+
+	void ReadStorageBin( Storage<Real, TimeInSeconds>& storage, const xo::path& file )
+	{
+		auto mf = std::make_shared<MappedFile>( file );
+		SCONE_ERROR_IF( mf->size() < sizeof( StorageBinHeader ), "Invalid binary storage file " + file.str() );
+
+		StorageBinHeader header;
+		std::memcpy( &header, mf->data(), sizeof( header ) );
+		SCONE_ERROR_IF( std::memcmp( header.magic, storage_bin_magic, sizeof( header.magic ) ) != 0, "Invalid binary storage file " + file.str() );
+		SCONE_ERROR_IF( header.version != storage_bin_version, "Unsupported binary storage version in " + file.str() );
+		SCONE_ERROR_IF( header.byte_order != storage_bin_byte_order, "Binary storage was written on a system with a different byte order: " + file.str() );
+		SCONE_ERROR_IF( header.value_size != sizeof( Real ), "Unsupported value size in " + file.str() );
+
+		// check sizes without overflow, header values may be invalid
+		std::uint64_t times_offset, times_size, values_offset, values_size, end_offset;
+		bool valid_size = checked_add( sizeof( header ) + storage_bin_padding( header.text_size ), header.text_size, times_offset )
+			&& checked_mul( header.frame_count, sizeof( TimeInSeconds ), times_size )
+			&& checked_add( times_offset, times_size, values_offset )
+			&& checked_mul( header.channel_count, header.frame_count, values_size )
+			&& checked_mul( values_size, sizeof( Real ), values_size )
+			&& checked_add( values_offset, values_size, end_offset );
+		SCONE_ERROR_IF( !valid_size || end_offset > mf->size(), "Unexpected end of file " + file.str() );
+
+		// labels follow the name, each on a new line
+		std::vector< String > labels;
+		const char* text_end = mf->data() + sizeof( header ) + header.text_size;
+		const char* name_end = std::find( mf->data() + sizeof( header ), text_end, '\n' );
+		for ( const char* p = name_end; p != text_end; ) {
+			const char* label_end = std::find( ++p, text_end, '\n' );
+			labels.emplace_back( p, label_end );
+			p = label_end;
+		}
+		SCONE_ERROR_IF( labels.size() != header.channel_count, "Invalid labels in " + file.str() );
+
+		std::vector< TimeInSeconds > times( header.frame_count );
+		std::memcpy( times.data(), mf->data() + times_offset, times.size() * sizeof( TimeInSeconds ) );
+		auto values = reinterpret_cast<const Real*>( mf->data() + values_offset );
+		storage.SetExternalData( labels, std::move( times ), values, std::move( mf ) );
+	}
+
+	void WriteStorage( const Storage<Real, TimeInSeconds>& storage, const xo::path& file, const String& name )
+	{
+		if ( file.extension_no_dot() == StorageBinExtension )
+			WriteStorageBin( storage, file, name );
+		else WriteStorageSto( storage, file, name );
+	}
+
+	void ReadStorage( Storage<Real, TimeInSeconds>& storage, const xo::path& file )
+	{
+		if ( file.extension_no_dot() == StorageBinExtension )
+			ReadStorageBin( storage, file );
+		else ReadStorageSto( storage, file );
+	}
+
+	namespace
+	{
+		// identifies the contents of a file, st_mtime alone has a resolution of one second
+		struct FileVersion
+		{
+			long long modification_time = 0; // in nanoseconds (POSIX) or 100 nanoseconds (Windows)
+			long long size = 0;
+			unsigned long long inode = 0; // changes when WriteStorageBin() replaces the file
+			bool operator==( const FileVersion& o ) const { return modification_time == o.modification_time && size == o.size && inode == o.inode; }
+		};
+
+		FileVersion GetFileVersion( const xo::path& file )
+		{
+			FileVersion v;
+#ifdef _WIN32
+			WIN32_FILE_ATTRIBUTE_DATA fa;
+			if ( GetFileAttributesExA( file.c_str(), GetFileExInfoStandard, &fa ) )
+			{
+				v.modification_time = ( (long long)fa.ftLastWriteTime.dwHighDateTime << 32 ) | fa.ftLastWriteTime.dwLowDateTime;
+				v.size = ( (long long)fa.nFileSizeHigh << 32 ) | fa.nFileSizeLow;
+			}
+#else
+			struct stat st;
+			if ( stat( file.c_str(), &st ) == 0 )
+			{
+#	ifdef __APPLE__
+				v.modification_time = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#	else
+				v.modification_time = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#	endif
+				v.size = st.st_size;
+				v.inode = st.st_ino;
+			}
+#endif
+			return v;
+		}
+
+		// entries only keep storages alive while they are in use
+		struct StorageCacheEntry
+		{
+			FileVersion version;
+			std::weak_ptr< const Storage<Real, TimeInSeconds> > storage;
+		};
+		std::mutex g_StorageCacheMutex;
+		std::map< String, StorageCacheEntry > g_StorageCache;
+
+		StorageCSP FindCachedStorage( const String& key, const FileVersion& version )
+		{
+			std::lock_guard< std::mutex > lock( g_StorageCacheMutex );
+
+			// remove entries of storages that are no longer in use
+			for ( auto it = g_StorageCache.begin(); it != g_StorageCache.end(); )
+				it = it->second.storage.expired() ? g_StorageCache.erase( it ) : std::next( it );
+
+			auto it = g_StorageCache.find( key );
+			return it != g_StorageCache.end() && it->second.version == version ? it->second.storage.lock() : nullptr;
+		}
+	}
+
+	StorageCSP ReadStorageCached( const xo::path& file )
+	{
+		auto version = GetFileVersion( file );
+		const auto& key = file.str();
+		if ( auto sto = FindCachedStorage( key, version ) )
+			return sto;
+
+		// read outside the lock, in rare cases a file may be read by multiple threads simultaneously
+		auto sto = std::make_shared< Storage<Real, TimeInSeconds> >();
+		ReadStorage( *sto, file );
+
+		// use the storage of another thread if it finished first, so that all users share the same storage
+		std::lock_guard< std::mutex > lock( g_StorageCacheMutex );
+		auto& entry = g_StorageCache[ key ];
+		if ( auto existing = entry.storage.lock(); existing && entry.version == version )
+			return existing;
+		entry = StorageCacheEntry{ version, sto };
+		return sto;
+	}
+
 	void ReadStorageTxt( Storage<Real, TimeInSeconds>& storage, const xo::path& file )
 	{
 		auto str = xo::char_stream( xo::load_string( file ) );
@@ -13,6 +13,7 @@
 #include "xo/serialization/char_stream.h"
 #include <iosfwd>
 #include <cstdio>
+#include <memory>
 
 namespace scone
 {
@@ -29,4 +30,23 @@ namespace scone
 
 	void SCONE_API ReadStorageSto( Storage< Real, TimeInSeconds >& storage, const xo::path& file );
 	void SCONE_API ReadStorageSto( Storage< Real, TimeInSeconds >& storage, xo::char_stream& str );
+
+	/// Binary storage file extension
+	constexpr const char* StorageBinExtension = "stob";
+
+	/// Write storage in binary format: a header with name, labels and frame times, followed by the values of each channel.
+	void SCONE_API WriteStorageBin( const Storage< Real, TimeInSeconds >& storage, const xo::path& file, const String& name );
+
+	/// Read storage in binary format; the file is memory mapped and channel values are only read when accessed.
+	void SCONE_API ReadStorageBin( Storage< Real, TimeInSeconds >& storage, const xo::path& file );
+
+	/// Write or read storage in .sto or binary format, depending on the file extension.
+	void SCONE_API WriteStorage( const Storage< Real, TimeInSeconds >& storage, const xo::path& file, const String& name );
+	void SCONE_API ReadStorage( Storage< Real, TimeInSeconds >& storage, const xo::path& file );
+
+	using StorageCSP = std::shared_ptr< const Storage< Real, TimeInSeconds > >;
+
+	/// Read storage through a process-wide cache of read-only storages, keyed by file name and modification time.
+	/// Storages are only kept in the cache while they are in use.
+	SCONE_API StorageCSP ReadStorageCached( const xo::path& file );
 }
@@ -0,0 +1,53 @@
+/*
+** kernels.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "types.h"
+
+namespace scone
+{
+	// Numerical kernels that operate on contiguous arrays.
+	// These are written as simple loops without dependencies between iterations, so that they are vectorized by the compiler.
+
+	/// Copy src[ indices[ i ] ] to dst[ i ] for i < n.
+	inline void GatherKernel( const Real* src, const index_t* indices, Real* dst, size_t n )
+	{
+		for ( index_t i = 0; i < n; ++i )
+			dst[ i ] = src[ indices[ i ] ];
+	}
+
+	/// Sum of n values, using four partial sums so the additions are not serialized on a single accumulator.
+	inline Real SumKernel( const Real* values, size_t n )
+	{
+		Real s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		index_t i = 0;
+		for ( ; i + 4 <= n; i += 4 )
+		{
+			s0 += values[ i ];
+			s1 += values[ i + 1 ];
+			s2 += values[ i + 2 ];
+			s3 += values[ i + 3 ];
+		}
+		for ( ; i < n; ++i )
+			s0 += values[ i ];
+		return ( s0 + s1 ) + ( s2 + s3 );
+	}
+
+	/// Squared difference between values and reference values that are interpolated between ref0 and ref1 using weight.
+	/// The error of each element is stored in errors; returns the sum of all errors.
+	inline Real SquaredErrorKernel( const Real* values, const Real* ref0, const Real* ref1, Real weight, Real* errors, size_t n )
+	{
+		for ( index_t i = 0; i < n; ++i )
+		{
+			auto d = values[ i ] - ( ref0[ i ] + weight * ( ref1[ i ] - ref0[ i ] ) );
+			errors[ i ] = d * d;
+		}
+		return SumKernel( errors, n );
+	}
+}
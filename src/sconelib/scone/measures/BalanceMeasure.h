@@ -26,6 +26,7 @@ namespace scone
 
 	protected:
 		virtual String GetClassSignature() const override;
+		SCONE_INTERNAL_STATE( m_InitialHeight )
 
 	private:
 		double m_InitialHeight;
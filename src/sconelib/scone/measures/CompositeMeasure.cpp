@@ -13,6 +13,7 @@
 #include "scone/core/Log.h"
 #include "xo/container/container_tools.h"
 #include "scone/core/string_tools.h"
+#include "xo/numerical/constants.h"
 
 namespace scone
 {
@@ -59,6 +60,20 @@ namespace scone
 		return terminate ? true : false;
 	}
 
+	double CompositeMeasure::GetResultBound( const Model& model ) const
+	{
+		// only bounded if all child measures are
+		double total = 0.0;
+		for ( const MeasureUP& m : m_Measures )
+		{
+			auto bound = m->GetWeightedResultBound( model );
+			if ( bound == xo::constants<double>::lowest() )
+				return bound;
+			total += bound;
+		}
+		return total;
+	}
+
 	double CompositeMeasure::ComputeResult( const Model& model )
 	{
 		double total = 0.0;
@@ -105,4 +120,20 @@ namespace scone
 		}
 		return xo::concatenate_str( strset, "" );
 	}
+
+	std::any CompositeMeasure::GetInternalState() const
+	{
+		std::vector< ControllerCheckpoint > states;
+		for ( auto& m : m_Measures )
+			states.push_back( m->GetCheckpoint() );
+		return states;
+	}
+
+	void CompositeMeasure::SetInternalState( const std::any& state )
+	{
+		auto& states = std::any_cast< const std::vector< ControllerCheckpoint >& >( state );
+		SCONE_ERROR_IF( states.size() != m_Measures.size(), "Checkpoint does not match the number of child measures of " + GetName() );
+		for ( index_t i = 0; i < m_Measures.size(); ++i )
+			m_Measures[ i ]->RestoreCheckpoint( states[ i ] );
+	}
 }
@@ -57,6 +57,7 @@ namespace scone
 
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		virtual double ComputeResult( const Model& model ) override;
+		virtual double GetResultBound( const Model& model ) const override;
 
 		const PropNode* Measures;
 
@@ -67,6 +68,8 @@ namespace scone
 
 	protected:
 		virtual String GetClassSignature() const override;
+		virtual std::any GetInternalState() const override;
+		virtual void SetInternalState( const std::any& state ) override;
 
 	private:
 		std::vector< MeasureUP > m_Measures;
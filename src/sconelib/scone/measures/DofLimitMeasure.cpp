@@ -108,4 +108,20 @@ namespace scone
 		for ( auto& l : m_Limits )
 			frame[ l.dof.GetName() + ".limit_penalty" ] = l.penalty.GetLatest();
 	}
+
+	std::any DofLimitMeasure::GetInternalState() const
+	{
+		std::vector< Statistic<> > penalties;
+		for ( auto& l : m_Limits )
+			penalties.push_back( l.penalty );
+		return penalties;
+	}
+
+	void DofLimitMeasure::SetInternalState( const std::any& state )
+	{
+		auto& penalties = std::any_cast< const std::vector< Statistic<> >& >( state );
+		SCONE_ERROR_IF( penalties.size() != m_Limits.size(), "Checkpoint does not match the limits of " + GetName() );
+		for ( index_t i = 0; i < m_Limits.size(); ++i )
+			m_Limits[ i ].penalty = penalties[ i ];
+	}
 }
@@ -31,6 +31,8 @@ namespace scone
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
+		virtual std::any GetInternalState() const override;
+		virtual void SetInternalState( const std::any& state ) override;
 
 		// min_deg - Minimum DoF value in degrees
 		// max_deg - Minimum DoF value in degrees
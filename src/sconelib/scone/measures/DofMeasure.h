@@ -53,6 +53,7 @@ namespace scone
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_INTERNAL_STATE( position.GetStatistic(), velocity.GetStatistic(), acceleration.GetStatistic(), force.GetStatistic() )
 
 	private:
 		int range_count;
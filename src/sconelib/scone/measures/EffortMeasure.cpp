@@ -11,9 +11,12 @@
 #include "scone/model/Muscle.h"
 #include "scone/core/profiler_config.h"
 #include "scone/core/math.h"
+#include "scone/core/kernels.h"
 #include "xo/string/pattern_matcher.h"
 #include "xo/numerical/math.h"
 
+#include <algorithm>
+
 namespace scone
 {
 	StringMap< EffortMeasure::EnergyMeasureType > EffortMeasure::m_MeasureNames = StringMap< EffortMeasure::EnergyMeasureType >(
@@ -48,6 +51,17 @@ namespace scone
 		m_AerobicFactor = 1.5; // 1.5 is for aerobic conditions, 1.0 for anaerobic. may need to add as option later
 		m_InitComPos = model.GetComPos();
 		SetSlowTwitchRatios( props, model );
+
+		// per-muscle constants
+		for ( const auto& mus : model.GetMuscles() )
+		{
+			m_MuscleMass.push_back( mus->GetMass( specific_tension, muscle_density ) );
+			m_OptimalFiberLength.push_back( mus->GetOptimalFiberLength() );
+			m_PCSA.push_back( mus->GetPCSA() );
+			m_AlphaShorteningFastTwitch.push_back( 153 / mus->GetMaxContractionVelocity() );
+			m_AlphaShorteningSlowTwitch.push_back( 100 / ( mus->GetMaxContractionVelocity() / 2.5 ) );
+		}
+		m_MuscleEffort.resize( model.GetMuscles().size() );
 	}
 
 	EffortMeasure::MuscleProperties::MuscleProperties( const PropNode& props ) :
@@ -96,6 +110,24 @@ namespace scone
 		return *result;
 	}
 
+	double EffortMeasure::GetResultBound( const Model& model ) const
+	{
+		// metabolic measures can have negative contributions, so their total is not bounded
+		if ( measure_type == Wang2012 || measure_type == Uchida2016 )
+			return Measure::GetResultBound( model );
+
+		// cost of transport can always be reduced by covering more distance
+		auto duration = model.GetSimulationEndTime() - m_Effort.GetStartTime();
+		if ( use_cost_of_transport || m_Effort.GetNumSamples() == 0 || duration <= 0 )
+			return 0.0;
+
+		// the effort accumulated so far, averaged over the full simulation
+		auto bound = m_Effort.GetTotal() / duration;
+		if ( use_average_per_muscle && !model.GetMuscles().empty() )
+			bound /= model.GetMuscles().size();
+		return bound;
+	}
+
 	double EffortMeasure::GetCurrentEffort( const Model& model ) const
 	{
 		switch ( measure_type )
@@ -114,126 +146,108 @@ namespace scone
 
 	double EffortMeasure::GetTotalForce( const Model& model ) const
 	{
-		double f = 1.0; // base muscle force
-		for ( const MuscleUP& mus : model.GetMuscles() )
-			f += mus->GetForce();
-		return f;
+		const auto& ms = model.GetMuscleStateSnapshot( MuscleStateSnapshot::Force );
+		return 1.0 + SumKernel( ms.force.data(), ms.size() ); // 1.0 is the base muscle force
 	}
 
 	double EffortMeasure::GetWang2012( const Model& model ) const
 	{
-		double e = m_Wang2012BasalEnergy;
-		for ( index_t i = 0; i < model.GetMuscles().size(); ++i )
+		using F = MuscleStateSnapshot::Field;
+		const auto& ms = model.GetMuscleStateSnapshot( F::Excitation | F::Activation | F::FiberLength | F::FiberVelocity | F::Force | F::ActiveFiberForce );
+		const auto n = ms.size();
+		const Real* exc = ms.excitation.data();
+		const Real* act = ms.activation.data();
+		const Real* fl = ms.fiber_length.data();
+		const Real* fv = ms.fiber_velocity.data();
+		const Real* force = ms.force.data();
+		const Real* aff = ms.active_fiber_force.data();
+		const Real* mass = m_MuscleMass.data();
+		const Real* ofl = m_OptimalFiberLength.data();
+		const Real* str = m_SlowTwitchFiberRatios.data();
+		Real* effort = m_MuscleEffort.data();
+
+		for ( index_t i = 0; i < n; ++i )
 		{
-			const MuscleUP& mus = model.GetMuscles()[ i ];
-			double mass = mus->GetMass( specific_tension, muscle_density );
-			Real l = m_SlowTwitchFiberRatios[ i ];
-			Real fa = 40 * l * sin( REAL_HALF_PI * mus->GetExcitation() ) + 133 * ( 1 - l ) * ( 1 - cos( REAL_HALF_PI * mus->GetExcitation() ) );
-			Real fm = 74 * l * sin( REAL_HALF_PI * mus->GetActivation() ) + 111 * ( 1 - l ) * ( 1 - cos( REAL_HALF_PI * mus->GetActivation() ) );
-			Real l_ce_norm = mus->GetFiberLength() / mus->GetOptimalFiberLength();
-			Real v_ce = mus->GetFiberVelocity();
-			Real g = 0.0;
-			if ( l_ce_norm < 0.5 )
-				g = 0.5;
-			else if ( l_ce_norm < 1.0 )
-				g = l_ce_norm;
-			else if ( l_ce_norm < 1.5 )
-				g = -2 * l_ce_norm + 3;
-
-			Real effort_a = mass * fa;
-			Real effort_m = mass * g * fm;
-			Real effort_s = xo::max( 0.0, 0.25 * mus->GetForce() * -v_ce );
-			Real effort_w = xo::max( 0.0, mus->GetActiveFiberForce() * -v_ce );
-			Real effort = effort_a + effort_m + effort_s + effort_w;
-
-			e += effort;
+			Real l = str[ i ];
+			Real fa = 40 * l * sin( REAL_HALF_PI * exc[ i ] ) + 133 * ( 1 - l ) * ( 1 - cos( REAL_HALF_PI * exc[ i ] ) );
+			Real fm = 74 * l * sin( REAL_HALF_PI * act[ i ] ) + 111 * ( 1 - l ) * ( 1 - cos( REAL_HALF_PI * act[ i ] ) );
+			Real l_ce_norm = fl[ i ] / ofl[ i ];
+			Real v_ce = fv[ i ];
+			Real g = l_ce_norm < 0.5 ? 0.5 : ( l_ce_norm < 1.0 ? l_ce_norm : ( l_ce_norm < 1.5 ? -2 * l_ce_norm + 3 : 0.0 ) );
+
+			Real effort_a = mass[ i ] * fa;
+			Real effort_m = mass[ i ] * g * fm;
+			Real effort_s = std::max( 0.0, 0.25 * force[ i ] * -v_ce );
+			Real effort_w = std::max( 0.0, aff[ i ] * -v_ce );
+			effort[ i ] = effort_a + effort_m + effort_s + effort_w;
 		}
 
-		return e;
+		return m_Wang2012BasalEnergy + SumKernel( effort, n );
 	}
 
 	// Implementation of Umberger (2003, 2010) metabolics model 
 	// with updates from Uchida 2016.
 	double EffortMeasure::GetUchida2016( const Model& model ) const
 	{
-		double e = m_Uchida2016BasalEnergy;
-		for ( index_t i = 0; i < model.GetMuscles().size(); ++i )
+		using F = MuscleStateSnapshot::Field;
+		const auto& ms = model.GetMuscleStateSnapshot( F::Excitation | F::Activation | F::NormalizedFiberLength | F::FiberVelocity | F::ActiveFiberForce | F::ActiveForceLengthMultiplier );
+		const auto n = ms.size();
+		const Real* exc = ms.excitation.data();
+		const Real* act = ms.activation.data();
+		const Real* nfl = ms.normalized_fiber_length.data();
+		const Real* fv = ms.fiber_velocity.data();
+		const Real* aff = ms.active_fiber_force.data();
+		const Real* afl = ms.active_force_length_multiplier.data();
+		const Real* mass = m_MuscleMass.data();
+		const Real* ofl = m_OptimalFiberLength.data();
+		const Real* str = m_SlowTwitchFiberRatios.data();
+		const Real* alpha_fast = m_AlphaShorteningFastTwitch.data();
+		const Real* alpha_slow = m_AlphaShorteningSlowTwitch.data();
+		Real* effort = m_MuscleEffort.data();
+
+		// branches are written as selections, so that the loop can be vectorized
+		for ( index_t i = 0; i < n; ++i )
 		{
-			const MuscleUP& mus = model.GetMuscles()[ i ];
-			double mass = mus->GetMass( specific_tension, muscle_density );
-
 			// calculate A parameter
-			Real excitation = mus->GetExcitation();
-			Real activation = mus->GetActivation();
-			double A;
-			if ( excitation > activation )
-				A = excitation;
-			else
-				A = ( excitation + activation ) / 2;
+			Real excitation = exc[ i ];
+			double A = excitation > act[ i ] ? excitation : ( excitation + act[ i ] ) / 2;
 
 			// calculate slowTwitchRatio factor
-			Real slowTwitchRatio = m_SlowTwitchFiberRatios[ i ];
-			double uSlow = slowTwitchRatio * sin( REAL_HALF_PI * excitation );
-			double uFast = ( 1 - slowTwitchRatio ) * ( 1 - cos( REAL_HALF_PI * excitation ) );
-			slowTwitchRatio = ( excitation == 0 ) ? 1.0 : uSlow / ( uSlow + uFast );
+			double uSlow = str[ i ] * sin( REAL_HALF_PI * excitation );
+			double uFast = ( 1 - str[ i ] ) * ( 1 - cos( REAL_HALF_PI * excitation ) );
+			double slowTwitchRatio = ( excitation == 0 ) ? 1.0 : uSlow / ( uSlow + uFast );
 
 			// calculate AMdot
-			double AMdot;
+			bool lengthened = nfl[ i ] > 1.0;
 			double unscaledAMdot = 128 * ( 1 - slowTwitchRatio ) + 25;
-			double F_iso = mus->GetActiveForceLengthMultipler();
-			if ( mus->GetNormalizedFiberLength() <= 1.0 )
-				AMdot = m_AerobicFactor * std::pow( A, 0.6 ) * unscaledAMdot;
-			else
-				AMdot = m_AerobicFactor * std::pow( A, 0.6 ) * ( ( 0.4 * unscaledAMdot ) + ( 0.6 * unscaledAMdot * F_iso ) );
+			double F_iso = afl[ i ];
+			double AMdot = m_AerobicFactor * std::pow( A, 0.6 ) * ( lengthened ? ( 0.4 * unscaledAMdot ) + ( 0.6 * unscaledAMdot * F_iso ) : unscaledAMdot );
 
 			// calculate shortening heat rate
-			double Sdot;
-			double Vmax_fasttwitch = mus->GetMaxContractionVelocity();
-			double Vmax_slowtwitch = mus->GetMaxContractionVelocity() / 2.5;
-			double alpha_shortening_fasttwitch = 153 / Vmax_fasttwitch;
-			double alpha_shortening_slowtwitch = 100 / Vmax_slowtwitch;
-			double fiber_velocity_normalized = mus->GetFiberVelocity() / mus->GetOptimalFiberLength();
-			double unscaledSdot, tmp_slowTwitch, tmp_fastTwitch;
-
-			if ( fiber_velocity_normalized <= 0 )
-			{
-				double maxShorteningRate = 100.0; // (W/kg)
-				tmp_slowTwitch = -alpha_shortening_slowtwitch * fiber_velocity_normalized;
-				if ( tmp_slowTwitch > maxShorteningRate ) tmp_slowTwitch = maxShorteningRate;
-
-				tmp_fastTwitch = alpha_shortening_fasttwitch * fiber_velocity_normalized * ( 1 - slowTwitchRatio );
-				unscaledSdot = ( tmp_slowTwitch * slowTwitchRatio ) - tmp_fastTwitch;
-				Sdot = m_AerobicFactor * A * A * unscaledSdot;
-			}
-			else
-			{
-				unscaledSdot = 4.0 * alpha_shortening_slowtwitch * fiber_velocity_normalized;
-				Sdot = m_AerobicFactor * A * unscaledSdot;
-			}
-
-			if ( mus->GetNormalizedFiberLength() > 1.0 ) Sdot *= F_iso;
-
-			double active_fiber_force = mus->GetActiveFiberForce();
-			if ( active_fiber_force < 0 ) active_fiber_force = 0;
+			const double maxShorteningRate = 100.0; // (W/kg)
+			double fiber_velocity_normalized = fv[ i ] / ofl[ i ];
+			double tmp_slowTwitch = std::min( -alpha_slow[ i ] * fiber_velocity_normalized, maxShorteningRate );
+			double tmp_fastTwitch = alpha_fast[ i ] * fiber_velocity_normalized * ( 1 - slowTwitchRatio );
+			double Sdot = fiber_velocity_normalized <= 0 ?
+				m_AerobicFactor * A * A * ( ( tmp_slowTwitch * slowTwitchRatio ) - tmp_fastTwitch ) :
+				m_AerobicFactor * A * ( 4.0 * alpha_slow[ i ] * fiber_velocity_normalized );
+			Sdot = lengthened ? Sdot * F_iso : Sdot;
 
 			// calculate mechanical work rate
-			double Wdot =
-				-active_fiber_force * mus->GetFiberVelocity() / mass;
+			double Wdot = -std::max( aff[ i ], 0.0 ) * fv[ i ] / mass[ i ];
 
 			// prevent instantaneous negative power by accounting for it through Sdot
 			double Edot_Wkg_beforeClamp = AMdot + Sdot + Wdot;
-			if ( Edot_Wkg_beforeClamp < 0 ) Sdot -= Edot_Wkg_beforeClamp;
+			Sdot = Edot_Wkg_beforeClamp < 0 ? Sdot - Edot_Wkg_beforeClamp : Sdot;
 
 			// total heat rate cannot fall below 1.0 W/kg
-			double totalHeatRate = AMdot + Sdot;
-			if ( totalHeatRate < 1.0 ) totalHeatRate = 1.0;
+			double totalHeatRate = std::max( AMdot + Sdot, 1.0 );
 
 			// total metabolic rate for this muscle
-			double Edot = ( totalHeatRate + Wdot ) * mass;
-
-			e += Edot;
+			effort[ i ] = ( totalHeatRate + Wdot ) * mass[ i ];
 		}
-		return e;
+
+		return m_Uchida2016BasalEnergy + SumKernel( effort, n );
 	}
 
 	void EffortMeasure::SetSlowTwitchRatios( const PropNode& props, const Model& model )
@@ -271,34 +285,34 @@ namespace scone
 
 	double EffortMeasure::GetSquaredMuscleStress( const Model& model ) const
 	{
-		double sum = 0.0;
-		for ( auto& m : model.GetMuscles() )
-			sum += xo::squared( m->GetForce() / m->GetPCSA() );
-		return sum;
+		const auto& ms = model.GetMuscleStateSnapshot( MuscleStateSnapshot::Force );
+		for ( index_t i = 0; i < ms.size(); ++i )
+			m_MuscleEffort[ i ] = xo::squared( ms.force[ i ] / m_PCSA[ i ] );
+		return SumKernel( m_MuscleEffort.data(), ms.size() );
 	}
 
 	double EffortMeasure::GetCubedMuscleStress( const Model& model ) const
 	{
-		double sum = 0.0;
-		for ( auto& m : model.GetMuscles() )
-			sum += xo::cubed( m->GetForce() / m->GetPCSA() );
-		return sum;
+		const auto& ms = model.GetMuscleStateSnapshot( MuscleStateSnapshot::Force );
+		for ( index_t i = 0; i < ms.size(); ++i )
+			m_MuscleEffort[ i ] = xo::cubed( ms.force[ i ] / m_PCSA[ i ] );
+		return SumKernel( m_MuscleEffort.data(), ms.size() );
 	}
 
 	double EffortMeasure::GetSquaredMuscleActivation( const Model& model ) const
 	{
-		double sum = 0.0;
-		for ( auto& m : model.GetMuscles() )
-			sum += xo::squared( m->GetActivation() );
-		return sum;
+		const auto& ms = model.GetMuscleStateSnapshot( MuscleStateSnapshot::Activation );
+		for ( index_t i = 0; i < ms.size(); ++i )
+			m_MuscleEffort[ i ] = xo::squared( ms.activation[ i ] );
+		return SumKernel( m_MuscleEffort.data(), ms.size() );
 	}
 
 	double EffortMeasure::GetCubedMuscleActivation( const Model& model ) const
 	{
-		double sum = 0.0;
-		for ( auto& m : model.GetMuscles() )
-			sum += xo::cubed( m->GetActivation() );
-		return sum;
+		const auto& ms = model.GetMuscleStateSnapshot( MuscleStateSnapshot::Activation );
+		for ( index_t i = 0; i < ms.size(); ++i )
+			m_MuscleEffort[ i ] = xo::cubed( ms.activation[ i ] );
+		return SumKernel( m_MuscleEffort.data(), ms.size() );
 	}
 
 	String EffortMeasure::GetClassSignature() const
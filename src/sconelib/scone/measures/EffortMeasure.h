@@ -71,10 +71,12 @@ namespace scone
 
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		virtual double ComputeResult( const Model& model ) override;
+		virtual double GetResultBound( const Model& model ) const override;
 
 	protected:
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_INTERNAL_STATE( m_Effort, m_InitComPos )
 
 	private:
 		Real m_Wang2012BasalEnergy;
@@ -85,6 +87,14 @@ namespace scone
 		Vec3 m_InitComPos;
 		PropNode m_Report;
 		std::vector< Real > m_SlowTwitchFiberRatios;
+
+		// per-muscle constants, computed at construction
+		std::vector< Real > m_MuscleMass;
+		std::vector< Real > m_OptimalFiberLength;
+		std::vector< Real > m_PCSA;
+		std::vector< Real > m_AlphaShorteningFastTwitch;
+		std::vector< Real > m_AlphaShorteningSlowTwitch;
+		mutable std::vector< Real > m_MuscleEffort; // effort of each muscle in the current step
 		struct MuscleProperties {
 			MuscleProperties( const PropNode& props );
 			String muscle;
@@ -27,6 +27,7 @@ namespace scone
 
 	protected:
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override { return false; }
+		SCONE_INTERNAL_STATE( m_InitState )
 
 	private:
 		Real GetStateSimilarity( const State& state );
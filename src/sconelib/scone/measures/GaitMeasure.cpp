@@ -19,7 +19,8 @@
 namespace scone
 {
 	GaitMeasure::GaitMeasure( const PropNode& props, Params& par, const Model& model, const Location& loc ) :
-	Measure( props, par, model, loc )
+	Measure( props, par, model, loc ),
+	steps_( &model.GetArena() )
 	{
 		INIT_PROP( props, termination_height, 0.5 );
 		INIT_PROP( props, min_velocity, 0 );
@@ -12,6 +12,8 @@
 #include "EffortMeasure.h"
 #include "DofLimitMeasure.h"
 
+#include <memory_resource>
+
 namespace scone
 {
 	/// Measure for locomotion at a predefined speed, defined by the parameters ''min_velocity'' and (optionally) ''max_velocity''.
@@ -56,17 +58,19 @@ namespace scone
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		void AddStep( const Model &model, double timestamp );
 		virtual double ComputeResult( const Model& model ) override;
+		virtual double GetResultBound( const Model& model ) const override { return 0.0; }
 		virtual void StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const override;
 
 	protected:
 		virtual String GetClassSignature() const override;
+		SCONE_INTERNAL_STATE( steps_, m_PrevContactState, m_InitialComPos, m_InitGaitDist, m_PrevGaitDist )
 
 	private:
 		struct Step {
 			TimeInSeconds time;
 			Real length;
 		};
-		std::vector< Step > steps_;
+		std::pmr::vector< Step > steps_; // allocated from the model arena
 
 		std::vector< const Body* > m_BaseBodies;
 		Real GetGaitDist( const Model &model );
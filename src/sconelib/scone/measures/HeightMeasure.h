@@ -41,6 +41,7 @@ namespace scone
 
 	protected:
 		virtual String GetClassSignature() const override;
+		SCONE_INTERNAL_STATE( m_JumpState, m_Height, m_Upward, m_InitialHeight )
 
 	private:
 		Body* m_pTargetBody; // non-owning pointer
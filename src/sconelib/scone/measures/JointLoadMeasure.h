@@ -28,6 +28,7 @@ namespace scone
 	protected:
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_INTERNAL_STATE( GetStatistic(), joint_load )
 
 	private:
 		enum Method { NoMethod, JointReactionForce };
@@ -49,6 +49,7 @@ namespace scone
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_INTERNAL_STATE( state, init_com, current_pos, init_min_x, prepare_com, peak_com, peak_com_vel, peak_height, recover_com, recover_start_time, recover_cop_dist )
 
 	private:
 		enum State { Prepare, Takeoff, Flight, Landing, Recover };
@@ -34,15 +34,37 @@ namespace scone
 		if ( !result )
 			result = ComputeResult( model );
 
-		Real m = *result + GetOffset();
-		if ( minimize && GetThreshold() != 0 )
+		return GetWeightedValue( *result );
+	}
+
+	double Measure::GetResultBound( const Model& model ) const
+	{
+		return xo::constants<double>::lowest();
+	}
+
+	double Measure::GetWeightedResultBound( const Model& model ) const
+	{
+		if ( result )
+			return GetWeightedValue( *result );
+
+		// the weighted result only increases with the result for positive weights and thresholds
+		auto bound = GetResultBound( model );
+		if ( bound == xo::constants<double>::lowest() || !minimize || weight < 0 || threshold < 0 )
+			return xo::constants<double>::lowest();
+		else return GetWeightedValue( bound );
+	}
+
+	double Measure::GetWeightedValue( double value ) const
+	{
+		Real m = value + result_offset;
+		if ( minimize && threshold != 0 )
 		{
-			if ( m < GetThreshold() )
+			if ( m < threshold )
 				m = 0;
-			else if ( m < GetThreshold() + threshold_transition )
-				m = m * ( m - GetThreshold() ) / threshold_transition;
+			else if ( m < threshold + threshold_transition )
+				m = m * ( m - threshold ) / threshold_transition;
 		}
-		return GetWeight() * m;
+		return weight * m;
 	}
 
 	const String& Measure::GetName() const
@@ -41,6 +41,11 @@ namespace scone
 		double GetResult( const Model& model );
 		double GetWeightedResult( const Model& model );
 
+		/// Lower bound on the final result of a minimized measure, based on the simulation so far.
+		/// Returns the lowest possible value if no bound is known.
+		virtual double GetResultBound( const Model& model ) const;
+		double GetWeightedResultBound( const Model& model ) const;
+
 		PropNode& GetReport() { return report; }
 		const PropNode& GetReport() const { return report; }
 	
@@ -56,6 +61,7 @@ namespace scone
 		virtual bool PerformAnalysis( const Model& model, double timestamp ) override final;
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) = 0;
 		double WorstResult() const;
+		double GetWeightedValue( double value ) const;
 
 		PropNode report;
 		xo::optional< double > result; // caches result so it's only computed once
@@ -13,9 +13,63 @@
 #include "xo/numerical/math.h"
 #include "scone/core/Log.h"
 #include "scone/core/profiler_config.h"
+#include "scone/core/kernels.h"
+#include "xo/string/string_tools.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
 
 namespace scone
 {
+	namespace
+	{
+		// references are only kept in the cache while they are in use
+		std::mutex g_reference_mutex;
+		std::map< String, std::weak_ptr< const MimicReference > > g_reference_cache;
+
+		// get the reference values of channels, sampled at fixed steps (if step > 0) or at the frames of storage
+		std::shared_ptr< const MimicReference > GetMimicReference( const path& file, const StorageCSP& storage,
+			const std::vector< index_t >& channels, TimeInSeconds time_offset, TimeInSeconds step )
+		{
+			auto key = xo::stringf( "%s %.17g %.17g", file.c_str(), time_offset, step );
+			for ( auto c : channels )
+				key += " " + xo::to_str( c );
+
+			std::scoped_lock lock( g_reference_mutex );
+			for ( auto it = g_reference_cache.begin(); it != g_reference_cache.end(); )
+				it = it->second.expired() ? g_reference_cache.erase( it ) : std::next( it );
+
+			// the storage differs if the file has been modified
+			auto& entry = g_reference_cache[ key ];
+			auto ref = entry.lock();
+			if ( !ref || ref->storage != storage )
+			{
+				auto r = std::make_shared< MimicReference >();
+				r->storage = storage;
+				r->step = step;
+				auto add_frame = [&]( TimeInSeconds t ) {
+					auto frame = storage->ComputeInterpolatedFrame( t + time_offset );
+					r->times.push_back( t );
+					for ( auto c : channels )
+						r->values.push_back( frame.value( c ) );
+				};
+				if ( step > 0 )
+				{
+					auto duration = storage->GetTimes().back() - time_offset;
+					auto frames = duration > 0 ? size_t( std::ceil( duration / step - 1e-6 ) ) + 1 : 1;
+					for ( index_t k = 0; k < frames; ++k )
+						add_frame( k * step );
+				}
+				else for ( auto t : storage->GetTimes() )
+					add_frame( t - time_offset );
+				ref = std::move( r );
+				entry = ref;
+			}
+			return ref;
+		}
+	}
+
 	MimicMeasure::MimicMeasure( const PropNode& pn, Params& par, const Model& model, const Location& loc ) :
 		Measure( pn, par, model, loc ),
 		file( FindFile( pn.get<path>( "file" ) ) ),
@@ -24,10 +78,11 @@ namespace scone
 		INIT_MEMBER( pn, use_best_match, false ),
 		INIT_MEMBER( pn, average_error_limit, 0 ),
 		INIT_MEMBER( pn, peak_error_limit, 2 * average_error_limit ),
-		INIT_MEMBER( pn, time_offset, 0 )
+		INIT_MEMBER( pn, time_offset, 0 ),
+		frame_cursor_( 0 )
 	{
 		SCONE_PROFILE_FUNCTION( model.GetProfiler() );
-		ReadStorageSto( storage_, file );
+		storage_ = ReadStorageCached( file );
 
 		auto& s = model.GetState();
 		for ( index_t state_idx = 0; state_idx < s.GetSize(); ++state_idx )
@@ -35,18 +90,26 @@ namespace scone
 			auto& name = s.GetName( state_idx );
 			if ( include_states( name ) && !exclude_states( name ) )
 			{
-				index_t sto_idx = storage_.GetChannelIndex( name );
+				index_t sto_idx = storage_->GetChannelIndex( name );
 				if ( sto_idx != NoIndex )
 				{
-					state_storage_map_.emplace_back( state_idx, sto_idx );
-					channel_errors_.emplace_back( name, 0.0 );
+					state_indices_.push_back( state_idx );
+					storage_indices_.push_back( sto_idx );
+					channel_names_.push_back( name );
 				}
 			}
 		}
 
-		log::debug( "MimicMeasure found ", state_storage_map_.size(), " of ", storage_.GetChannelCount(), " channels from ", file );
+		log::debug( "MimicMeasure found ", state_indices_.size(), " of ", storage_->GetChannelCount(), " channels from ", file );
+
+		SCONE_THROW_IF( state_indices_.empty(), "No matching states found in " + file.str() );
 
-		SCONE_THROW_IF( state_storage_map_.empty(), "No matching states found in " + file.str() );
+		// gather the tracked channels, at the measure step size if it is fixed
+		auto step = model.use_fixed_control_step_size ? model.fixed_measure_step_size : 0.0;
+		reference_ = GetMimicReference( file, storage_, storage_indices_, time_offset, step );
+		state_values_.resize( state_indices_.size() );
+		interpolated_values_.resize( state_indices_.size() );
+		channel_errors_.resize( state_indices_.size() );
 
 		model.AddExternalResource( file );
 	}
@@ -55,20 +118,15 @@ namespace scone
 	{
 		// when using a full motion, skip when there's no more data
 		// we don't terminate because there may be other measures
-		if ( !use_best_match && timestamp > storage_.Back().GetTime() )
+		if ( !use_best_match && timestamp > storage_->GetTimes().back() )
 			return false;
 
-		auto& s = model.GetState();
-		double error = 0.0;
-		index_t error_idx = 0;
-		for ( auto& m : state_storage_map_ )
-		{
-			auto e = xo::squared( s[ m.first ] - storage_.GetInterpolatedValue( timestamp + time_offset, m.second ) );
-			channel_errors_[ error_idx++ ].second = e;
-			error += e;
-		}
-
-		error /= state_storage_map_.size();
+		auto n = state_indices_.size();
+		GatherKernel( model.GetState().GetValues().data(), state_indices_.data(), state_values_.data(), n );
+		auto [frame, weight] = GetReferenceFrame( timestamp );
+		auto* ref0 = frame != NoIndex ? reference_->values.data() + frame * n : GetInterpolatedReference( timestamp );
+		auto* ref1 = weight > 0 ? ref0 + n : ref0;
+		double error = SquaredErrorKernel( state_values_.data(), ref0, ref1, weight, channel_errors_.data(), n ) / n;
 		result_.AddSample( timestamp, error );
 
 		if ( ( average_error_limit != 0 && result_.GetAverage() > average_error_limit ) ||
@@ -78,6 +136,45 @@ namespace scone
 		return false;
 	}
 
+	std::pair< index_t, Real > MimicMeasure::GetReferenceFrame( TimeInSeconds time )
+	{
+		// returns the frame before time, and the interpolation weight of the next frame
+		// returns NoIndex if time is between the frames of a fixed step reference
+		const auto& times = reference_->times;
+		auto last = times.size() - 1;
+		if ( reference_->step > 0 )
+		{
+			// equidistant frames: direct lookup
+			auto f = std::max( 0.0, time / reference_->step );
+			auto k = std::round( f );
+			if ( std::abs( f - k ) < 1e-6 )
+				return { std::min( index_t( k ), last ), 0.0 };
+			if ( index_t( f ) < last )
+				return { NoIndex, 0.0 };
+			else return { last, 0.0 };
+		}
+		else
+		{
+			// frames from storage: move from the previous frame, time usually increases by a small step
+			while ( frame_cursor_ < last && times[ frame_cursor_ + 1 ] <= time )
+				++frame_cursor_;
+			while ( frame_cursor_ > 0 && times[ frame_cursor_ ] > time )
+				--frame_cursor_;
+			if ( frame_cursor_ == last || time <= times[ frame_cursor_ ] )
+				return { frame_cursor_, 0.0 };
+			else return { frame_cursor_, ( time - times[ frame_cursor_ ] ) / ( times[ frame_cursor_ + 1 ] - times[ frame_cursor_ ] ) };
+		}
+	}
+
+	const Real* MimicMeasure::GetInterpolatedReference( TimeInSeconds time )
+	{
+		// interpolate the frames of the original storage, not those of the fixed step reference
+		auto frame = storage_->ComputeInterpolatedFrame( time + time_offset );
+		for ( index_t i = 0; i < storage_indices_.size(); ++i )
+			interpolated_values_[ i ] = frame.value( storage_indices_[ i ] );
+		return interpolated_values_.data();
+	}
+
 	double MimicMeasure::ComputeResult( const Model& model )
 	{
 		auto result = use_best_match ? result_.GetLowest() : result_.GetAverage();
@@ -93,8 +190,8 @@ namespace scone
 		frame[ "mimic_error" ] = result_.GetLatest();
 		if ( flags.get<StoreDataTypes::DebugData>() )
 		{
-			for ( auto& c : channel_errors_ )
-				frame[ c.first + "_mimic_error" ] = c.second;
+			for ( index_t i = 0; i < channel_names_.size(); ++i )
+				frame[ channel_names_[ i ] + "_mimic_error" ] = channel_errors_[ i ];
 		}
 	}
 
@@ -10,10 +10,20 @@
 
 #include "Measure.h"
 #include "scone/core/Statistic.h"
+#include "scone/core/StorageIo.h"
 #include "xo/string/pattern_matcher.h"
 
 namespace scone
 {
+	/// Tracked channels of a reference motion, stored frame by frame; shared between MimicMeasure instances.
+	struct MimicReference
+	{
+		StorageCSP storage; // keeps the source storage alive
+		TimeInSeconds step = 0; // fixed interval between frames, or zero when using the frames of storage
+		std::vector< TimeInSeconds > times; // measure time of each frame
+		std::vector< Real > values; // frame-major values of all tracked channels
+	};
+
 	/// Measure for how well a simulation mimics data from predefined motion file.
 	/// This measure only considers variable that are part of the actual state of the model,
 	/// which includes the DOFs, DOF velocities, muscle activation (*.activation), and muscle fiber length (*.fiber_length)
@@ -50,10 +60,19 @@ namespace scone
 
 	protected:
 		virtual String GetClassSignature() const override;
-		Storage<> storage_;
+		SCONE_INTERNAL_STATE( result_, frame_cursor_ )
+		std::pair< index_t, Real > GetReferenceFrame( TimeInSeconds time );
+		const Real* GetInterpolatedReference( TimeInSeconds time );
+		StorageCSP storage_; // shared between measure instances
+		std::shared_ptr< const MimicReference > reference_; // tracked channels, aligned to the measure step size (if fixed)
+		index_t frame_cursor_; // last reference frame, for when the frames are not equidistant
 		Statistic<> result_;
-		std::vector< std::pair< index_t, index_t > > state_storage_map_;
-		std::vector< std::pair< String, double > > channel_errors_;
+		std::vector< index_t > state_indices_; // model state index of each tracked channel
+		std::vector< index_t > storage_indices_; // storage channel index of each tracked channel
+		std::vector< String > channel_names_;
+		std::vector< Real > state_values_; // tracked state values, gathered each update
+		std::vector< Real > channel_errors_; // squared error of each tracked channel
+		std::vector< Real > interpolated_values_; // reference values for times that are not on the fixed step grid
 
 	protected:
 	private:
@@ -50,5 +50,6 @@ namespace scone
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		virtual String GetClassSignature() const override;
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_INTERNAL_STATE( input.GetStatistic(), activation.GetStatistic(), length.GetStatistic(), velocity.GetStatistic() )
 	};
 }
@@ -64,6 +64,10 @@ namespace scone
 
 		bool IsEmpty() const { return penalty.GetNumSamples() == 0; }
 
+		/// Accumulated penalty, used for model checkpoints
+		const Statistic< T >& GetStatistic() const { return penalty; }
+		Statistic< T >& GetStatistic() { return penalty; }
+
 		/// Absolute penalty factor when value is out of range; default = 0.
 		Real abs_penalty;
 
@@ -28,5 +28,6 @@ namespace scone
 
 	protected:
 		virtual void StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const override;
+		SCONE_INTERNAL_STATE( GetStatistic() )
 	};
 }
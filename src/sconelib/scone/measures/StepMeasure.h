@@ -51,6 +51,7 @@ namespace scone
 		virtual bool UpdateMeasure( const Model& model, double timestamp ) override;
 		virtual double ComputeResult( const Model& model ) override;
 		virtual String GetClassSignature() const override;
+		SCONE_INTERNAL_STATE( stored_data_ )
 
 	private:
 		Storage<Real> stored_data_;
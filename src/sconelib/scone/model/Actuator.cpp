@@ -31,7 +31,10 @@ namespace scone
 	void Actuator::StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const
 	{
 		if ( flags( StoreDataTypes::ActuatorInput ) )
-			frame[ GetName() + ".input" ] = GetInput();
+		{
+			auto& ch = m_InputChannels.Get( frame, GetName(), { ".input" } );
+			frame[ ch[ 0 ] ] = GetInput();
+		}
 	}
 
 	PropNode Actuator::GetInfo() const
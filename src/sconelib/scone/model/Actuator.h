@@ -33,5 +33,8 @@ namespace scone
 
 	protected:
 		double m_ActuatorControlValue;
+
+	private:
+		mutable StoreDataChannels m_InputChannels;
 	};
 }
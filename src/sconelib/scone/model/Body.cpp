@@ -35,25 +35,27 @@ namespace scone
 		auto& name = GetName();
 		if ( flags( StoreDataTypes::BodyComPosition ) )
 		{
+			auto& ch = m_ComChannels.Get( frame, name, { ".com_pos_x", ".com_pos_y", ".com_pos_z", ".lin_vel_x", ".lin_vel_y", ".lin_vel_z" } );
 			auto pos = GetComPos();
-			frame[ name + ".com_pos_x" ] = pos.x;
-			frame[ name + ".com_pos_y" ] = pos.y;
-			frame[ name + ".com_pos_z" ] = pos.z;
+			frame[ ch[ 0 ] ] = pos.x;
+			frame[ ch[ 1 ] ] = pos.y;
+			frame[ ch[ 2 ] ] = pos.z;
 			auto lin_vel = GetComVel();
-			frame[ name + ".lin_vel_x" ] = lin_vel.x;
-			frame[ name + ".lin_vel_y" ] = lin_vel.y;
-			frame[ name + ".lin_vel_z" ] = lin_vel.z;
+			frame[ ch[ 3 ] ] = lin_vel.x;
+			frame[ ch[ 4 ] ] = lin_vel.y;
+			frame[ ch[ 5 ] ] = lin_vel.z;
 		}
 		if ( flags( StoreDataTypes::BodyOrientation ) )
 		{
+			auto& ch = m_OriChannels.Get( frame, name, { ".ori_x", ".ori_y", ".ori_z", ".ang_vel_x", ".ang_vel_y", ".ang_vel_z" } );
 			auto ori = rotation_vector_from_quat( normalized( GetOrientation() ) );
-			frame[ name + ".ori_x" ] = ori.x;
-			frame[ name + ".ori_y" ] = ori.y;
-			frame[ name + ".ori_z" ] = ori.z;
+			frame[ ch[ 0 ] ] = ori.x;
+			frame[ ch[ 1 ] ] = ori.y;
+			frame[ ch[ 2 ] ] = ori.z;
 			auto ang_vel = GetAngVel();
-			frame[ name + ".ang_vel_x" ] = ang_vel.x;
-			frame[ name + ".ang_vel_y" ] = ang_vel.y;
-			frame[ name + ".ang_vel_z" ] = ang_vel.z;
+			frame[ ch[ 3 ] ] = ang_vel.x;
+			frame[ ch[ 4 ] ] = ang_vel.y;
+			frame[ ch[ 5 ] ] = ang_vel.z;
 		}
 	}
 
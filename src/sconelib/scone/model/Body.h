@@ -76,5 +76,8 @@ namespace scone
 	protected:
 		friend Joint;
 		Joint* m_Joint; // set automatically when a Joint is created
+
+	private:
+		mutable StoreDataChannels m_ComChannels, m_OriChannels;
 	};
 }
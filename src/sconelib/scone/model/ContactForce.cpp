@@ -29,11 +29,12 @@ namespace scone
 	void ContactForce::StoreData( Storage<Real>::Frame& frame, const StoreDataFlags& flags ) const
 	{
 		const auto& [force, moment, point] = GetForceMomentPoint();
-		frame[ GetName() + ".force_x" ] = force.x;
-		frame[ GetName() + ".force_y" ] = force.y;
-		frame[ GetName() + ".force_z" ] = force.z;
-		frame[ GetName() + ".moment_x" ] = moment.x;
-		frame[ GetName() + ".moment_y" ] = moment.y;
-		frame[ GetName() + ".moment_z" ] = moment.z;
+		auto& ch = m_StoreDataChannels.Get( frame, GetName(), { ".force_x", ".force_y", ".force_z", ".moment_x", ".moment_y", ".moment_z" } );
+		frame[ ch[ 0 ] ] = force.x;
+		frame[ ch[ 1 ] ] = force.y;
+		frame[ ch[ 2 ] ] = force.z;
+		frame[ ch[ 3 ] ] = moment.x;
+		frame[ ch[ 4 ] ] = moment.y;
+		frame[ ch[ 5 ] ] = moment.z;
 	}
 }
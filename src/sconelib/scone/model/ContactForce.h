@@ -34,5 +34,6 @@ namespace scone
 
 	protected:
 		std::vector< ContactGeometry* > m_Geometries;
+		mutable StoreDataChannels m_StoreDataChannels;
 	};
 }
@@ -48,7 +48,10 @@ namespace scone
 	{
 		// store joint reaction force magnitude
 		if ( flags( StoreDataTypes::JointReactionForce ) )
-			frame[ GetName() + ".load" ] = GetLoad();
+		{
+			auto& ch = m_LoadChannels.Get( frame, GetName(), { ".load" } );
+			frame[ ch[ 0 ] ] = GetLoad();
+		}
 	}
 
 	PropNode Joint::GetInfo() const
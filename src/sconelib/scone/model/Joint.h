@@ -41,5 +41,6 @@ namespace scone
 		Body& m_Body;
 		Body& m_ParentBody;
 		mutable std::vector< Dof* > m_Dofs;
+		mutable StoreDataChannels m_LoadChannels;
 	};
 }
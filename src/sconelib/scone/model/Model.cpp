@@ -19,6 +19,7 @@
 #include "scone/core/profiler_config.h"
 #include "scone/core/Settings.h"
 #include "scone/core/StorageIo.h"
+#include "scone/core/AllocationCounter.h"
 #include "scone/measures/Measure.h"
 
 #include "xo/container/container_tools.h"
@@ -32,22 +33,60 @@
 #include <algorithm>
 #include <tuple>
 #include <fstream>
+#include <numeric>
+
+#include <chrono>
 
 using std::endl;
 
 namespace scone
 {
+	// size of the model-owned initial arena block
+	constexpr size_t arena_size = 64 * 1024;
+
+	// adds the duration and heap allocations of a scope to a component benchmark, if enabled
+	struct ScopedComponentTimer
+	{
+		using clock = std::chrono::steady_clock;
+		ScopedComponentTimer( std::pair< xo::time, size_t >& bm, size_t& allocations, bool enabled ) :
+			bm_( enabled ? &bm : nullptr ),
+			allocations_( allocations ),
+			start_allocations_( enabled ? GetThreadAllocationCount() : 0 )
+		{
+			if ( bm_ ) start_ = clock::now();
+		}
+		~ScopedComponentTimer() {
+			if ( bm_ ) {
+				bm_->first += xo::time_from_nanoseconds( std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now() - start_ ).count() );
+				++bm_->second;
+				allocations_ += GetThreadAllocationCount() - start_allocations_;
+			}
+		}
+		std::pair< xo::time, size_t >* bm_;
+		size_t& allocations_;
+		size_t start_allocations_;
+		clock::time_point start_;
+	};
+
 	Model::Model( const PropNode& props, Params& par ) :
 		HasSignature( props ),
 		m_Profiler( props.get<bool>( "enable_profiler", false ) ),
+		m_ArenaBuffer( new std::byte[ arena_size ] ),
+		m_Arena( m_ArenaBuffer.get(), arena_size ),
 		m_Measure( nullptr ),
 		m_Controller( nullptr ),
 		m_ShouldTerminate( false ),
+		m_UseSensorDelayBuffer( false ),
+		m_SensorDelayStorageWindow( 0 ),
+		m_SensorDelayStorageSamples( 0 ),
 		m_RootBody( nullptr ),
 		m_pModelProps( nullptr ),
 		m_pCustomProps( nullptr ),
 		m_StoreData( false ),
-		m_StoreDataFlags( { StoreDataTypes::State, StoreDataTypes::ActuatorInput, StoreDataTypes::MuscleExcitation, StoreDataTypes::GroundReactionForce, StoreDataTypes::ContactForce } )
+		m_StoreDataFlags( { StoreDataTypes::State, StoreDataTypes::ActuatorInput, StoreDataTypes::MuscleExcitation, StoreDataTypes::GroundReactionForce, StoreDataTypes::ContactForce } ),
+		m_Benchmarking( false ),
+		m_ComponentTimes(),
+		m_ComponentAllocations()
 	{
 		SCONE_PROFILE_FUNCTION( GetProfiler() );
 
@@ -70,10 +109,13 @@ namespace scone
 		INIT_PROP( props, max_step_size, 0.001 );
 		INIT_PROP( props, fixed_control_step_size, 0.001 );
 		INIT_PROP( props, fixed_measure_step_size, fixed_control_step_size );
+		INIT_PROP( props, random_seed_offset, 0 );
 		INIT_PROP( props, use_fixed_control_step_size, fixed_control_step_size > 0 );
 		fixed_step_size = std::min( fixed_control_step_size, fixed_measure_step_size );
 		fixed_control_step_interval = static_cast<int>( std::round( fixed_control_step_size / fixed_step_size ) );
 		fixed_analysis_step_interval = static_cast<int>( std::round( fixed_measure_step_size / fixed_step_size ) );
+		m_SensorDelayBuffer.SetStepSize( fixed_control_step_size );
+		m_UseSensorDelayBuffer = use_fixed_control_step_size;
 
 		INIT_PROP( props, initial_load, 0.2 );
 		INIT_PROP( props, initial_load_dof, "pelvis_ty" );
@@ -128,18 +170,111 @@ namespace scone
 	void Model::UpdateSensorDelayAdapters()
 	{
 		SCONE_PROFILE_FUNCTION( GetProfiler() );
+		ScopedComponentTimer bm( m_ComponentTimes[ SensorBenchmark ], m_ComponentAllocations[ SensorBenchmark ], m_Benchmarking );
 
 		//SCONE_THROW_IF( GetIntegrationStep() != GetPreviousIntegrationStep() + 1, "SensorDelayAdapters should only be updated at each new integration step" );
-		SCONE_ASSERT( m_SensorDelayStorage.IsEmpty() || GetPreviousTime() == m_SensorDelayStorage.Back().GetTime() );
+		SampleSensors();
 
-		// add a new frame and update
-		m_SensorDelayStorage.AddFrame( GetTime() );
-		for ( std::unique_ptr< SensorDelayAdapter >& sda : m_SensorDelayAdapters )
-			sda->UpdateStorage();
+		// add a new frame and copy the sampled values
+		if ( m_UseSensorDelayBuffer )
+		{
+			SCONE_ASSERT( m_SensorDelayBuffer.IsEmpty() || GetPreviousTime() == m_SensorDelayBuffer.GetBackTime() );
+			m_SensorDelayBuffer.AddFrame( GetTime() );
+			for ( index_t idx = 0; idx < m_SensorValues.size(); ++idx )
+				m_SensorDelayBuffer.Back( idx ) = m_SensorValues[ idx ];
+			UpdateDelayedSensorInputs();
+		}
+		else
+		{
+			SCONE_ASSERT( m_SensorDelayStorage.IsEmpty() || GetPreviousTime() == m_SensorDelayStorage.Back().GetTime() );
+			auto& frame = m_SensorDelayStorage.AddFrame( GetTime() );
+			for ( index_t idx = 0; idx < m_SensorValues.size(); ++idx )
+				frame[ idx ] = m_SensorValues[ idx ];
+		}
 
 		//log::TraceF( "Updated Sensor Delays for Int=%03d time=%.6f prev_time=%.6f", GetIntegrationStep(), GetTime(), GetPreviousTime() );
 	}
 
+	void Model::SampleSensors()
+	{
+		SCONE_PROFILE_FUNCTION( GetProfiler() );
+
+		// group adapters by stage, so that each stage is realized only once
+		if ( m_SensorSampleOrder.size() != m_SensorDelayAdapters.size() )
+		{
+			m_SensorSampleOrder.clear();
+			for ( index_t idx = 0; idx < m_SensorDelayAdapters.size(); ++idx )
+				m_SensorSampleOrder.push_back( { m_SensorDelayAdapters[ idx ].get(), m_SensorDelayAdapters[ idx ]->GetInputSensor().GetStage() } );
+			std::stable_sort( m_SensorSampleOrder.begin(), m_SensorSampleOrder.end(), []( const SensorSample& a, const SensorSample& b ) { return a.stage < b.stage; } );
+			m_SensorValues.resize( m_SensorDelayAdapters.size() );
+		}
+
+		// with variable step sizes, sensors are sampled during computeControls(), where realizing the state
+		// could recursively require the controls; in that case sensors realize the state themselves (if needed)
+		const bool realize_stages = use_fixed_control_step_size;
+		auto stage = SensorStage::Time;
+		bool realized = false;
+		for ( const auto& s : m_SensorSampleOrder )
+		{
+			if ( realize_stages && ( !realized || s.stage != stage ) )
+			{
+				stage = s.stage;
+				RealizeSensorStage( stage );
+				realized = true;
+			}
+			m_SensorValues[ s.adapter->GetChannelIndex() ] = s.adapter->GetInputSensor().GetValue();
+		}
+	}
+
+	index_t Model::AddDelayedSensorInput( SensorDelayAdapter& adapter, TimeInSeconds delay )
+	{
+		// inputs are shared between controllers that read the same sensor with the same delay
+		auto it = std::find_if( m_DelayedSensorInputs.begin(), m_DelayedSensorInputs.end(),
+			[&]( const DelayedSensorInput& i ) { return i.adapter == &adapter && i.delay == delay; } );
+		if ( it != m_DelayedSensorInputs.end() )
+			return it - m_DelayedSensorInputs.begin();
+
+		adapter.ReserveDelay( delay );
+		DelayedSensorInput input{ &adapter, adapter.GetChannelIndex(), delay, SensorDelayBuffer::Tap() };
+		if ( m_UseSensorDelayBuffer )
+			input.tap = m_SensorDelayBuffer.GetTap( delay * sensor_delay_scaling_factor );
+		m_DelayedSensorInputs.push_back( input );
+		m_DelayedSensorInputValues.push_back( m_UseSensorDelayBuffer && !m_SensorDelayBuffer.IsEmpty() ?
+			m_SensorDelayBuffer.GetValue( input.channel, input.tap ) : Real( 0 ) );
+		return m_DelayedSensorInputs.size() - 1;
+	}
+
+	void Model::UpdateDelayedSensorInputs()
+	{
+		for ( index_t idx = 0; idx < m_DelayedSensorInputs.size(); ++idx )
+			m_DelayedSensorInputValues[ idx ] = m_SensorDelayBuffer.GetValue( m_DelayedSensorInputs[ idx ].channel, m_DelayedSensorInputs[ idx ].tap );
+	}
+
+	Real Model::GetDelayedSensorInputFromStorage( index_t idx ) const
+	{
+		// values in storage are interpolated at the current time, which can change between sensor updates
+		const auto& input = m_DelayedSensorInputs[ idx ];
+		return input.adapter->GetValue( input.delay );
+	}
+
+	void Model::DisableSensorDelayBuffer()
+	{
+		if ( !m_UseSensorDelayBuffer )
+			return;
+
+		// copy buffered frames to storage, oldest first
+		m_SensorDelayStorage.ClearFrames();
+		const auto& buf = m_SensorDelayBuffer;
+		for ( index_t i = buf.GetSize(); i-- > 0; )
+		{
+			auto& f = m_SensorDelayStorage.AddFrame( buf.GetBackTime() - i * buf.GetStepSize() );
+			for ( index_t c = 0; c < buf.GetChannelCount(); ++c )
+				f[ c ] = buf.GetSample( c, i );
+		}
+		m_SensorDelayBuffer.Clear();
+		m_UseSensorDelayBuffer = false;
+	}
+
 	void Model::CreateControllers( const PropNode& pn, Params& par )
 	{
 		// add controller (new style, prefer define outside model)
@@ -159,6 +294,127 @@ namespace scone
 		}
 	}
 
+	void Model::Reset( const PropNode& props, Params& par )
+	{
+		SCONE_THROW_IF( !CanReset(), "Model " + GetName() + " does not support reset" );
+
+		// controllers and measures are recreated by the caller, sensors are kept
+		m_Controller.reset();
+		m_Measure.reset();
+		m_Arena.release(); // only used by controllers and measures
+		INIT_PROP( props, random_seed_offset, 0 );
+		m_ShouldTerminate = false;
+		m_SensorDelayStorage.ClearFrames();
+		m_SensorDelayBuffer.Clear();
+		m_UseSensorDelayBuffer = use_fixed_control_step_size;
+		m_DelayedSensorInputs.clear();
+		m_DelayedSensorInputValues.clear();
+		m_Data.Clear();
+		m_UserData = PropNode();
+		m_ComponentTimes = {};
+		m_ComponentAllocations = {};
+		m_MuscleStateSnapshot.Invalidate();
+
+		for ( auto& a : GetActuators() )
+			a->ClearInput();
+		for ( auto& b : GetBodies() )
+			b->ClearExternalForceAndMoment();
+	}
+
+	ModelCheckpoint Model::CreateCheckpoint() const
+	{
+		SCONE_THROW_IF( !CanCheckpoint(), "Model " + GetName() + " does not support checkpoints" );
+		SCONE_PROFILE_FUNCTION( GetProfiler() );
+
+		ModelCheckpoint cp;
+		cp.time = GetTime();
+		cp.state_values = GetState().GetValues();
+		for ( auto& b : GetBodies() )
+			cp.body_forces.push_back( { b->GetExternalForce(), b->GetExternalForcePoint(), b->GetExternalMoment() } );
+		// only the frames within the delay window are needed to continue, plus one earlier frame for interpolation
+		const auto& times = m_SensorDelayStorage.GetTimes();
+		size_t first_frame = std::upper_bound( times.begin(), times.end(), GetTime() - m_SensorDelayStorageWindow ) - times.begin();
+		first_frame = std::min( first_frame > 0 ? first_frame - 1 : 0, times.size() - std::min( times.size(), m_SensorDelayStorageSamples ) );
+		cp.sensor_delay_storage = m_SensorDelayStorage.CopySlice( first_frame, 0, 1 );
+		cp.sensor_delay_buffer = m_SensorDelayBuffer;
+		cp.data_frame_count = m_Data.GetFrameCount();
+		cp.user_data = m_UserData;
+		cp.should_terminate = m_ShouldTerminate;
+		if ( m_Controller )
+			cp.controller = m_Controller->GetCheckpoint();
+		if ( m_Measure )
+			cp.measure = m_Measure->GetCheckpoint();
+		return cp;
+	}
+
+	void Model::RestoreCheckpoint( const ModelCheckpoint& cp )
+	{
+		SCONE_THROW_IF( !CanCheckpoint(), "Model " + GetName() + " does not support checkpoints" );
+		SCONE_PROFILE_FUNCTION( GetProfiler() );
+		SCONE_ERROR_IF( cp.state_values.size() != GetState().GetSize() || cp.body_forces.size() != GetBodies().size(),
+			"Checkpoint was created by a different model" );
+		SCONE_ERROR_IF( bool( cp.controller ) != bool( m_Controller ) || bool( cp.measure ) != bool( m_Measure ),
+			"Checkpoint does not match the controller and measure of " + GetName() );
+
+		// sensors acquired after the checkpoint have no history, so they cannot be restored
+		SCONE_ERROR_IF( cp.sensor_delay_storage.GetChannelCount() != m_SensorDelayStorage.GetChannelCount() ||
+			cp.sensor_delay_buffer.GetChannelCount() != m_SensorDelayBuffer.GetChannelCount(),
+			"Checkpoint does not match the delayed sensors of " + GetName() );
+		auto capacity = m_SensorDelayBuffer.GetCapacity();
+		m_SensorDelayStorage = cp.sensor_delay_storage;
+		m_SensorDelayBuffer = cp.sensor_delay_buffer;
+		if ( capacity > 0 )
+			m_SensorDelayBuffer.ReserveSamples( capacity - 1 ); // keep delays that were reserved after the checkpoint
+		if ( m_UseSensorDelayBuffer && !m_SensorDelayBuffer.IsEmpty() )
+			UpdateDelayedSensorInputs();
+
+		for ( index_t i = 0; i < m_Bodies.size(); ++i )
+		{
+			m_Bodies[ i ]->SetExternalForceAtPoint( cp.body_forces[ i ].force, cp.body_forces[ i ].point );
+			m_Bodies[ i ]->SetExternalMoment( cp.body_forces[ i ].moment );
+		}
+
+		m_Data.TruncateFrames( cp.data_frame_count );
+		m_UserData = cp.user_data;
+		m_ShouldTerminate = cp.should_terminate;
+		m_MuscleStateSnapshot.Invalidate();
+
+		if ( m_Controller )
+			m_Controller->RestoreCheckpoint( *cp.controller );
+		if ( m_Measure )
+			m_Measure->RestoreCheckpoint( *cp.measure );
+	}
+
+	const MuscleStateSnapshot& Model::GetMuscleStateSnapshot( unsigned fields ) const
+	{
+		m_MuscleStateSnapshot.Update( GetMuscles(), GetIntegrationStep(), GetTime(), fields );
+		return m_MuscleStateSnapshot;
+	}
+
+	std::vector<std::pair<String, std::pair<xo::time, size_t>>> Model::GetBenchmarks() const
+	{
+		if ( !m_Benchmarking )
+			return {};
+		const char* names[ BenchmarkComponentCount ] = { "Controller", "Analysis", "Sensors", "Storage" };
+		std::vector<std::pair<String, std::pair<xo::time, size_t>>> bms;
+		for ( index_t i = 0; i < BenchmarkComponentCount; ++i )
+			if ( m_ComponentTimes[ i ].second > 0 )
+				bms.emplace_back( names[ i ], m_ComponentTimes[ i ] );
+		return bms;
+	}
+
+	std::vector<std::pair<String, double>> Model::GetBenchmarkAllocations() const
+	{
+		if ( !m_Benchmarking || !IsAllocationCountingEnabled() )
+			return {};
+		const char* names[ BenchmarkComponentCount ] = { "ControllerAllocations", "AnalysisAllocations", "SensorsAllocations", "StorageAllocations" };
+		std::vector<std::pair<String, double>> allocs;
+		for ( index_t i = 0; i < BenchmarkComponentCount; ++i )
+			if ( m_ComponentTimes[ i ].second > 0 )
+				allocs.emplace_back( names[ i ], double( m_ComponentAllocations[ i ] ) / m_ComponentTimes[ i ].second );
+		return allocs;
+	}
+
 	bool Model::GetStoreData() const
 	{
 		return m_StoreData && ( m_Data.IsEmpty() || xo::greater_than_or_equal( GetTime() - m_Data.Back().GetTime(), m_StoreDataInterval, 1e-6 ) );
@@ -171,8 +427,9 @@ namespace scone
 		// store states
 		if ( flags( StoreDataTypes::State ) )
 		{
+			auto& ch = m_StateChannels.Get( frame, GetState().GetSize(), [&]( index_t i ) { return GetState().GetName( i ); } );
 			for ( size_t i = 0; i < GetState().GetSize(); ++i )
-				frame[ GetState().GetName( i ) ] = GetState().GetValue( i );
+				frame[ ch[ i ] ] = GetState().GetValue( i );
 		}
 
 		// store simulation statistics
@@ -198,8 +455,9 @@ namespace scone
 		// store dof data
 		if ( flags( StoreDataTypes::DofMoment ) )
 		{
-			for ( auto& d : GetDofs() )
-				frame[ d->GetName() + ".moment" ] = d->GetMoment();
+			auto& ch = m_DofMomentChannels.Get( frame, GetDofs().size(), [&]( index_t i ) { return GetDofs()[ i ]->GetName() + ".moment"; } );
+			for ( index_t i = 0; i < GetDofs().size(); ++i )
+				frame[ ch[ i ] ] = GetDofs()[ i ]->GetMoment();
 		}
 
 		// store controller / measure data
@@ -209,51 +467,62 @@ namespace scone
 			GetMeasure()->StoreData( frame, flags );
 
 		// store sensor data
-		if ( flags( StoreDataTypes::SensorData ) && !m_SensorDelayStorage.IsEmpty() )
+		if ( flags( StoreDataTypes::SensorData ) && m_UseSensorDelayBuffer && !m_SensorDelayBuffer.IsEmpty() )
+		{
+			auto& ch = m_SensorChannels.Get( frame, m_SensorDelayBuffer.GetChannelCount(), [&]( index_t i ) { return m_SensorDelayStorage.GetLabels()[ i ]; } );
+			for ( index_t i = 0; i < m_SensorDelayBuffer.GetChannelCount(); ++i )
+				frame[ ch[ i ] ] = m_SensorDelayBuffer.Back( i );
+		}
+		else if ( flags( StoreDataTypes::SensorData ) && !m_SensorDelayStorage.IsEmpty() )
 		{
-			auto sf = m_SensorDelayStorage.Back();
+			auto& sf = m_SensorDelayStorage.Back();
+			auto& ch = m_SensorChannels.Get( frame, m_SensorDelayStorage.GetChannelCount(), [&]( index_t i ) { return m_SensorDelayStorage.GetLabels()[ i ]; } );
 			for ( index_t i = 0; i < m_SensorDelayStorage.GetChannelCount(); ++i )
-				frame[ m_SensorDelayStorage.GetLabels()[ i ] ] = sf[ i ];
+				frame[ ch[ i ] ] = sf[ i ];
 		}
 
 		// store COP data
 		if ( flags( StoreDataTypes::BodyComPosition ) )
 		{
+			auto& ch = m_ComChannels.Get( frame, "", { "com_x", "com_y", "com_z", "com_x_u", "com_y_u", "com_z_u",
+				"lin_mom_x", "lin_mom_y", "lin_mom_z", "ang_mom_x", "ang_mom_y", "ang_mom_z" } );
 			auto com = GetComPos();
 			auto com_u = GetComVel();
-			frame[ "com_x" ] = com.x;
-			frame[ "com_y" ] = com.y;
-			frame[ "com_z" ] = com.z;
-			frame[ "com_x_u" ] = com_u.x;
-			frame[ "com_y_u" ] = com_u.y;
-			frame[ "com_z_u" ] = com_u.z;
+			frame[ ch[ 0 ] ] = com.x;
+			frame[ ch[ 1 ] ] = com.y;
+			frame[ ch[ 2 ] ] = com.z;
+			frame[ ch[ 3 ] ] = com_u.x;
+			frame[ ch[ 4 ] ] = com_u.y;
+			frame[ ch[ 5 ] ] = com_u.z;
 
 			const auto mom = GetLinAngMom();
-			frame.SetVec3( "lin_mom", mom.first );
-			frame.SetVec3( "ang_mom", mom.second );
+			frame[ ch[ 6 ] ] = mom.first.x;
+			frame[ ch[ 7 ] ] = mom.first.y;
+			frame[ ch[ 8 ] ] = mom.first.z;
+			frame[ ch[ 9 ] ] = mom.second.x;
+			frame[ ch[ 10 ] ] = mom.second.y;
+			frame[ ch[ 11 ] ] = mom.second.z;
 		}
 
 		// store GRF data (measured in BW)
 		if ( flags( StoreDataTypes::GroundReactionForce ) )
 		{
-			for ( auto& leg : GetLegs() )
+			static const char* grf_postfixes[] = { ".grf_norm_x", ".grf_norm_y", ".grf_norm_z", ".grf_x", ".grf_y", ".grf_z",
+				".grm_x", ".grm_y", ".grm_z", ".cop_x", ".cop_y", ".cop_z" };
+			auto& ch = m_GrfChannels.Get( frame, 12 * GetLegs().size(), [&]( index_t i ) { return GetLegs()[ i / 12 ]->GetName() + grf_postfixes[ i % 12 ]; } );
+			index_t c = 0;
+			for ( index_t leg_idx = 0; leg_idx < GetLegs().size(); ++leg_idx )
 			{
 				Vec3 force, moment, cop;
-				leg->GetContactForceMomentCop( force, moment, cop );
+				GetLegs()[ leg_idx ]->GetContactForceMomentCop( force, moment, cop );
 				Vec3 grf = force / GetBW();
 
-				frame[ leg->GetName() + ".grf_norm_x" ] = grf.x;
-				frame[ leg->GetName() + ".grf_norm_y" ] = grf.y;
-				frame[ leg->GetName() + ".grf_norm_z" ] = grf.z;
-				frame[ leg->GetName() + ".grf_x" ] = force.x;
-				frame[ leg->GetName() + ".grf_y" ] = force.y;
-				frame[ leg->GetName() + ".grf_z" ] = force.z;
-				frame[ leg->GetName() + ".grm_x" ] = moment.x;
-				frame[ leg->GetName() + ".grm_y" ] = moment.y;
-				frame[ leg->GetName() + ".grm_z" ] = moment.z;
-				frame[ leg->GetName() + ".cop_x" ] = cop.x;
-				frame[ leg->GetName() + ".cop_y" ] = cop.y;
-				frame[ leg->GetName() + ".cop_z" ] = cop.z;
+				for ( const Vec3& v : { grf, force, moment, cop } )
+				{
+					frame[ ch[ c++ ] ] = v.x;
+					frame[ ch[ c++ ] ] = v.y;
+					frame[ ch[ c++ ] ] = v.z;
+				}
 			}
 		}
 
@@ -267,6 +536,7 @@ namespace scone
 	void Model::StoreCurrentFrame()
 	{
 		SCONE_PROFILE_FUNCTION( GetProfiler() );
+		ScopedComponentTimer bm( m_ComponentTimes[ StorageBenchmark ], m_ComponentAllocations[ StorageBenchmark ], m_Benchmarking );
 		if ( m_Data.IsEmpty() || GetTime() > m_Data.Back().GetTime() )
 			m_Data.AddFrame( GetTime() );
 		StoreData( m_Data.Back(), m_StoreDataFlags );
@@ -287,6 +557,7 @@ namespace scone
 	void Model::UpdateControlValues()
 	{
 		SCONE_PROFILE_FUNCTION( GetProfiler() );
+		ScopedComponentTimer bm( m_ComponentTimes[ ControllerBenchmark ], m_ComponentAllocations[ ControllerBenchmark ], m_Benchmarking );
 
 		// reset actuator values
 		for ( Actuator* a : GetActuators() )
@@ -303,6 +574,7 @@ namespace scone
 	void Model::UpdateAnalyses()
 	{
 		SCONE_PROFILE_FUNCTION( GetProfiler() );
+		ScopedComponentTimer bm( m_ComponentTimes[ AnalysisBenchmark ], m_ComponentAllocations[ AnalysisBenchmark ], m_Benchmarking );
 
 		bool terminate = false;
 		if ( auto* c = GetController() )
@@ -351,8 +623,9 @@ namespace scone
 	std::vector<scone::path> Model::WriteResults( const path& file ) const
 	{
 		std::vector<path> files;
-		WriteStorageSto( m_Data, file + ".sto", ( file.parent_path().filename() / file.stem() ).str() );
-		files.push_back( file + ".sto" );
+		auto data_file = file + ( GetSconeSetting<bool>( "results.binary" ) ? "." + String( StorageBinExtension ) : ".sto" );
+		WriteStorage( m_Data, data_file, ( file.parent_path().filename() / file.stem() ).str() );
+		files.push_back( data_file );
 
 		if ( GetSconeSetting<bool>( "results.controller" ) )
 		{
@@ -18,6 +18,9 @@
 #include "ForceValue.h"
 #include "Leg.h"
 #include "Sensor.h"
+#include "SensorDelayBuffer.h"
+#include "MuscleStateSnapshot.h"
+#include "ModelCheckpoint.h"
 #include "ModelFeatures.h"
 
 #include "scone/controllers/Controller.h"
@@ -31,6 +34,8 @@
 #include <vector>
 #include <type_traits>
 #include <utility>
+#include <array>
+#include <memory_resource>
 
 namespace scone
 {
@@ -117,8 +122,32 @@ namespace scone
 		virtual bool HasSimulationEnded() { return m_ShouldTerminate || GetTime() >= GetSimulationEndTime(); }
 		virtual void RequestTermination() { m_ShouldTerminate = true; }
 		virtual PropNode GetSimulationReport() const { return PropNode(); }
+
+		// Reset model to its initial state and recreate controllers using new parameters
+		virtual bool CanReset() const { return false; }
+		virtual void Reset( const PropNode& props, Params& par );
 		virtual void UpdatePerformanceStats( const path& filename ) const {}
-		virtual std::vector<std::pair<String, std::pair<xo::time, size_t>>> GetBenchmarks() const { return {}; }
+		virtual std::vector<std::pair<String, std::pair<xo::time, size_t>>> GetBenchmarks() const;
+
+		/// Capture the simulation state, including sensor delays, controllers and measures, see ModelCheckpoint
+		virtual bool CanCheckpoint() const { return false; }
+		virtual ModelCheckpoint CreateCheckpoint() const;
+
+		/// Continue the simulation from a checkpoint, controllers and measures must match those of the checkpoint
+		virtual void RestoreCheckpoint( const ModelCheckpoint& cp );
+
+		/// Measure the time spent in controllers, analyses, sensors and storage, reported by GetBenchmarks()
+		void SetBenchmarking( bool enable ) { m_Benchmarking = enable; }
+
+		/// Average number of heap allocations per call of each benchmarked component (requires SCONE_COUNT_ALLOCATIONS)
+		std::vector<std::pair<String, double>> GetBenchmarkAllocations() const;
+
+		/// Muscle state values of the current integration step, of which at least the requested fields (MuscleStateSnapshot::Field) are up-to-date
+		const MuscleStateSnapshot& GetMuscleStateSnapshot( unsigned fields ) const;
+
+		/// Memory for controllers and measures, which is released when the model is reset.
+		/// Its initial block is owned by the model, so evaluations that fit in it do not allocate from the heap.
+		std::pmr::memory_resource& GetArena() const { return m_Arena; }
 
 		// Model data
 		virtual const Storage< Real, TimeInSeconds >& GetData() const { return m_Data; }
@@ -167,6 +196,23 @@ namespace scone
 		// create delayed sensors
 		SensorDelayAdapter& AcquireSensorDelayAdapter( Sensor& source );
 		Storage< Real >& GetSensorDelayStorage() { return m_SensorDelayStorage; }
+		SensorDelayBuffer& GetSensorDelayBuffer() { return m_SensorDelayBuffer; }
+		bool UseSensorDelayBuffer() const { return m_UseSensorDelayBuffer; }
+		/// Keep at least delay [s] or samples frames of sensor delay storage in a ModelCheckpoint
+		void ReserveSensorDelayStorage( TimeInSeconds delay, size_t samples = 0 ) {
+			m_SensorDelayStorageWindow = std::max( m_SensorDelayStorageWindow, delay );
+			m_SensorDelayStorageSamples = std::max( m_SensorDelayStorageSamples, samples );
+		}
+		/// Sensor values sampled during the most recent sensor delay update, indexed by delay channel
+		const std::vector< Real >& GetSensorValues() const { return m_SensorValues; }
+		/// Register a delayed sensor value that is read every control step, returns its index for GetDelayedSensorInput()
+		/** With a fixed control step size, the values of all inputs are read from the delay buffer in a single pass after each
+		sensor update, after which controllers read them from a contiguous array. Inputs are removed when the model is reset. */
+		index_t AddDelayedSensorInput( SensorDelayAdapter& adapter, TimeInSeconds delay );
+		Real GetDelayedSensorInput( index_t idx ) const {
+			return m_UseSensorDelayBuffer ? m_DelayedSensorInputValues[ idx ] : GetDelayedSensorInputFromStorage( idx );
+		}
+		void DisableSensorDelayBuffer(); // required for direct access to sensor delay storage frames
 
 		template< typename SensorT, typename... Args > SensorDelayAdapter& AcquireDelayedSensor( Args&&... args )
 		{ return AcquireSensorDelayAdapter( AcquireSensor< SensorT >( std::forward< Args >( args )... ) ); }
@@ -195,6 +241,9 @@ namespace scone
 		/// Step size used for measures (not supported by all model types); default = ''fixed_control_step_size''.
 		double fixed_measure_step_size;
 
+		/// Offset added to the random seeds of controllers, used to evaluate multiple rollouts; default = 0.
+		int random_seed_offset;
+
 		/// Initial load [BW] at which to place the model initially; default = 0.2;
 		Real initial_load;
 
@@ -217,6 +266,10 @@ namespace scone
 	protected:
 		virtual String GetClassSignature() const override;
 		void UpdateSensorDelayAdapters();
+		void SampleSensors();
+		void UpdateDelayedSensorInputs();
+		Real GetDelayedSensorInputFromStorage( index_t idx ) const;
+		virtual void RealizeSensorStage( SensorStage stage ) {} // realize the simulation before sampling sensors of this stage, if not already realized
 		void CreateControllers( const PropNode& pn, Params& par );
 
 		virtual void StoreData( Storage< Real >::Frame& frame, const StoreDataFlags& flags ) const override;
@@ -226,6 +279,8 @@ namespace scone
 
 	protected:
 		mutable xo::profiler m_Profiler;
+		std::unique_ptr< std::byte[] > m_ArenaBuffer; // initial arena block, reused after each release
+		mutable std::pmr::monotonic_buffer_resource m_Arena; // declared before controllers and measures, which may use it
 
 		std::vector< MuscleUP > m_Muscles;
 		std::vector< BodyUP > m_Bodies;
@@ -247,7 +302,18 @@ namespace scone
 		// non-owning storage
 		std::vector< Actuator* > m_Actuators;
 		Storage< Real > m_SensorDelayStorage;
+		SensorDelayBuffer m_SensorDelayBuffer; // used instead of m_SensorDelayStorage for fixed control step sizes
+		bool m_UseSensorDelayBuffer;
+		TimeInSeconds m_SensorDelayStorageWindow; // furthest look-back of delayed sensors in m_SensorDelayStorage
+		size_t m_SensorDelayStorageSamples;
 		std::vector< std::unique_ptr< SensorDelayAdapter > > m_SensorDelayAdapters;
+		struct SensorSample { SensorDelayAdapter* adapter; SensorStage stage; };
+		std::vector< SensorSample > m_SensorSampleOrder; // delay adapters, sorted by stage
+		std::vector< Real > m_SensorValues;
+		struct DelayedSensorInput { SensorDelayAdapter* adapter; index_t channel; TimeInSeconds delay; SensorDelayBuffer::Tap tap; };
+		std::vector< DelayedSensorInput > m_DelayedSensorInputs;
+		std::vector< Real > m_DelayedSensorInputValues; // values of m_DelayedSensorInputs, updated after each sensor update
+		mutable MuscleStateSnapshot m_MuscleStateSnapshot; // shared between measures
 		std::vector< std::unique_ptr< Sensor > > m_Sensors;
 		Body* m_RootBody;
 
@@ -259,7 +325,14 @@ namespace scone
 		// storage for HasData classes
 		Storage< Real, TimeInSeconds > m_Data;
 		bool m_StoreData;
+		mutable StoreDataChannels m_StateChannels, m_DofMomentChannels, m_SensorChannels, m_ComChannels, m_GrfChannels;
 		TimeInSeconds m_StoreDataInterval;
 		StoreDataFlags m_StoreDataFlags;
+
+		// component timings, only updated when benchmarking is enabled
+		enum BenchmarkComponent { ControllerBenchmark, AnalysisBenchmark, SensorBenchmark, StorageBenchmark, BenchmarkComponentCount };
+		bool m_Benchmarking;
+		std::array< std::pair< xo::time, size_t >, BenchmarkComponentCount > m_ComponentTimes;
+		std::array< size_t, BenchmarkComponentCount > m_ComponentAllocations;
 	};
 }
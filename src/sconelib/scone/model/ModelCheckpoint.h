@@ -0,0 +1,49 @@
+/*
+** ModelCheckpoint.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "scone/core/types.h"
+#include "scone/core/Vec3.h"
+#include "scone/core/Storage.h"
+#include "scone/core/PropNode.h"
+#include "scone/controllers/Controller.h"
+#include "SensorDelayBuffer.h"
+#include "xo/utility/optional.h"
+
+#include <any>
+#include <vector>
+
+namespace scone
+{
+	/// Simulation state of a Model at a specific time, created by Model::CreateCheckpoint().
+	/** A checkpoint can be restored in the model that created it, or in another model created from the same scenario,
+	after which the simulation continues from the time of the checkpoint. This allows multiple continuations to share a single
+	simulated prefix. Controllers and measures must have the same structure as when the checkpoint was created,
+	but their parameters may differ. */
+	struct ModelCheckpoint
+	{
+		struct BodyForce {
+			Vec3 force;
+			Vec3 point;
+			Vec3 moment;
+		};
+
+		TimeInSeconds time;
+		std::vector< Real > state_values;
+		std::any simulator_state; // simulator specific state, set by the model implementation
+		std::vector< BodyForce > body_forces;
+		Storage< Real > sensor_delay_storage; // only the frames within the delay window, see Model::ReserveSensorDelayStorage()
+		SensorDelayBuffer sensor_delay_buffer; // circular buffer that already only contains the delay window
+		size_t data_frame_count; // frames stored after the checkpoint are removed when restoring
+		PropNode user_data;
+		bool should_terminate;
+		xo::optional< ControllerCheckpoint > controller;
+		xo::optional< ControllerCheckpoint > measure;
+	};
+}
@@ -149,27 +149,36 @@ namespace scone
 		Actuator::StoreData( frame, flags );
 
 		if ( flags( StoreDataTypes::MuscleExcitation ) )
-			frame[ GetName() + ".excitation" ] = GetExcitation();
+		{
+			auto& ch = m_ExcitationChannels.Get( frame, GetName(), { ".excitation" } );
+			frame[ ch[ 0 ] ] = GetExcitation();
+		}
 
 		if ( flags( StoreDataTypes::MuscleActivation ) && !flags( StoreDataTypes::State ) )
-			frame[ GetName() + ".activation" ] = GetActivation();
+		{
+			auto& ch = m_ActivationChannels.Get( frame, GetName(), { ".activation" } );
+			frame[ ch[ 0 ] ] = GetActivation();
+		}
 
 		if ( flags( StoreDataTypes::MuscleTendonProperties ) )
 		{
-			frame[ GetName() + ".tendon_length" ] = GetTendonLength();
-			frame[ GetName() + ".tendon_length_norm" ] = GetNormalizedTendonLength() - 1;
-			frame[ GetName() + ".mtu_length" ] = GetLength();
-			frame[ GetName() + ".mtu_velocity" ] = GetVelocity();
+			auto& ch = m_TendonChannels.Get( frame, GetName(), { ".tendon_length", ".tendon_length_norm", ".mtu_length", ".mtu_velocity" } );
+			frame[ ch[ 0 ] ] = GetTendonLength();
+			frame[ ch[ 1 ] ] = GetNormalizedTendonLength() - 1;
+			frame[ ch[ 2 ] ] = GetLength();
+			frame[ ch[ 3 ] ] = GetVelocity();
 		}
 
 		if ( flags( StoreDataTypes::MuscleFiberProperties ) )
 		{
-			frame[ GetName() + ".cos_pennation_angle" ] = GetCosPennationAngle();
-			frame[ GetName() + ".force_length_multiplier" ] = GetActiveForceLengthMultipler();
-			frame[ GetName() + ".passive_fiber_force_norm" ] = GetPassiveFiberForce() / GetMaxIsometricForce();
-			frame[ GetName() + ".fiber_force_norm" ] = GetNormalizedForce();
-			frame[ GetName() + ".fiber_length_norm" ] = GetNormalizedFiberLength();
-			frame[ GetName() + ".fiber_velocity_norm" ] = GetNormalizedFiberVelocity();
+			auto& ch = m_FiberChannels.Get( frame, GetName(), { ".cos_pennation_angle", ".force_length_multiplier",
+				".passive_fiber_force_norm", ".fiber_force_norm", ".fiber_length_norm", ".fiber_velocity_norm" } );
+			frame[ ch[ 0 ] ] = GetCosPennationAngle();
+			frame[ ch[ 1 ] ] = GetActiveForceLengthMultipler();
+			frame[ ch[ 2 ] ] = GetPassiveFiberForce() / GetMaxIsometricForce();
+			frame[ ch[ 3 ] ] = GetNormalizedForce();
+			frame[ ch[ 4 ] ] = GetNormalizedFiberLength();
+			frame[ ch[ 5 ] ] = GetNormalizedFiberVelocity();
 		}
 	}
 
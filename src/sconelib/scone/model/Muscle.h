@@ -92,5 +92,6 @@ namespace scone
 	private:
 		mutable std::vector< const Joint* > m_Joints;
 		mutable std::vector< const Dof* > m_Dofs;
+		mutable StoreDataChannels m_ExcitationChannels, m_ActivationChannels, m_TendonChannels, m_FiberChannels;
 	};
 }
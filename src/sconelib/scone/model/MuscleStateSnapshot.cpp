@@ -0,0 +1,54 @@
+/*
+** MuscleStateSnapshot.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "MuscleStateSnapshot.h"
+#include "Muscle.h"
+
+namespace scone
+{
+	namespace
+	{
+		template< typename F >
+		void ReadMuscleField( const std::vector< MuscleUP >& muscles, std::vector< Real >& values, F get_value )
+		{
+			values.resize( muscles.size() );
+			for ( index_t i = 0; i < muscles.size(); ++i )
+				values[ i ] = get_value( *muscles[ i ] );
+		}
+	}
+
+	void MuscleStateSnapshot::Update( const std::vector< MuscleUP >& muscles, int integration_step, TimeInSeconds time, unsigned fields )
+	{
+		if ( integration_step != integration_step_ || time != time_ || muscles.size() != size_ )
+		{
+			integration_step_ = integration_step;
+			time_ = time;
+			size_ = muscles.size();
+			filled_ = 0;
+		}
+
+		auto missing = fields & ~filled_;
+		if ( missing & Excitation )
+			ReadMuscleField( muscles, excitation, []( const Muscle& m ) { return m.GetExcitation(); } );
+		if ( missing & Activation )
+			ReadMuscleField( muscles, activation, []( const Muscle& m ) { return m.GetActivation(); } );
+		if ( missing & FiberLength )
+			ReadMuscleField( muscles, fiber_length, []( const Muscle& m ) { return m.GetFiberLength(); } );
+		if ( missing & NormalizedFiberLength )
+			ReadMuscleField( muscles, normalized_fiber_length, []( const Muscle& m ) { return m.GetNormalizedFiberLength(); } );
+		if ( missing & FiberVelocity )
+			ReadMuscleField( muscles, fiber_velocity, []( const Muscle& m ) { return m.GetFiberVelocity(); } );
+		if ( missing & Force )
+			ReadMuscleField( muscles, force, []( const Muscle& m ) { return m.GetForce(); } );
+		if ( missing & ActiveFiberForce )
+			ReadMuscleField( muscles, active_fiber_force, []( const Muscle& m ) { return m.GetActiveFiberForce(); } );
+		if ( missing & ActiveForceLengthMultiplier )
+			ReadMuscleField( muscles, active_force_length_multiplier, []( const Muscle& m ) { return m.GetActiveForceLengthMultipler(); } );
+		filled_ |= fields;
+	}
+}
@@ -0,0 +1,57 @@
+/*
+** MuscleStateSnapshot.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "scone/core/platform.h"
+#include "scone/core/types.h"
+
+#include <vector>
+
+namespace scone
+{
+	/// Muscle state values of a single integration step, stored as one array per field.
+	/// Fields are only read from the muscles when requested, and are shared by all users during that step.
+	class SCONE_API MuscleStateSnapshot
+	{
+	public:
+		enum Field : unsigned {
+			Excitation = 1 << 0,
+			Activation = 1 << 1,
+			FiberLength = 1 << 2,
+			NormalizedFiberLength = 1 << 3,
+			FiberVelocity = 1 << 4,
+			Force = 1 << 5,
+			ActiveFiberForce = 1 << 6,
+			ActiveForceLengthMultiplier = 1 << 7
+		};
+
+		/// Read the requested fields that have not yet been read during this integration step
+		void Update( const std::vector< MuscleUP >& muscles, int integration_step, TimeInSeconds time, unsigned fields );
+
+		/// Force all fields to be read at the next Update()
+		void Invalidate() { filled_ = 0; }
+
+		size_t size() const { return size_; }
+
+		std::vector< Real > excitation;
+		std::vector< Real > activation;
+		std::vector< Real > fiber_length;
+		std::vector< Real > normalized_fiber_length;
+		std::vector< Real > fiber_velocity;
+		std::vector< Real > force;
+		std::vector< Real > active_fiber_force;
+		std::vector< Real > active_force_length_multiplier;
+
+	private:
+		size_t size_ = 0;
+		int integration_step_ = -1;
+		TimeInSeconds time_ = 0;
+		unsigned filled_ = 0;
+	};
+}
@@ -13,11 +13,15 @@
 
 namespace scone
 {
+	/// Simulation stage that must be realized before a sensor value can be read
+	enum class SensorStage { Time, Position, Velocity, Dynamics, Acceleration };
+
 	struct Sensor
 	{
 		Sensor() {}
 		virtual ~Sensor() {}
 		virtual String GetName() const = 0;
 		virtual Real GetValue() const = 0;
+		virtual SensorStage GetStage() const { return SensorStage::Acceleration; }
 	};
 }
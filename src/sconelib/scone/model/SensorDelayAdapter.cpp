@@ -20,9 +20,12 @@ namespace scone
 	Sensor(),
 	m_Model( model ),
 	m_InputSensor( source ),
-	m_Delay( default_delay )
+	m_Delay( default_delay ),
+	m_TapDelay( -1 )
 	{
 		m_StorageIdx = m_Model.GetSensorDelayStorage().AddChannel( source.GetName() );
+		auto buffer_idx = m_Model.GetSensorDelayBuffer().AddChannel();
+		SCONE_ASSERT( buffer_idx == m_StorageIdx );
 	}
 
 	SensorDelayAdapter::~SensorDelayAdapter()
@@ -35,11 +38,42 @@ namespace scone
 
 	Real SensorDelayAdapter::GetValue( Real delay ) const
 	{
-		return m_Model.GetSensorDelayStorage().GetInterpolatedValue( m_Model.GetTime() - delay * m_Model.sensor_delay_scaling_factor, m_StorageIdx );
+		if ( m_Model.UseSensorDelayBuffer() )
+		{
+			auto& buf = m_Model.GetSensorDelayBuffer();
+			if ( delay != m_TapDelay )
+			{
+				// delays are typically constant, so this only happens on first use
+				m_Tap = buf.GetTap( delay * m_Model.sensor_delay_scaling_factor );
+				buf.ReserveSamples( m_Tap.offset + 1 );
+				m_TapDelay = delay;
+			}
+			return buf.GetValue( m_StorageIdx, m_Tap );
+		}
+		else
+		{
+			m_Model.ReserveSensorDelayStorage( delay * m_Model.sensor_delay_scaling_factor );
+			return m_Model.GetSensorDelayStorage().GetInterpolatedValue( m_Model.GetTime() - delay * m_Model.sensor_delay_scaling_factor, m_StorageIdx );
+		}
 	}
 
 	Real SensorDelayAdapter::GetAverageValue( int delay_samples, int window_size ) const
 	{
+		if ( m_Model.UseSensorDelayBuffer() )
+		{
+			auto& buf = m_Model.GetSensorDelayBuffer();
+			buf.ReserveSamples( delay_samples + window_size );
+			auto frame_count = (int)buf.GetFrameCount();
+			auto history_begin = xo::max( 0, frame_count - delay_samples - window_size / 2 );
+			auto history_end = xo::clamped( frame_count - delay_samples - window_size / 2 + window_size, 1, frame_count );
+
+			Real value = 0.0;
+			for ( auto i = history_begin; i < history_end; ++i )
+				value += buf.GetSample( m_StorageIdx, frame_count - 1 - i );
+			return value / ( history_end - history_begin );
+		}
+
+		m_Model.ReserveSensorDelayStorage( 0, delay_samples + window_size );
 		auto& sto = m_Model.GetSensorDelayStorage();
 		auto history_begin = xo::max( 0, (int)sto.GetFrameCount() - delay_samples - window_size / 2 );
 		auto history_end = xo::clamped( (int)sto.GetFrameCount() - delay_samples - window_size / 2 + window_size, 1, (int)sto.GetFrameCount() );
@@ -50,11 +84,16 @@ namespace scone
 		return value / ( history_end - history_begin );
 	}
 
-	void SensorDelayAdapter::UpdateStorage()
+	void SensorDelayAdapter::ReserveDelay( TimeInSeconds delay )
+	{
+		if ( m_Model.UseSensorDelayBuffer() )
+			m_Model.GetSensorDelayBuffer().Reserve( delay * m_Model.sensor_delay_scaling_factor );
+	}
+
+	void SensorDelayAdapter::ReserveSamples( int delay_samples, int window_size )
 	{
-		Storage< Real >& storage = m_Model.GetSensorDelayStorage();
-		SCONE_ASSERT( !storage.IsEmpty() && storage.Back().GetTime() == m_Model.GetTime() );
-		storage.Back()[ m_StorageIdx ] = m_InputSensor.GetValue();
+		if ( m_Model.UseSensorDelayBuffer() )
+			m_Model.GetSensorDelayBuffer().ReserveSamples( delay_samples + window_size );
 	}
 
 	String SensorDelayAdapter::GetName() const
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Sensor.h"
+#include "SensorDelayBuffer.h"
 
 #if defined(_MSC_VER)
 #	pragma warning( push )
@@ -28,14 +29,22 @@ namespace scone
 		Real GetValue( Real delay ) const;
 		Real GetAverageValue( int delay_samples, int window_size ) const;
 
-		void UpdateStorage();
+		/// Make sure values with the specified delay remain available (only needed for SensorDelayBuffer)
+		void ReserveDelay( TimeInSeconds delay );
+		void ReserveSamples( int delay_samples, int window_size );
+
 		Sensor& GetInputSensor() { return m_InputSensor; }
+		index_t GetChannelIndex() const { return m_StorageIdx; }
 
 	private:
 		Model& m_Model;
 		Sensor& m_InputSensor;
 		TimeInSeconds m_Delay;
 		index_t m_StorageIdx;
+
+		// cached tap for the most recently used delay
+		mutable Real m_TapDelay;
+		mutable SensorDelayBuffer::Tap m_Tap;
 	};
 }
 
@@ -0,0 +1,110 @@
+/*
+** SensorDelayBuffer.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "scone/core/platform.h"
+#include "scone/core/types.h"
+#include "scone/core/Exception.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace scone
+{
+	/// Fixed-size circular buffer for sensor values that are sampled at a fixed step size.
+	/// Channels are stored contiguously; delayed values are read in constant time using precomputed taps.
+	class SensorDelayBuffer
+	{
+	public:
+		/// Offset of a delayed value in samples, split into integer and fractional part
+		struct Tap
+		{
+			size_t offset = 0;
+			Real weight = 0; // interpolation weight of sample offset + 1
+		};
+
+		SensorDelayBuffer() : m_StepSize( 0 ), m_ChannelCount( 0 ), m_Capacity( 2 ), m_Head( 0 ), m_Size( 0 ), m_FrameCount( 0 ), m_BackTime( 0 ) {}
+
+		void SetStepSize( TimeInSeconds step_size ) { m_StepSize = step_size; }
+		TimeInSeconds GetStepSize() const { return m_StepSize; }
+
+		index_t AddChannel() { Resize( m_ChannelCount + 1, m_Capacity ); return m_ChannelCount - 1; }
+		size_t GetChannelCount() const { return m_ChannelCount; }
+		size_t GetCapacity() const { return m_Capacity; }
+
+		/// Make sure enough samples are kept to read values at the specified delay
+		void Reserve( TimeInSeconds delay ) { ReserveSamples( GetTap( delay ).offset + 1 ); }
+		void ReserveSamples( size_t samples ) { if ( samples + 1 > m_Capacity ) Resize( m_ChannelCount, samples + 1 ); }
+
+		Tap GetTap( TimeInSeconds delay ) const {
+			SCONE_ASSERT( m_StepSize > 0 );
+			auto samples = std::max( 0.0, delay / m_StepSize );
+			auto offset = std::floor( samples );
+			return Tap{ static_cast<size_t>( offset ), samples - offset };
+		}
+
+		void AddFrame( TimeInSeconds time ) {
+			m_Head = m_Size > 0 ? ( m_Head + 1 ) % m_Capacity : 0;
+			m_Size = std::min( m_Size + 1, m_Capacity );
+			++m_FrameCount;
+			m_BackTime = time;
+		}
+
+		void Clear() { m_Head = m_Size = m_FrameCount = 0; m_BackTime = 0; }
+		bool IsEmpty() const { return m_Size == 0; }
+
+		/// Number of frames that are currently kept in the buffer
+		size_t GetSize() const { return m_Size; }
+
+		/// Total number of frames added since the last Clear()
+		size_t GetFrameCount() const { return m_FrameCount; }
+		TimeInSeconds GetBackTime() const { return m_BackTime; }
+
+		Real& Back( index_t channel ) { SCONE_ASSERT( !IsEmpty() ); return m_Data[ channel * m_Capacity + m_Head ]; }
+		Real Back( index_t channel ) const { SCONE_ASSERT( !IsEmpty() ); return m_Data[ channel * m_Capacity + m_Head ]; }
+
+		/// Value of a channel samples_back frames ago, clamped to the oldest available frame
+		Real GetSample( index_t channel, size_t samples_back ) const {
+			SCONE_ASSERT( !IsEmpty() );
+			samples_back = std::min( samples_back, m_Size - 1 );
+			return m_Data[ channel * m_Capacity + ( m_Head + m_Capacity - samples_back ) % m_Capacity ];
+		}
+
+		/// Linearly interpolated value of a channel at a delay tap
+		Real GetValue( index_t channel, const Tap& tap ) const {
+			auto v0 = GetSample( channel, tap.offset );
+			return tap.weight > 0 ? ( 1 - tap.weight ) * v0 + tap.weight * GetSample( channel, tap.offset + 1 ) : v0;
+		}
+
+	private:
+		// resize the buffer, keeping the most recent frames
+		void Resize( size_t channels, size_t capacity ) {
+			std::vector< Real > data( channels * capacity, Real( 0 ) );
+			auto frames = std::min( m_Size, capacity );
+			for ( index_t c = 0; c < std::min( channels, m_ChannelCount ); ++c )
+				for ( index_t i = 0; i < frames; ++i )
+					data[ c * capacity + frames - 1 - i ] = GetSample( c, i );
+			m_Data = std::move( data );
+			m_ChannelCount = channels;
+			m_Capacity = capacity;
+			m_Head = frames > 0 ? frames - 1 : 0;
+			m_Size = frames;
+		}
+
+		TimeInSeconds m_StepSize;
+		size_t m_ChannelCount;
+		size_t m_Capacity;
+		index_t m_Head;
+		size_t m_Size;
+		size_t m_FrameCount;
+		TimeInSeconds m_BackTime;
+		std::vector< Real > m_Data;
+	};
+}
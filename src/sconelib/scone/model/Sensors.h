@@ -13,6 +13,7 @@
 #include "scone/core/Vec3.h"
 #include "scone/model/Side.h"
 #include "xo/numerical/bounds.h"
+#include <algorithm>
 
 #if defined(_MSC_VER)
 #	pragma warning( push )
@@ -34,6 +35,7 @@ namespace scone
 		MuscleForceSensor( const Muscle& m ) : MuscleSensor( m ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 	};
 
 	// Sensor for normalized muscle length
@@ -42,6 +44,7 @@ namespace scone
 		MuscleLengthSensor( const Muscle& m ) : MuscleSensor( m ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Position; }
 	};
 
 	// Sensor for normalized muscle lengthening speed
@@ -50,6 +53,7 @@ namespace scone
 		MuscleVelocitySensor( const Muscle& m ) : MuscleSensor( m ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 	};
 
 	// Sensor for normalized muscle length
@@ -58,6 +62,7 @@ namespace scone
 		MuscleLengthVelocitySensor( const Muscle& m, double kv ) : MuscleSensor( m ), kv_( kv ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 		double kv_;
 	};
 
@@ -67,6 +72,7 @@ namespace scone
 		MuscleLengthVelocitySqrtSensor( const Muscle& m, double kv ) : MuscleSensor( m ), kv_( kv ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 		double kv_;
 	};
 
@@ -76,6 +82,7 @@ namespace scone
 		MuscleSpindleSensor( const Muscle& m ) : MuscleSensor( m ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 	};
 
 	struct SCONE_API MuscleSpindleSensor2 : public MuscleSensor
@@ -83,6 +90,7 @@ namespace scone
 		MuscleSpindleSensor2( const Muscle& m, double kv, double l0 ) : MuscleSensor( m ), kv_( kv ), l0_( l0 ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 		double kv_, l0_;
 	};
 
@@ -91,6 +99,7 @@ namespace scone
 		MuscleExcitationSensor( const Muscle& m ) : MuscleSensor( m ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Time; }
 	};
 
 	struct SCONE_API MuscleActivationSensor : public MuscleSensor
@@ -98,6 +107,7 @@ namespace scone
 		MuscleActivationSensor( const Muscle& m ) : MuscleSensor( m ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Time; }
 	};
 
 	// Base struct for dof sensors
@@ -113,6 +123,7 @@ namespace scone
 		DofPositionSensor( const Dof& dof, const Dof* root_dof = nullptr ) : DofSensor( dof, root_dof ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Position; }
 	};
 
 	struct SCONE_API DofVelocitySensor : public DofSensor
@@ -121,6 +132,7 @@ namespace scone
 
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Velocity; }
 	};
 
 	struct SCONE_API DofPosVelSensor : public DofSensor
@@ -129,6 +141,7 @@ namespace scone
 			DofSensor( dof, root_dof ), kv_( kv ), side_( side ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Velocity; }
 		double kv_;
 		Side side_;
 	};
@@ -140,6 +153,7 @@ namespace scone
 
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Dynamics; }
 		const Leg& leg_;
 	};
 
@@ -157,6 +171,7 @@ namespace scone
 		BodyPointPositionSensor( const Body& body, Vec3 ofs, Vec3 dir ) : BodyPointSensor( body, ofs, dir ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Position; }
 	};
 
 	struct SCONE_API BodyPointVelocitySensor : public BodyPointSensor
@@ -164,6 +179,7 @@ namespace scone
 		BodyPointVelocitySensor( const Body& body, Vec3 ofs, Vec3 dir ) : BodyPointSensor( body, ofs, dir ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Velocity; }
 	};
 
 	struct SCONE_API BodyPointAccelerationSensor : public BodyPointSensor
@@ -171,6 +187,7 @@ namespace scone
 		BodyPointAccelerationSensor( const Body& body, Vec3 ofs, Vec3 dir ) : BodyPointSensor( body, ofs, dir ) {}
 		virtual String GetName() const override;
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Acceleration; }
 	};
 
 	struct SCONE_API BodyOrientationSensor : public Sensor
@@ -178,6 +195,7 @@ namespace scone
 		BodyOrientationSensor( const Body& body, const Vec3& dir, const String& postfix, Side side );
 		virtual String GetName() const override { return name_; }
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Position; }
 		const Body& body_;
 		const Vec3 dir_;
 		const String name_;
@@ -188,6 +206,7 @@ namespace scone
 		BodyAngularVelocitySensor( const Body& body, const Vec3& dir, const String& postfix, Side side );
 		virtual String GetName() const override { return name_; }
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Velocity; }
 		const Body& body_;
 		const Vec3 dir_;
 		const String name_;
@@ -198,6 +217,7 @@ namespace scone
 		BodyOriVelSensor( const Body& body, const Vec3& dir, double kv, const String& postfix, Side side, double target = 0.0 );
 		virtual String GetName() const override { return name_; }
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Velocity; }
 		const Body& body_;
 		const double kv_;
 		const Vec3 dir_;
@@ -211,6 +231,7 @@ namespace scone
 		ComBosSensor( const Model& mod, const Vec3& dir, double kv, const String& name, Side side );
 		virtual String GetName() const override { return name_; }
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return SensorStage::Velocity; }
 		const Model& model_;
 		const double kv_;
 		const Vec3 dir_;
@@ -222,6 +243,7 @@ namespace scone
 		ModulatedSensor( const Sensor& sensor, const Sensor& modulator, double gain, double ofs, const String& name, xo::boundsd mod_range = { 0.0, 1.0 } );
 		virtual String GetName() const override { return name_; }
 		virtual Real GetValue() const override;
+		virtual SensorStage GetStage() const override { return std::max( sensor_.GetStage(), modulator_.GetStage() ); }
 		const Sensor& sensor_;
 		const Sensor& modulator_;
 		double gain_;
@@ -0,0 +1,476 @@
+/*
+** AsyncCmaOptimizer.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "AsyncCmaOptimizer.h"
+
+#include "ModelObjective.h"
+#include "scone/core/Exception.h"
+#include "scone/core/Log.h"
+#include "scone/core/Settings.h"
+#include "xo/string/string_tools.h"
+#include "xo/thread/thread_priority.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <optional>
+#include <thread>
+
+namespace scone
+{
+	namespace
+	{
+		// maximum number of distribution updates during the computation of an eigen decomposition
+		constexpr size_t max_eigen_lag = 2;
+
+		// eigen decomposition of symmetric matrix a (row-major) using cyclic Jacobi rotations
+		// eigenvectors are stored in the columns of v, a is overwritten
+		void jacobi_eigen( std::vector< double >& a, std::vector< double >& v, std::vector< double >& eigenvalues, size_t n )
+		{
+			v.assign( n * n, 0.0 );
+			for ( index_t i = 0; i < n; ++i )
+				v[ i * n + i ] = 1.0;
+
+			for ( int sweep = 0; sweep < 50; ++sweep )
+			{
+				double off_diag = 0.0;
+				for ( index_t p = 0; p < n; ++p )
+					for ( index_t q = p + 1; q < n; ++q )
+						off_diag += a[ p * n + q ] * a[ p * n + q ];
+				if ( off_diag < 1e-30 )
+					break;
+
+				for ( index_t p = 0; p < n; ++p )
+				{
+					for ( index_t q = p + 1; q < n; ++q )
+					{
+						auto apq = a[ p * n + q ];
+						if ( std::abs( apq ) < 1e-300 )
+							continue;
+						auto theta = ( a[ q * n + q ] - a[ p * n + p ] ) / ( 2 * apq );
+						auto t = ( theta >= 0 ? 1.0 : -1.0 ) / ( std::abs( theta ) + std::sqrt( theta * theta + 1 ) );
+						auto c = 1 / std::sqrt( t * t + 1 );
+						auto s = t * c;
+						for ( index_t k = 0; k < n; ++k )
+						{
+							auto akp = a[ k * n + p ], akq = a[ k * n + q ];
+							a[ k * n + p ] = c * akp - s * akq;
+							a[ k * n + q ] = s * akp + c * akq;
+						}
+						for ( index_t k = 0; k < n; ++k )
+						{
+							auto apk = a[ p * n + k ], aqk = a[ q * n + k ];
+							a[ p * n + k ] = c * apk - s * aqk;
+							a[ q * n + k ] = s * apk + c * aqk;
+						}
+						for ( index_t k = 0; k < n; ++k )
+						{
+							auto vkp = v[ k * n + p ], vkq = v[ k * n + q ];
+							v[ k * n + p ] = c * vkp - s * vkq;
+							v[ k * n + q ] = s * vkp + c * vkq;
+						}
+					}
+				}
+			}
+
+			eigenvalues.resize( n );
+			for ( index_t i = 0; i < n; ++i )
+				eigenvalues[ i ] = a[ i * n + i ];
+		}
+
+		// least-squares line through a series of values, returns the value at the last sample and the slope
+		std::pair< double, double > linear_trend( const std::deque< double >& values )
+		{
+			auto n = values.size();
+			if ( n < 2 )
+				return { n > 0 ? values.back() : 0.0, 0.0 };
+			double xm = 0.5 * ( n - 1 );
+			double ym = std::accumulate( values.begin(), values.end(), 0.0 ) / n;
+			double sxy = 0.0, sxx = 0.0;
+			for ( index_t i = 0; i < n; ++i )
+			{
+				sxy += ( i - xm ) * ( values[ i ] - ym );
+				sxx += ( i - xm ) * ( i - xm );
+			}
+			auto slope = sxy / sxx;
+			return { ym + slope * ( n - 1 - xm ), slope };
+		}
+	}
+
+	AsyncCmaOptimizer::AsyncCmaOptimizer( const PropNode& pn, const PropNode& scenario_pn, const path& scenario_dir ) :
+		CmaOptimizer( pn, scenario_pn, scenario_dir ),
+		dim_( GetObjective().dim() ),
+		step_size_( sigma_ ),
+		eigen_update_count_( 0 ),
+		eigen_update_busy_( false ),
+		eigen_input_update_( 0 ),
+		rng_( random_seed ),
+		interrupted_( false ),
+		update_count_( 0 ),
+		best_fitness_( GetObjective().info().worst_fitness() ),
+		new_best_( false ),
+		last_output_fitness_( GetObjective().info().worst_fitness() ),
+		number_of_evaluations_( 0 ),
+		stale_results_( 0 )
+	{
+		SCONE_ASSERT( dim_ > 0 );
+
+		// default CMA-ES settings
+		auto n = double( dim_ );
+		if ( lambda_ <= 0 )
+			lambda_ = 4 + int( 3 * std::log( n ) );
+		if ( mu_ <= 0 )
+			mu_ = lambda_ / 2;
+		SCONE_ERROR_IF( mu_ < 1 || mu_ > lambda_, "Invalid value for mu, must be between 1 and lambda" );
+
+		for ( int i = 0; i < mu_; ++i )
+			weights_.push_back( std::log( mu_ + 0.5 ) - std::log( i + 1.0 ) );
+		auto wsum = std::accumulate( weights_.begin(), weights_.end(), 0.0 );
+		for ( auto& w : weights_ )
+			w /= wsum;
+		mueff_ = 1.0 / std::inner_product( weights_.begin(), weights_.end(), weights_.begin(), 0.0 );
+
+		cc_ = ( 4 + mueff_ / n ) / ( n + 4 + 2 * mueff_ / n );
+		cs_ = ( mueff_ + 2 ) / ( n + mueff_ + 5 );
+		c1_ = 2 / ( ( n + 1.3 ) * ( n + 1.3 ) + mueff_ );
+		cmu_ = std::min( 1 - c1_, 2 * ( mueff_ - 2 + 1 / mueff_ ) / ( ( n + 2 ) * ( n + 2 ) + mueff_ ) );
+		damps_ = 1 + 2 * std::max( 0.0, std::sqrt( ( mueff_ - 1 ) / ( n + 1 ) ) - 1 ) + cs_;
+		chi_n_ = std::sqrt( n ) * ( 1 - 1 / ( 4 * n ) + 1 / ( 21 * n * n ) );
+
+		// initial distribution is centered at the parameter means, scaled by the parameter std
+		mean_.assign( dim_, 0.0 );
+		pc_.assign( dim_, 0.0 );
+		ps_.assign( dim_, 0.0 );
+		C_.assign( dim_ * dim_, 0.0 );
+		for ( index_t i = 0; i < dim_; ++i )
+			C_[ i * dim_ + i ] = 1.0;
+		eigen_ = std::make_shared< EigenSystem >( EigenSystem{ C_, std::vector< double >( dim_, 1.0 ) } );
+
+		// samples of different updates are evaluated at the same time, so there are no generations to base cutoffs and seeds on
+		if ( auto* mo = dynamic_cast<ModelObjective*>( &GetObjective() ) )
+		{
+			if ( mo->early_termination )
+			{
+				log::warning( "early_termination is not supported by AsyncCmaOptimizer and will be disabled" );
+				mo->early_termination = false;
+			}
+			if ( mo->rollouts > 1 )
+				log::warning( "AsyncCmaOptimizer uses the same rollout seeds for all evaluations" );
+		}
+	}
+
+	void AsyncCmaOptimizer::Run()
+	{
+		// create output folder
+		PrepareOutputFolder();
+
+		auto thread_count = std::max< size_t >( 1, std::min< size_t >( max_threads, GetSconeSetting<int>( "optimizer.max_threads" ) ) );
+		log::info( "Starting optimization ", id(), " dim=", dim_, " lambda=", lambda_, " mu=", mu_, " threads=", thread_count );
+		if ( GetStatusOutput() )
+		{
+			PropNode pn = GetStatusPropNode();
+			pn.set( "folder", GetOutputFolder() );
+			pn.set( "dim", dim_ );
+			pn.set( "sigma", step_size_ );
+			pn.set( "lambda", lambda_ );
+			pn.set( "mu", mu_ );
+			pn.set( "threads", thread_count );
+			pn.set( "max_generations", max_generations );
+			pn.set( "minimize", IsMinimizing() );
+			pn.set( "window_size", window_size );
+			OutputStatus( std::move( pn ) );
+		}
+
+		// evaluation threads run until a stop condition is met or the optimization is interrupted
+		busy_time_ = std::vector< std::atomic< double > >( thread_count );
+		timer_.restart();
+		std::vector< std::thread > threads;
+		for ( index_t i = 0; i < thread_count; ++i )
+			threads.emplace_back( &AsyncCmaOptimizer::WorkerThread, this, i );
+		for ( auto& t : threads )
+			t.join();
+
+		if ( !best_y_.empty() && best_fitness_ != last_output_fitness_ )
+			WriteResult( best_y_, update_count_, median_history_.empty() ? best_fitness_.load() : median_history_.back(), best_fitness_ );
+
+		log::debug( stale_results_, " of ", number_of_evaluations_, " results were drawn more than one update ago" );
+		auto message = stop_message_.empty() ? String( "Optimization interrupted" ) : stop_message_;
+		if ( GetStatusOutput() )
+			OutputStatus( "finished", message );
+		log::info( "Optimization ", id(), " finished: ", message );
+	}
+
+	void AsyncCmaOptimizer::WorkerThread( index_t thread_idx )
+	{
+		xo::scoped_thread_priority prio( static_cast<xo::thread_priority>( GetSconeSetting<int>( "optimizer.thread_priority" ) ) );
+		try
+		{
+			while ( !interrupted_ )
+			{
+				auto s = CreateSample();
+
+				auto t = timer_().seconds();
+				auto result = GetObjective().evaluate( ToSearchPoint( s.y ), xo::stop_token() );
+				s.fitness = result ? result.value() : GetObjective().info().worst_fitness();
+				busy_time_[ thread_idx ] = busy_time_[ thread_idx ] + ( timer_().seconds() - t );
+
+				AddResult( std::move( s ) );
+			}
+		}
+		catch ( std::exception& e )
+		{
+			log::error( "Error in optimization ", id(), ": ", e.what() );
+			std::scoped_lock lock( mutex_ );
+			if ( stop_message_.empty() )
+				stop_message_ = e.what();
+			interrupted_ = true;
+		}
+	}
+
+	AsyncCmaOptimizer::Sample AsyncCmaOptimizer::CreateSample()
+	{
+		// copy the distribution and draw z under the lock, the matrix products are computed outside
+		const auto n = dim_;
+		Sample s;
+		s_ptr< const EigenSystem > eigen;
+		double sigma;
+		std::vector< double > z( n );
+		{
+			std::scoped_lock lock( mutex_ );
+			s.y = mean_;
+			s.update = update_count_;
+			sigma = step_size_;
+			eigen = eigen_;
+			std::normal_distribution< double > normal;
+			for ( auto& zi : z )
+				zi = normal( rng_ );
+		}
+
+		// y = mean + sigma * B * D * z, clamped to the parameter bounds
+		// step is updated after clamping, bz is not, which slightly overestimates the path length near the bounds
+		const auto& info = GetObjective().info();
+		const auto& B = eigen->B;
+		const auto& D = eigen->D;
+		s.step.assign( n, 0.0 );
+		s.bz.assign( n, 0.0 );
+		for ( index_t i = 0; i < n; ++i )
+		{
+			for ( index_t j = 0; j < n; ++j )
+			{
+				s.bz[ i ] += B[ i * n + j ] * z[ j ];
+				s.step[ i ] += B[ i * n + j ] * D[ j ] * z[ j ];
+			}
+			auto y = s.y[ i ] + sigma * s.step[ i ];
+			if ( info[ i ].std > 0 )
+				y = std::clamp( y, ( info[ i ].min - info[ i ].mean ) / info[ i ].std, ( info[ i ].max - info[ i ].mean ) / info[ i ].std );
+			s.step[ i ] = ( y - s.y[ i ] ) / sigma;
+			s.y[ i ] = y;
+		}
+		s.fitness = info.worst_fitness();
+		return s;
+	}
+
+	SearchPoint AsyncCmaOptimizer::ToSearchPoint( const std::vector< double >& y ) const
+	{
+		const auto& info = GetObjective().info();
+		spot::par_vec values( dim_ );
+		for ( index_t i = 0; i < dim_; ++i )
+			values[ i ] = info[ i ].mean + info[ i ].std * y[ i ];
+		return SearchPoint( info, values );
+	}
+
+	void AsyncCmaOptimizer::AddResult( Sample&& s )
+	{
+		std::optional< UpdateReport > report;
+		std::vector< double > eigen_input;
+		{
+			std::scoped_lock lock( mutex_ );
+			++number_of_evaluations_;
+			if ( IsBetter( s.fitness, best_fitness_ ) )
+			{
+				best_fitness_ = s.fitness;
+				best_y_ = s.y;
+				new_best_ = true;
+			}
+
+			// results drawn more than one update ago are too far from the current distribution
+			if ( s.update + 1 >= update_count_ )
+				results_.push_back( std::move( s ) );
+			else ++stale_results_;
+
+			// updates wait if the decomposition that is being computed falls too far behind
+			bool eigen_lagging = eigen_update_busy_ && update_count_ >= eigen_input_update_ + max_eigen_lag;
+			if ( results_.size() >= size_t( lambda_ ) && !interrupted_ && !eigen_lagging )
+			{
+				report = UpdateDistribution();
+
+				// the decomposition of a copy of C is computed outside the lock, until then samples use the previous one
+				if ( !eigen_update_busy_ && update_count_ - eigen_update_count_ > 1 / ( c1_ + cmu_ ) / dim_ / 10 )
+				{
+					eigen_update_busy_ = true;
+					eigen_input = C_;
+					eigen_input_update_ = update_count_;
+				}
+			}
+		}
+
+		// file and status output are also done outside the lock
+		if ( !eigen_input.empty() )
+			UpdateEigenDecomposition( std::move( eigen_input ) );
+		if ( report )
+			ReportUpdate( *report );
+	}
+
+	AsyncCmaOptimizer::UpdateReport AsyncCmaOptimizer::UpdateDistribution()
+	{
+		// rank the results that came in since the last update, which can be more than lambda if the update had to wait
+		auto results = std::move( results_ );
+		results_.clear();
+		std::sort( results.begin(), results.end(), [&]( const Sample& a, const Sample& b ) { return IsBetter( a.fitness, b.fitness ); } );
+
+		// weighted steps of the best mu samples, relative to the distribution each was drawn from
+		const auto n = dim_;
+		std::vector< double > dm( n, 0.0 ), dbz( n, 0.0 ), new_mean( n, 0.0 );
+		for ( index_t k = 0; k < size_t( mu_ ); ++k )
+		{
+			for ( index_t i = 0; i < n; ++i )
+			{
+				dm[ i ] += weights_[ k ] * results[ k ].step[ i ];
+				dbz[ i ] += weights_[ k ] * results[ k ].bz[ i ];
+				new_mean[ i ] += weights_[ k ] * results[ k ].y[ i ];
+			}
+		}
+
+		// the mean moves to the weighted recombination of the selected points, which is mean + sigma * dm for results of the current distribution
+		mean_ = std::move( new_mean );
+
+		// evolution paths, where dbz = C^(-1/2) * dm for the distributions the results were drawn from
+		auto ps_factor = std::sqrt( cs_ * ( 2 - cs_ ) * mueff_ );
+		for ( index_t i = 0; i < n; ++i )
+			ps_[ i ] = ( 1 - cs_ ) * ps_[ i ] + ps_factor * dbz[ i ];
+		auto ps_norm = std::sqrt( std::inner_product( ps_.begin(), ps_.end(), ps_.begin(), 0.0 ) );
+		auto generation = double( update_count_ + 1 );
+		bool hsig = ps_norm / std::sqrt( 1 - std::pow( 1 - cs_, 2 * generation ) ) / chi_n_ < 1.4 + 2 / ( n + 1.0 );
+		auto pc_factor = hsig * std::sqrt( cc_ * ( 2 - cc_ ) * mueff_ );
+		for ( index_t i = 0; i < n; ++i )
+			pc_[ i ] = ( 1 - cc_ ) * pc_[ i ] + pc_factor * dm[ i ];
+
+		// rank-one and rank-mu update of the covariance matrix
+		auto c_keep = 1 - c1_ - cmu_ + c1_ * ( 1 - hsig ) * cc_ * ( 2 - cc_ );
+		for ( index_t i = 0; i < n; ++i )
+		{
+			for ( index_t j = 0; j <= i; ++j )
+			{
+				double rank_mu = 0.0;
+				for ( index_t k = 0; k < size_t( mu_ ); ++k )
+					rank_mu += weights_[ k ] * results[ k ].step[ i ] * results[ k ].step[ j ];
+				C_[ i * n + j ] = C_[ j * n + i ] = c_keep * C_[ i * n + j ] + c1_ * pc_[ i ] * pc_[ j ] + cmu_ * rank_mu;
+			}
+		}
+		step_size_ *= std::exp( ( cs_ / damps_ ) * ( ps_norm / chi_n_ - 1 ) );
+		++update_count_;
+
+		// stop conditions
+		median_history_.push_back( results[ results.size() / 2 ].fitness );
+		while ( median_history_.size() > window_size )
+			median_history_.pop_front();
+		auto [trend_offset, trend_slope] = linear_trend( median_history_ );
+		auto progress = ( IsMinimizing() ? -trend_slope : trend_slope ) / std::max( std::abs( trend_offset ), 1e-12 );
+		if ( update_count_ >= max_generations )
+			stop_message_ = "Maximum number of generations reached";
+		else if ( median_history_.size() >= std::min( min_progress_samples, window_size ) && progress < min_progress )
+			stop_message_ = "Minimum progress reached";
+		else if ( std::abs( results.front().fitness - results[ mu_ - 1 ].fitness ) < flat_fitness_epsilon_ )
+			stop_message_ = "Flat fitness";
+		if ( !stop_message_.empty() )
+			interrupted_ = true;
+
+		// collect the status, which is reported after the lock is released
+		UpdateReport r;
+		r.step = update_count_;
+		r.step_best = results.front().fitness;
+		r.step_median = median_history_.back();
+		r.best_fitness = best_fitness_;
+		r.trend_offset = trend_offset;
+		r.trend_slope = trend_slope;
+		r.number_of_evaluations = number_of_evaluations_;
+		r.new_best = new_best_;
+		new_best_ = false;
+
+		// write results when there is enough improvement, or when it has been too long
+		auto improvement = std::abs( best_fitness_ - last_output_fitness_ ) / std::max( std::abs( last_output_fitness_ ), 1e-12 );
+		if ( r.new_best && ( improvement >= min_improvement_for_file_output || r.step - m_LastFileOutputGen >= max_generations_without_file_output ) )
+		{
+			r.write_y = best_y_;
+			m_LastFileOutputGen = r.step;
+			last_output_fitness_ = best_fitness_;
+		}
+		return r;
+	}
+
+	void AsyncCmaOptimizer::UpdateEigenDecomposition( std::vector< double > C )
+	{
+		auto eigen = std::make_shared< EigenSystem >();
+		std::vector< double > eigenvalues;
+		jacobi_eigen( C, eigen->B, eigenvalues, dim_ );
+		eigen->D.resize( dim_ );
+		for ( index_t i = 0; i < dim_; ++i )
+			eigen->D[ i ] = std::sqrt( std::max( eigenvalues[ i ], 1e-20 ) );
+
+		std::scoped_lock lock( mutex_ );
+		eigen_ = std::move( eigen );
+		eigen_update_count_ = eigen_input_update_;
+		eigen_update_busy_ = false;
+	}
+
+	void AsyncCmaOptimizer::ReportUpdate( const UpdateReport& r )
+	{
+		auto t = timer_().seconds();
+		std::vector< double > utilization;
+		for ( auto& busy : busy_time_ )
+			utilization.push_back( t > 0 ? busy / t : 0.0 );
+		auto avg_utilization = std::accumulate( utilization.begin(), utilization.end(), 0.0 ) / utilization.size();
+
+		if ( output_mode_ == console_output )
+			log::info( xo::stringf( "%5d\t%10.4f\t%10.4f\t%10.4f\t%5.1f%%", int( r.step ), r.step_best, r.step_median, r.best_fitness, 100 * avg_utilization ) );
+		else if ( GetStatusOutput() )
+		{
+			auto pn = GetStatusPropNode();
+			pn.set( "step", r.step );
+			pn.set( "step_best", r.step_best );
+			pn.set( "step_median", r.step_median );
+			pn.set( "trend_offset", r.trend_offset );
+			pn.set( "trend_slope", r.trend_slope );
+			pn.set( "predicted_fitness", r.trend_offset + r.trend_slope * window_size );
+			pn.set( "time", t );
+			pn.set( "number_of_evaluations", r.number_of_evaluations );
+			pn.set( "evaluations_per_sec", r.number_of_evaluations / t );
+			pn.set( "utilization", avg_utilization );
+			auto& upn = pn.add_child( "thread_utilization" );
+			for ( index_t i = 0; i < utilization.size(); ++i )
+				upn.set( xo::to_str( i ), utilization[ i ] );
+			if ( r.new_best )
+			{
+				pn.set( "best", r.best_fitness );
+				pn.set( "best_gen", r.step );
+			}
+			OutputStatus( std::move( pn ) );
+		}
+
+		if ( !r.write_y.empty() )
+			WriteResult( r.write_y, r.step, r.step_median, r.best_fitness );
+	}
+
+	void AsyncCmaOptimizer::WriteResult( const std::vector< double >& y, size_t step, double median, double best )
+	{
+		auto file_base = GetOutputFolder() / xo::stringf( "%04d_%.3f_%.3f", int( step ), median, best );
+		std::ofstream str( file_base.str() + ".par" );
+		str << ToSearchPoint( y );
+	}
+}
@@ -0,0 +1,111 @@
+/*
+** AsyncCmaOptimizer.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "CmaOptimizer.h"
+#include "xo/time/timer.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace scone
+{
+	/// Asynchronous steady-state variant of CMA-ES, in which evaluation threads continuously sample from the current distribution.
+	/** Instead of waiting for a full generation to finish, the distribution is updated each time ''lambda'' results have come in.
+	This prevents threads from being idle when evaluations differ in duration, e.g. when simulations terminate early after a fall.
+	Results are used relative to the distribution they were drawn from; results drawn more than one update ago only count for the best result.
+	Because there are no generations, ''early_termination'' is disabled and rollouts use the same seeds throughout the optimization.
+	The status output includes the utilization of each evaluation thread. */
+	class SCONE_API AsyncCmaOptimizer : public CmaOptimizer
+	{
+	public:
+		AsyncCmaOptimizer( const PropNode& pn, const PropNode& scenario_pn, const path& scenario_dir );
+		virtual ~AsyncCmaOptimizer() {}
+
+		virtual void Run() override;
+		virtual void Interrupt() override { interrupted_ = true; }
+		virtual double GetBestFitness() const override { return best_fitness_.load(); }
+
+		/// Number of distribution updates, equivalent to the generation count of CmaOptimizer.
+		size_t GetUpdateCount() const { return update_count_; }
+
+	private:
+		struct Sample
+		{
+			std::vector< double > y; // normalized parameter values, relative to the initial mean and std
+			std::vector< double > step; // ( y - mean ) / sigma of the distribution the sample was drawn from
+			std::vector< double > bz; // B * z of the distribution the sample was drawn from, which equals C^(-1/2) * step
+			size_t update; // number of distribution updates when the sample was drawn
+			double fitness;
+		};
+
+		// eigen decomposition of the covariance matrix, which is replaced as a whole after each decomposition
+		struct EigenSystem
+		{
+			std::vector< double > B, D; // eigenvectors (columns) and sqrt of eigenvalues
+		};
+
+		// results of a distribution update, which are reported after the lock is released
+		struct UpdateReport
+		{
+			size_t step;
+			double step_best, step_median, best_fitness, trend_offset, trend_slope;
+			size_t number_of_evaluations;
+			bool new_best;
+			std::vector< double > write_y; // parameters to write to file, empty if there is nothing to write
+		};
+
+		void WorkerThread( index_t thread_idx );
+		Sample CreateSample();
+		void AddResult( Sample&& s );
+		UpdateReport UpdateDistribution();
+		void UpdateEigenDecomposition( std::vector< double > C );
+		void ReportUpdate( const UpdateReport& r );
+		void WriteResult( const std::vector< double >& y, size_t step, double median, double best );
+		bool IsBetter( double a, double b ) const { return IsMinimizing() ? a < b : a > b; }
+		SearchPoint ToSearchPoint( const std::vector< double >& y ) const;
+
+		// distribution, in normalized coordinates, protected by mutex_
+		size_t dim_;
+		std::vector< double > weights_;
+		double mueff_, cc_, cs_, c1_, cmu_, damps_, chi_n_;
+		std::vector< double > mean_, pc_, ps_;
+		std::vector< double > C_; // covariance
+		s_ptr< const EigenSystem > eigen_; // decomposition of an earlier C_, samples keep their own copy while they are drawn
+		double step_size_;
+		size_t eigen_update_count_; // update count of the C_ from which eigen_ was computed
+		bool eigen_update_busy_; // the decomposition is computed outside the lock, by one thread at a time
+		size_t eigen_input_update_; // update count of the C_ of which the decomposition is being computed
+		std::mt19937_64 rng_;
+
+		// results that are waiting for the next update
+		std::vector< Sample > results_;
+		std::mutex mutex_;
+
+		// progress
+		std::atomic< bool > interrupted_;
+		std::atomic< size_t > update_count_;
+		String stop_message_;
+		std::atomic< double > best_fitness_;
+		std::vector< double > best_y_;
+		bool new_best_; // a new best was found since the last update
+		double last_output_fitness_;
+		std::deque< double > median_history_;
+		size_t number_of_evaluations_;
+		size_t stale_results_; // results that were drawn more than one update ago and are not used for updates
+
+		// thread utilization
+		std::vector< std::atomic< double > > busy_time_;
+		xo::timer timer_;
+	};
+}
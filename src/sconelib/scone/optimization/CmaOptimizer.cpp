@@ -14,8 +14,8 @@ namespace scone
 {
 	const long DEFAULT_RANDOM_SEED = 123;
 
-	CmaOptimizer::CmaOptimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir ) :
-		Optimizer( props, scenario_pn, scenario_dir ),
+	CmaOptimizer::CmaOptimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir, s_ptr< Objective > shared_objective ) :
+		Optimizer( props, scenario_pn, scenario_dir, std::move( shared_objective ) ),
 		mu_( 0 ),
 		lambda_( 0 ),
 		sigma_( 1.0 ),
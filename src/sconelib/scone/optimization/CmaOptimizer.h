@@ -18,7 +18,7 @@ namespace scone
 	class SCONE_API CmaOptimizer : public Optimizer
 	{
 	public:
-		CmaOptimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir );
+		CmaOptimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir, s_ptr< Objective > shared_objective = nullptr );
 		CmaOptimizer( const CmaOptimizer& ) = delete;
 		CmaOptimizer& operator=( const CmaOptimizer& ) = delete;
 		virtual ~CmaOptimizer();
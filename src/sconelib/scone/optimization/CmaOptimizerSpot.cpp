@@ -15,14 +15,16 @@
 #include "scone/core/Exception.h"
 #include "scone/core/Log.h"
 #include "scone/core/Settings.h"
+#include "StatusChannel.h"
+#include "ProcessEvaluator.h"
 #include "spot/async_evaluator.h"	
 #include "spot/pooled_evaluator.h"
 #include "spot/batch_evaluator.h"
 
 namespace scone
 {
-	CmaOptimizerSpot::CmaOptimizerSpot( const PropNode& pn, const PropNode& scenario_pn, const path& scenario_dir ) :
-		CmaOptimizer( pn, scenario_pn, scenario_dir ),
+	CmaOptimizerSpot::CmaOptimizerSpot( const PropNode& pn, const PropNode& scenario_pn, const path& scenario_dir, s_ptr< Objective > shared_objective ) :
+		CmaOptimizer( pn, scenario_pn, scenario_dir, std::move( shared_objective ) ),
 		cma_optimizer( *m_Objective, GetEvaluator(),
 			spot::cma_options{
 				CmaOptimizer::lambda_,
@@ -31,7 +33,8 @@ namespace scone
 				pn.get<double>( "update_eigen_modulo", -1.0 )
 			}
 		),
-		INIT_MEMBER( pn, max_errors, max_errors_ )
+		INIT_MEMBER( pn, max_errors, max_errors_ ),
+		process_evaluator_( nullptr )
 	{
 		SCONE_ASSERT( GetObjective().dim()  > 0 );
 
@@ -46,10 +49,26 @@ namespace scone
 
 		enable_fitness_tracking( window_size );
 
+		// worker processes create their own objective from the scenario
+		process_evaluator_ = dynamic_cast<ProcessEvaluator*>( &GetEvaluator() );
+		if ( process_evaluator_ )
+			process_evaluator_->AddScenario( *m_Objective, scenario_pn, scenario_dir );
+
 		// stop conditions
 		add_stop_condition( std::make_unique< spot::max_steps_condition >( max_generations ) );
 		add_stop_condition( std::make_unique< spot::min_progress_condition >( min_progress, min_progress_samples ) );
 		find_stop_condition< spot::flat_fitness_condition >().epsilon_ = flat_fitness_epsilon_;
+
+		// early termination and rollouts require the objective to know the generation boundaries
+		if ( auto* mo = dynamic_cast<ModelObjective*>( m_Objective.get() ); mo && mo->UsesGenerations() )
+			add_reporter( std::make_unique< EarlyTerminationReporter >( *mo, process_evaluator_ ) );
+	}
+
+	CmaOptimizerSpot::~CmaOptimizerSpot()
+	{
+		// release the objective in the worker processes
+		if ( process_evaluator_ )
+			process_evaluator_->RemoveScenario( *m_Objective );
 	}
 
 	void CmaOptimizerSpot::SetOutputMode( OutputMode m )
@@ -110,6 +129,14 @@ namespace scone
 			pooled_eval.set_max_threads( max_threads, thread_prio );
 			return pooled_eval;
 		}
+		else if ( eval == 4 )
+		{
+			auto numa_nodes = GetSconeSetting<int>( "optimizer.numa_nodes" );
+			static ProcessEvaluator process_eval( max_threads, numa_nodes );
+			process_eval.SetWorkerCount( max_threads, numa_nodes );
+			process_eval.evaluation_timeout = GetSconeSetting<double>( "optimizer.worker_timeout" );
+			return process_eval;
+		}
 		else SCONE_THROW( "Invalid evaluator setting" );
 	}
 
@@ -118,7 +145,29 @@ namespace scone
 		auto& cma = dynamic_cast<const CmaOptimizerSpot&>( opt );
 
 		log::info( "Starting optimization ", cma.id(), " dim=", cma.dim(), " lambda=", cma.lambda(), " mu=", cma.mu() );
-		if ( cma.GetStatusOutput() )
+		// all status updates are sent as text if the id or folder don't fit, so they arrive after the start message
+		StatusRecord r;
+		status_channel_ = nullptr;
+		if ( auto& channel = cma.GetStatusChannel() )
+		{
+			if ( r.SetId( cma.id() ) && r.SetText( cma.GetOutputFolder().str() ) )
+				status_channel_ = channel.get();
+			else log::debug( "Output folder does not fit in status record, sending status as text: ", cma.GetOutputFolder() );
+		}
+
+		if ( status_channel_ )
+		{
+			r.type = StatusRecord::Start;
+			r.flags = cma.IsMinimizing() ? StatusRecord::Minimize : 0;
+			r.dim = cma.dim();
+			r.sigma = cma.sigma();
+			r.lambda = cma.lambda();
+			r.mu = cma.mu();
+			r.max_generations = cma.max_generations;
+			r.window_size = cma.window_size;
+			status_channel_->Write( r );
+		}
+		else if ( cma.GetStatusOutput() )
 		{
 			PropNode pn = cma.GetStatusPropNode();
 			pn.set( "folder", cma.GetOutputFolder() );
@@ -139,7 +188,12 @@ namespace scone
 	void CmaOptimizerReporter::on_stop( const optimizer& opt, const spot::stop_condition& s )
 	{
 		auto& cma = dynamic_cast<const CmaOptimizerSpot&>( opt );
-		cma.OutputStatus( "finished", s.what() );
+		StatusRecord r;
+		r.type = StatusRecord::Finished;
+		r.SetId( cma.id() );
+		if ( status_channel_ && r.SetText( s.what() ) )
+			status_channel_->Write( r );
+		else cma.OutputStatus( "finished", s.what() ); // text messages are read after the status records
 		log::info( "Optimization ", cma.id(), " finished: ", s.what() );
 	}
 
@@ -148,6 +202,20 @@ namespace scone
 		auto& cma = dynamic_cast<const CmaOptimizerSpot&>( opt );
 	}
 
+	void EarlyTerminationReporter::on_stop( const optimizer& opt, const spot::stop_condition& s )
+	{
+		if ( objective_.early_termination )
+			log::info( "Early termination stopped ", objective_.GetTruncatedEvaluationCount(), " evaluations" );
+	}
+
+	void EarlyTerminationReporter::on_pre_evaluate_population( const optimizer& opt, const search_point_vec& pop )
+	{
+		auto& cma = dynamic_cast<const CmaOptimizerSpot&>( opt );
+		objective_.BeginGeneration( cma.mu() );
+		if ( process_evaluator_ )
+			process_evaluator_->BeginGeneration( objective_, cma.mu(), objective_.GetRolloutSeedOffset() );
+	}
+
 	void CmaOptimizerReporter::on_post_evaluate_population( const optimizer& opt, const search_point_vec& pop, const fitness_vec& fitnesses, bool new_best )
 	{
 		auto& cma = dynamic_cast<const CmaOptimizerSpot&>( opt );
@@ -156,6 +224,27 @@ namespace scone
 		auto t = timer_().seconds();
 
 		// report results
+		if ( status_channel_ )
+		{
+			StatusRecord r;
+			r.type = StatusRecord::Generation;
+			r.flags = new_best ? StatusRecord::NewBest : 0;
+			r.SetId( cma.id() );
+			r.step = cma.current_step();
+			r.step_best = cma.current_step_best_fitness();
+			r.step_median = xo::median( cma.current_step_fitnesses() );
+			r.trend_offset = cma.fitness_trend().offset();
+			r.trend_slope = cma.fitness_trend().slope();
+			r.progress = cma.progress();
+			r.predicted_fitness = cma.predicted_fitness( cma.fitness_tracking_window_size() );
+			r.time = t;
+			r.number_of_evaluations = number_of_evaluations_;
+			r.evaluations_per_sec = number_of_evaluations_ / t;
+			r.best = cma.best_fitness();
+			status_channel_->Write( r );
+			return;
+		}
+
 		auto pn = cma.GetStatusPropNode();
 		pn.set( "step", cma.current_step() );
 		pn.set( "step_best", cma.current_step_best_fitness() );
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "CmaOptimizer.h"
+#include "ModelObjective.h"
 #include "spot/cma_optimizer.h"
 #include "spot/reporter.h"
 #include "xo/system/log_sink.h"
@@ -16,6 +17,8 @@
 
 namespace scone
 {
+	class ProcessEvaluator;
+
 	using spot::optimizer;
 	using spot::search_point;
 	using spot::search_point_vec;
@@ -26,15 +29,19 @@ namespace scone
 	class SCONE_API CmaOptimizerSpot : public CmaOptimizer, public spot::cma_optimizer
 	{
 	public:
-		CmaOptimizerSpot( const PropNode& pn, const PropNode& scenario_pn, const path& scenario_dir );
+		CmaOptimizerSpot( const PropNode& pn, const PropNode& scenario_pn, const path& scenario_dir, s_ptr< Objective > shared_objective = nullptr );
 		virtual void SetOutputMode( OutputMode m ) override;
-		virtual ~CmaOptimizerSpot() {}
+		virtual ~CmaOptimizerSpot();
 		virtual void Run() override;
+		virtual void Interrupt() override { interrupt(); }
 		virtual double GetBestFitness() const override { return best_fitness(); }
 		static spot::evaluator& GetEvaluator();
 
 		/// Maximum number of errors allowed during evaluation, use a negative value equates to ''lambda - max_errors''; default = 0
 		int max_errors; // for documentation only, copies value to spot::max_errors_ during construction
+
+	private:
+		ProcessEvaluator* process_evaluator_; // set if the objective is evaluated by worker processes
 	};
 
 	class SCONE_API CmaOptimizerReporter : public spot::reporter
@@ -46,5 +53,21 @@ namespace scone
 		virtual void on_post_evaluate_population( const optimizer& opt, const search_point_vec& pop, const fitness_vec& fitnesses, bool new_best ) override;
 		xo::timer timer_;
 		size_t number_of_evaluations_;
+	private:
+		// set in on_start() if the optimizer has a status channel and its id and output folder fit in a StatusRecord,
+		// otherwise all status messages are sent as text
+		StatusChannel* status_channel_ = nullptr;
+	};
+
+	/// Reporter that starts a new generation in a ModelObjective, required for early termination and rollouts
+	class SCONE_API EarlyTerminationReporter : public spot::reporter
+	{
+	public:
+		EarlyTerminationReporter( const ModelObjective& mo, ProcessEvaluator* pe = nullptr ) : objective_( mo ), process_evaluator_( pe ) {}
+		virtual void on_stop( const optimizer& opt, const spot::stop_condition& s ) override;
+		virtual void on_pre_evaluate_population( const optimizer& opt, const search_point_vec& pop ) override;
+	private:
+		const ModelObjective& objective_;
+		ProcessEvaluator* process_evaluator_; // forwards generations to the objectives of the worker processes
 	};
 }
@@ -9,6 +9,7 @@
 #include "CmaPoolOptimizer.h"
 #include "CmaOptimizerSpot.h"
 #include "spot/file_reporter.h"
+#include "scone/core/Log.h"
 
 namespace scone
 {
@@ -27,7 +28,14 @@ namespace scone
 		INIT_PROP( pn, concurrent_optimizations_, 2 );
 		INIT_PROP( pn, random_seed_, 1 );
 
-		auto flag_parameters = CmaOptimizerSpot( pn, scenario_pn, scenario_dir );
+		// early termination uses per-generation results, which would get mixed up between optimizations
+		if ( auto* mo = dynamic_cast<ModelObjective*>( m_Objective.get() ); mo && mo->early_termination )
+		{
+			log::warning( "early_termination is not supported by CmaPoolOptimizer and will be disabled" );
+			mo->early_termination = false;
+		}
+
+		auto flag_parameters = CmaOptimizerSpot( pn, scenario_pn, scenario_dir, m_Objective );
 	}
 
 	void CmaPoolOptimizer::Run()
@@ -35,7 +43,8 @@ namespace scone
 		// create output folder
 		PrepareOutputFolder();
 
-		// fill the pool
+		// fill the pool; children find their files in the output folder of the pool
+		const auto resource_dir = m_Objective->GetExternalResourceDir();
 		for ( int i = 0; i < optimizations_; ++i )
 		{
 			// reuse the props from CmaPoolOptimizer
@@ -44,12 +53,15 @@ namespace scone
 			props_.back().set( "type", "CmaOptimizer" ); // change type
 			props_.back().set( "output_root", GetOutputFolder() ); // make sure output is written to subdirectory
 			props_.back().set( "log_level", (int)xo::log::level::never ); // children don't log?
+			if ( use_init_file && !init_file.empty() )
+				props_.back().set( "init_file", init_file ); // already resolved by the pool
 
-			// create optimizer
-			auto o = std::make_unique< CmaOptimizerSpot >( props_.back(), scenario_pn_copy_, m_Objective->GetExternalResourceDir() );
+			// create optimizer, sharing the objective (and its models) with the other optimizations
+			auto o = std::make_unique< CmaOptimizerSpot >( props_.back(), scenario_pn_copy_, resource_dir, m_Objective );
 			o->PrepareOutputFolder();
 			o->add_reporter( std::make_unique< spot::file_reporter >(
 				o->GetOutputFolder(), o->min_improvement_for_file_output, o->max_generations_without_file_output ) );
+			o->SetStatusChannel( status_channel_ );
 			o->SetOutputMode( output_mode_ );
 			push_back( std::move( o ) );
 		}
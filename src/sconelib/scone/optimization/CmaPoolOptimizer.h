@@ -15,6 +15,7 @@
 namespace scone
 {
 	/// Multiple CMA-ES optimizations than run in a prioritized fashion, based on their predicted fitness.
+	/** All optimizations share a single Objective, so that models are constructed only once for each evaluation thread. */
 	class CmaPoolOptimizer : public Optimizer, public spot::optimizer_pool
 	{
 	public:
@@ -22,6 +23,7 @@ namespace scone
 		virtual ~CmaPoolOptimizer() {}
 
 		virtual void Run() override;
+		virtual void Interrupt() override { interrupt(); }
 		virtual void SetOutputMode( OutputMode m ) override;
 
 		/// Maximum number of optimizations; default = 3.
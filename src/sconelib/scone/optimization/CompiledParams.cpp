@@ -0,0 +1,112 @@
+/*
+** CompiledParams.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "CompiledParams.h"
+
+#include "scone/core/Exception.h"
+#include "scone/core/Log.h"
+#include "scone/core/string_tools.h"
+
+#include <functional>
+
+namespace scone
+{
+	namespace
+	{
+		index_t FindParamIndex( const ObjectiveInfo& info, const String& name ) {
+			for ( index_t i = 0; i < info.dim(); ++i )
+				if ( info[ i ].name == name )
+					return i;
+			return no_index;
+		}
+	}
+
+	CompiledParams::CompiledParams( const SearchPoint& point, ParamSequence& seq, bool validate ) :
+		point_( point ),
+		seq_( seq ),
+		validate_( validate ),
+		mode_( LookupMode ),
+		record_lock_( seq.record_mutex_, std::defer_lock ),
+		pos_( 0 ),
+		compilable_( true )
+	{
+		if ( seq_.compiled_ )
+			mode_ = ReplayMode;
+		else if ( !seq_.disabled_ && record_lock_.try_lock() )
+		{
+			// check again, the sequence may have been compiled before we acquired the lock
+			mode_ = seq_.compiled_ ? ReplayMode : RecordMode;
+			if ( mode_ == ReplayMode )
+				record_lock_.unlock();
+		}
+	}
+
+	spot::optional_par_value CompiledParams::try_get( const String& full_name ) const
+	{
+		switch ( mode_ )
+		{
+		case ReplayMode:
+		{
+			SCONE_ERROR_IF( pos_ >= seq_.indices_.size(), "Parameter sequence has changed, unexpected parameter " + full_name );
+			SCONE_ERROR_IF( seq_.name_hashes_[ pos_ ] != std::hash< String >()( full_name ) || ( validate_ && seq_.names_[ pos_ ] != full_name ),
+				"Parameter sequence has changed, expected " + seq_.names_[ pos_ ] + " instead of " + full_name );
+			auto idx = seq_.indices_[ pos_++ ];
+			if ( idx != no_index )
+				return point_.values()[ idx ];
+			else return spot::optional_par_value();
+		}
+		case RecordMode:
+		{
+			auto value = point_.try_get( full_name );
+			auto idx = FindParamIndex( point_.info(), full_name );
+			if ( idx != no_index )
+				compilable_ &= value && *value == point_.values()[ idx ];
+			else compilable_ &= !value;
+			indices_.push_back( idx );
+			names_.push_back( full_name );
+			name_hashes_.push_back( std::hash< String >()( full_name ) );
+			return value;
+		}
+		default:
+			return point_.try_get( full_name );
+		}
+	}
+
+	spot::optional_par_value CompiledParams::try_add( const String& full_name, spot::par_value mean, spot::par_value std, spot::par_value min, spot::par_value max )
+	{
+		// parameters that are not part of the search point are requested again in each construction
+		// which is fine as long as the search point keeps handling them the same way
+		return point_.try_add( full_name, mean, std, min, max );
+	}
+
+	void CompiledParams::Finish()
+	{
+		if ( mode_ == ReplayMode )
+		{
+			SCONE_ERROR_IF( pos_ != seq_.indices_.size(), stringf( "Parameter sequence has changed, %d of %d parameters were used", int( pos_ ), int( seq_.indices_.size() ) ) );
+		}
+		else if ( mode_ == RecordMode )
+		{
+			if ( compilable_ )
+			{
+				seq_.indices_ = std::move( indices_ );
+				seq_.names_ = std::move( names_ );
+				seq_.name_hashes_ = std::move( name_hashes_ );
+				seq_.compiled_ = true;
+				log::debug( "Compiled parameter sequence of ", seq_.indices_.size(), " parameters" );
+			}
+			else
+			{
+				seq_.disabled_ = true;
+				log::debug( "Parameter sequence could not be compiled, parameters are looked up by name" );
+			}
+			record_lock_.unlock();
+			mode_ = LookupMode;
+		}
+	}
+}
@@ -0,0 +1,76 @@
+/*
+** CompiledParams.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "scone/core/platform.h"
+#include "scone/core/types.h"
+#include "Params.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace scone
+{
+	/// Sequence of parameter indices requested during the construction of a model.
+	/** Models, controllers and measures request their parameters in the same order each time they are constructed.
+	The sequence is recorded during the first construction, after which CompiledParams can provide the parameters by index. */
+	class SCONE_API ParamSequence
+	{
+	public:
+		ParamSequence() : compiled_( false ), disabled_( false ) {}
+		ParamSequence( const ParamSequence& ) = delete;
+		ParamSequence& operator=( const ParamSequence& ) = delete;
+
+		bool IsCompiled() const { return compiled_; }
+		size_t size() const { return indices_.size(); }
+
+	private:
+		friend class CompiledParams;
+		std::vector< index_t > indices_; // no_index for parameters that are not part of the search point
+		std::vector< String > names_;
+		std::vector< size_t > name_hashes_; // always compared during replay, names_ only when validating
+		std::mutex record_mutex_;
+		std::atomic< bool > compiled_;
+		std::atomic< bool > disabled_; // set if the sequence cannot be compiled
+	};
+
+	/// Parameters of a search point that are consumed in the order of a ParamSequence, instead of being looked up by name.
+	/** If the sequence is not compiled, the parameters are looked up by name and the sequence is recorded.
+	Only one instance can record a sequence at a time, other instances look up parameters by name until it has finished.
+	Call Finish() after the construction has completed successfully. */
+	class SCONE_API CompiledParams : public Params
+	{
+	public:
+		CompiledParams( const SearchPoint& point, ParamSequence& seq, bool validate );
+		virtual ~CompiledParams() = default;
+
+		using Params::try_get;
+		using Params::try_add;
+		virtual size_t dim() const override { return point_.dim(); }
+		virtual spot::optional_par_value try_get( const String& full_name ) const override;
+		virtual spot::optional_par_value try_add( const String& full_name, spot::par_value mean, spot::par_value std, spot::par_value min, spot::par_value max ) override;
+
+		/// Check if all parameters of the sequence were consumed, or store the recorded sequence.
+		void Finish();
+
+	private:
+		enum Mode { LookupMode, RecordMode, ReplayMode };
+		SearchPoint point_;
+		ParamSequence& seq_;
+		bool validate_;
+		Mode mode_;
+		std::unique_lock< std::mutex > record_lock_;
+		mutable index_t pos_;
+		mutable std::vector< index_t > indices_;
+		mutable std::vector< String > names_;
+		mutable std::vector< size_t > name_hashes_;
+		mutable bool compilable_;
+	};
+}
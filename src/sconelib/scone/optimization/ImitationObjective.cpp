@@ -35,20 +35,20 @@ namespace scone
 			signature_postfix = "Imitation";
 
 		// prepare data
-		ReadStorageSto( m_Storage, file );
+		m_Storage = ReadStorageCached( file );
 		model_->AddExternalResource(file);
 
 		// make sure data and model are compatible
 		auto state = model_->GetState();
-		SCONE_THROW_IF( state.GetSize() > m_Storage.GetChannelCount(), "File and model are incompatible for ImitationObjective" );
+		SCONE_THROW_IF( state.GetSize() > m_Storage->GetChannelCount(), "File and model are incompatible for ImitationObjective" );
 		for ( index_t i = 0; i < state.GetSize(); ++i )
-			SCONE_THROW_IF( state.GetName( i ) != m_Storage.GetLabels()[ i ], "File and model are incompatible for ImitationObjective" );
+			SCONE_THROW_IF( state.GetName( i ) != m_Storage->GetLabels()[ i ], "File and model are incompatible for ImitationObjective" );
 
 		// find excitation channels
 		m_ExcitationChannels.reserve( model_->GetMuscles().size() );
 		for ( auto& mus : model_->GetMuscles() )
 		{
-			m_ExcitationChannels.push_back( m_Storage.GetChannelIndex( mus->GetName() + ".excitation" ) );
+			m_ExcitationChannels.push_back( m_Storage->GetChannelIndex( mus->GetName() + ".excitation" ) );
 			SCONE_THROW_IF( m_ExcitationChannels.back() == NoIndex, "Could not find excitation for " + mus->GetName() );
 		}
 
@@ -58,8 +58,9 @@ namespace scone
 		for ( index_t ds_idx = 0; ds_idx < ds.GetChannelCount(); ++ds_idx )
 		{
 			auto& sensor_name = ds.GetLabels()[ ds_idx ];
-			m_SensorChannels.push_back( m_Storage.GetChannelIndex( sensor_name ) );
+			m_SensorChannels.push_back( m_Storage->GetChannelIndex( sensor_name ) );
 			SCONE_THROW_IF( m_SensorChannels.back() == NoIndex, "Could not find sensor for " + sensor_name );
+			m_SensorValues.push_back( m_Storage->GetChannelValues( m_SensorChannels.back() ) );
 		}
 
 		AddExternalResources( *model_ );
@@ -78,13 +79,16 @@ namespace scone
 			model.GetUserData()[ "IM_res" ] = 0.0;
 
 			// add sensor data
+			model.DisableSensorDelayBuffer();
 			auto& ds = model.GetSensorDelayStorage();
-			for ( index_t fidx = 1; fidx < m_Storage.GetFrameCount(); ++fidx )
+			auto& times = m_Storage->GetTimes();
+			if ( times.size() > 1 )
+				ds.Reserve( ds.GetFrameCount() + times.size() - 1 );
+			for ( index_t fidx = 1; fidx < times.size(); ++fidx )
 			{
-				auto sf = m_Storage.GetFrame( fidx );
-				ds.AddFrame( sf.GetTime() );
-				for ( index_t cidx = 0; cidx < m_SensorChannels.size(); ++cidx )
-					ds.Back()[ cidx ] = sf[ m_SensorChannels[ cidx ] ];
+				auto& f = ds.AddFrame( times[ fidx ] );
+				for ( index_t cidx = 0; cidx < m_SensorValues.size(); ++cidx )
+					f[ cidx ] = m_SensorValues[ cidx ][ fidx ];
 			}
 		}
 
@@ -94,12 +98,14 @@ namespace scone
 		index_t frame_count = 0;
 
 		{
-			for ( index_t idx = frame_start * frame_delta; idx < m_Storage.GetFrameCount() && m_Storage.GetFrame( idx ).GetTime() <= t; idx += frame_delta )
+			std::vector< Real > state_values;
+			for ( index_t idx = frame_start * frame_delta; idx < m_Storage->GetFrameCount() && m_Storage->GetFrame( idx ).GetTime() <= t; idx += frame_delta )
 			{
-				auto f = m_Storage.GetFrame( idx );
+				auto& f = m_Storage->GetFrame( idx );
 
 				// set state and compare output
-				model.SetStateValues( f.GetValues(), f.GetTime() );
+				f.GetValues().CopyTo( state_values );
+				model.SetStateValues( state_values, f.GetTime() );
 				for ( index_t idx = 0; idx < m_ExcitationChannels.size(); ++idx )
 					result += abs( model.GetMuscles()[ idx ]->GetExcitation() - f[ m_ExcitationChannels[ idx ] ] );
 				++frame_count;
@@ -118,8 +124,8 @@ namespace scone
 	TimeInSeconds ImitationObjective::GetDuration() const
 	{
 		// find last frame, keeping frame_delta in mind
-		auto lastFrame = ( m_Storage.GetFrameCount() - 1 ) / frame_delta * frame_delta;
-		return m_Storage.GetFrame( lastFrame ).GetTime();
+		auto lastFrame = ( m_Storage->GetFrameCount() - 1 ) / frame_delta * frame_delta;
+		return m_Storage->GetFrame( lastFrame ).GetTime();
 	}
 
 	fitness_t ImitationObjective::GetResult( Model& m ) const
@@ -17,6 +17,7 @@
 #include <vector>
 #include "xo/filesystem/path.h"
 #include "scone/core/Storage.h"
+#include "scone/core/StorageIo.h"
 #include "ModelObjective.h"
 
 namespace scone
@@ -40,8 +41,9 @@ namespace scone
 		virtual PropNode GetReport( Model& m ) const override;
 
 	private:
-		Storage<> m_Storage;
+		StorageCSP m_Storage; // shared between objective instances
 		std::vector< index_t > m_ExcitationChannels;
 		std::vector< index_t > m_SensorChannels;
+		std::vector< const Real* > m_SensorValues; // contiguous values of each sensor channel
 	};
 }
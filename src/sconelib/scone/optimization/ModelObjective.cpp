@@ -10,15 +10,24 @@
 
 #include "scone/core/Factories.h"
 #include "scone/core/Log.h"
+#include "scone/core/string_tools.h"
 #include "xo/filesystem/filesystem.h"
 #include "opt_tools.h"
 #include "scone/core/profiler_config.h"
+#include "xo/numerical/constants.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
 
 namespace scone
 {
 	ModelObjective::ModelObjective( const PropNode& props, const path& find_file_folder ) :
 		Objective( props, find_file_folder ),
-		evaluation_step_size_( XO_IS_DEBUG_BUILD ? 0.01 : 0.25 )
+		evaluation_step_size_( XO_IS_DEBUG_BUILD ? 0.01 : 0.25 ),
+		generation_mu_( 0 ),
+		generation_cutoff_( xo::constants<fitness_t>::max() ),
+		truncated_evaluations_( 0 ),
+		rollout_seed_offset_( 0 )
 	{
 		// create internal model using the ORIGINAL prop_node to flag unused model props and create par_info_
 		model_props = FindFactoryProps( GetModelFactory(), props, "Model" );
@@ -38,46 +47,271 @@ namespace scone
 
 		signature_ = model_->GetSignature();
 
+		INIT_PROP( props, reuse_models, true );
+		reuse_models &= model_->CanReset();
+		INIT_PROP( props, early_termination, false );
+		early_termination &= info_.minimize();
+		INIT_PROP( props, compile_parameters, true );
+		INIT_PROP( props, validate_compiled_parameters, bool( XO_IS_DEBUG_BUILD ) );
+
+		// rollouts with different random seeds
+		INIT_PROP( props, rollouts, size_t( 1 ) );
+		INIT_PROP( props, rollout_aggregate, String( "mean" ) );
+		INIT_PROP( props, cvar_fraction, 0.25 );
+		SCONE_ERROR_IF( rollouts == 0, "rollouts must be at least 1" );
+		SCONE_ERROR_IF( rollout_aggregate != "mean" && rollout_aggregate != "worst" && rollout_aggregate != "cvar", "Invalid rollout_aggregate: " + rollout_aggregate );
+		SCONE_ERROR_IF( cvar_fraction <= 0 || cvar_fraction > 1, "cvar_fraction must be between 0 and 1" );
+		if ( rollouts > 1 )
+		{
+			if ( early_termination )
+			{
+				log::warning( "early_termination is not supported in combination with rollouts and will be disabled" );
+				early_termination = false;
+			}
+			signature_ += stringf( ".RO%d", int( rollouts ) );
+		}
+
 		AddExternalResources( *model_ );
 	}
 
 	result<fitness_t> ModelObjective::evaluate( const SearchPoint& point, const xo::stop_token& st ) const
 	{
-		if ( !st.stop_requested() )
+		if ( rollouts > 1 )
+			return EvaluateRollouts( point, st );
+		else if ( !st.stop_requested() )
 		{
-			SearchPoint params( point );
-			auto model = CreateModelFromParams( params );
-			return EvaluateModel( *model, st );
+			auto model = AcquireCompiledModel( point );
+			auto result = EvaluateModel( *model, st );
+			ReleaseModel( std::move( model ) );
+			if ( early_termination && result )
+				AddGenerationResult( result.value() );
+			return result;
 		}
 		else return xo::error_message( "Optimization canceled" );
 	}
 
+	ModelCheckpoint ModelObjective::CreateCheckpoint( const SearchPoint& point, TimeInSeconds time ) const
+	{
+		SCONE_ERROR_IF( rollouts > 1, "Checkpoints cannot be used with multiple rollouts" );
+		auto model = AcquireCompiledModel( point );
+		AdvanceSimulationTo( *model, time );
+		auto cp = model->CreateCheckpoint();
+		ReleaseModel( std::move( model ) );
+		return cp;
+	}
+
+	result<fitness_t> ModelObjective::EvaluateFromCheckpoint( const SearchPoint& point, const ModelCheckpoint& cp, const xo::stop_token& st ) const
+	{
+		SCONE_ERROR_IF( rollouts > 1, "Checkpoints cannot be used with multiple rollouts" );
+		if ( st.stop_requested() )
+			return xo::error_message( "Optimization canceled" );
+
+		auto model = AcquireCompiledModel( point );
+		model->RestoreCheckpoint( cp );
+		auto result = EvaluateModel( *model, st );
+		ReleaseModel( std::move( model ) );
+		return result;
+	}
+
+	result<fitness_t> ModelObjective::EvaluateRollouts( const SearchPoint& point, const xo::stop_token& st ) const
+	{
+		// rollouts run sequentially on the evaluating thread, the evaluator already runs search points in parallel
+		// all rollouts of a generation share the same seeds, see BeginGeneration()
+		const int seed_offset = model_->random_seed_offset + rollout_seed_offset_.load();
+		std::vector< fitness_t > fitnesses;
+		fitnesses.reserve( rollouts );
+		for ( index_t k = 0; k < rollouts; ++k )
+		{
+			if ( st.stop_requested() )
+				return xo::error_message( "Optimization canceled" );
+			auto props = model_props.props();
+			props.set( "random_seed_offset", seed_offset + int( k ) );
+			auto model = AcquireCompiledModel( point, &props );
+			auto result = EvaluateModel( *model, st );
+			ReleaseModel( std::move( model ) );
+			if ( !result )
+				return result;
+			fitnesses.push_back( result.value() );
+		}
+		return AggregateRollouts( std::move( fitnesses ) );
+	}
+
+	fitness_t ModelObjective::AggregateRollouts( std::vector< fitness_t > results ) const
+	{
+		// sort from worst to best
+		if ( info_.minimize() )
+			std::sort( results.begin(), results.end(), std::greater<fitness_t>() );
+		else std::sort( results.begin(), results.end() );
+
+		size_t count = results.size();
+		if ( rollout_aggregate == "worst" )
+			count = 1;
+		else if ( rollout_aggregate == "cvar" )
+			count = std::max<size_t>( 1, static_cast<size_t>( std::ceil( cvar_fraction * results.size() ) ) );
+
+		return std::accumulate( results.begin(), results.begin() + count, fitness_t( 0 ) ) / count;
+	}
+
 	result<fitness_t> ModelObjective::EvaluateModel( Model& m, const xo::stop_token& st ) const
 	{
 		m.SetSimulationEndTime( GetDuration() );
-		for ( TimeInSeconds t = evaluation_step_size_; !m.HasSimulationEnded(); t += evaluation_step_size_ )
+		for ( TimeInSeconds t = m.GetTime() + evaluation_step_size_; !m.HasSimulationEnded(); t += evaluation_step_size_ )
 		{
 			if ( st.stop_requested() )
 				return xo::error_message( "Optimization canceled" );
 			AdvanceSimulationTo( m, t );
+
+			// stop if the result can no longer be among the best of this generation
+			// the bound is returned as result, which still ranks below the best mu
+			if ( early_termination && !m.HasSimulationEnded() )
+			{
+				auto cutoff = generation_cutoff_.load();
+				if ( cutoff < xo::constants<fitness_t>::max() )
+				{
+					auto bound = GetResultBound( m );
+					if ( bound > cutoff )
+					{
+						log::trace( "Early termination at t=", m.GetTime(), " bound=", bound, " cutoff=", cutoff );
+						++truncated_evaluations_;
+						return bound;
+					}
+				}
+			}
 		}
 		return GetResult( m );
 	}
 
+	fitness_t ModelObjective::GetResultBound( Model& m ) const
+	{
+		return xo::constants<fitness_t>::lowest();
+	}
+
+	void ModelObjective::BeginGeneration( size_t mu ) const
+	{
+		// new seeds for each generation, so the search does not overfit to a fixed set of random sequences
+		BeginGeneration( mu, rollouts > 1 ? rollout_seed_offset_ + int( rollouts ) : rollout_seed_offset_.load() );
+	}
+
+	void ModelObjective::BeginGeneration( size_t mu, int rollout_seed_offset ) const
+	{
+		rollout_seed_offset_ = rollout_seed_offset;
+
+		std::scoped_lock lock( generation_mutex_ );
+		generation_results_.clear();
+		generation_mu_ = mu;
+		generation_cutoff_ = xo::constants<fitness_t>::max();
+	}
+
+	void ModelObjective::AddGenerationResult( fitness_t fitness ) const
+	{
+		// keep the best mu results in a max-heap, the cutoff is the worst of these
+		// truncated results are above the cutoff, so adding them does not change it
+		std::scoped_lock lock( generation_mutex_ );
+		if ( generation_mu_ == 0 )
+			return;
+		if ( generation_results_.size() < generation_mu_ )
+		{
+			generation_results_.push_back( fitness );
+			std::push_heap( generation_results_.begin(), generation_results_.end() );
+		}
+		else if ( fitness < generation_results_.front() )
+		{
+			std::pop_heap( generation_results_.begin(), generation_results_.end() );
+			generation_results_.back() = fitness;
+			std::push_heap( generation_results_.begin(), generation_results_.end() );
+		}
+		if ( generation_results_.size() == generation_mu_ )
+			generation_cutoff_ = generation_results_.front();
+	}
+
 	ModelUP ModelObjective::CreateModelFromParams( Params& par ) const
 	{
 		auto model = CreateModel( model_props, par, GetExternalResourceDir() );
 		model->SetSimulationEndTime( GetDuration() );
+		CreateControllers( *model, par );
+		return model;
+	}
 
+	void ModelObjective::CreateControllers( Model& model, Params& par ) const
+	{
 		if ( controller_props ) // A controller was defined OUTSIDE the model prop_node
-			model->CreateController( controller_props, par );
+			model.CreateController( controller_props, par );
 
 		if ( measure_props ) // A measure was defined OUTSIDE the model prop_node
-			model->CreateMeasure( measure_props, par );
+			model.CreateMeasure( measure_props, par );
+	}
+
+	ModelUP ModelObjective::CreateRolloutModel( Params& par, const PropNode* rollout_props ) const
+	{
+		if ( !rollout_props )
+			return CreateModelFromParams( par );
+
+		auto model = CreateModel( FactoryProps{ model_props.type(), rollout_props }, par, GetExternalResourceDir() );
+		model->SetSimulationEndTime( GetDuration() );
+		CreateControllers( *model, par );
+		return model;
+	}
+
+	ModelUP ModelObjective::AcquireModel( Params& par, const PropNode* rollout_props ) const
+	{
+		if ( auto model = PopPooledModel() )
+		{
+			ResetModel( *model, par, rollout_props );
+			return model;
+		}
+		else return CreateRolloutModel( par, rollout_props );
+	}
 
+	ModelUP ModelObjective::AcquireCompiledModel( const SearchPoint& point, const PropNode* rollout_props ) const
+	{
+		if ( !compile_parameters )
+		{
+			SearchPoint params( point );
+			return AcquireModel( params, rollout_props );
+		}
+
+		// reset and create request different parameters, so they each have their own sequence
+		auto model = PopPooledModel();
+		CompiledParams params( point, model ? reset_param_sequence_ : create_param_sequence_, validate_compiled_parameters );
+		if ( model )
+			ResetModel( *model, params, rollout_props );
+		else model = CreateRolloutModel( params, rollout_props );
+		params.Finish();
 		return model;
 	}
 
+	ModelUP ModelObjective::PopPooledModel() const
+	{
+		ModelUP model;
+		if ( reuse_models )
+		{
+			std::scoped_lock lock( model_pool_mutex_ );
+			if ( !model_pool_.empty() )
+			{
+				model = std::move( model_pool_.back() );
+				model_pool_.pop_back();
+			}
+		}
+		return model;
+	}
+
+	void ModelObjective::ResetModel( Model& model, Params& par, const PropNode* rollout_props ) const
+	{
+		// reset the model instead of recreating it, which avoids initSystem()
+		model.Reset( rollout_props ? *rollout_props : model_props.props(), par );
+		model.SetSimulationEndTime( GetDuration() );
+		CreateControllers( model, par );
+	}
+
+	void ModelObjective::ReleaseModel( ModelUP model ) const
+	{
+		if ( reuse_models )
+		{
+			std::scoped_lock lock( model_pool_mutex_ );
+			model_pool_.push_back( std::move( model ) );
+		}
+	}
+
 	ModelUP ModelObjective::CreateModelFromParFile( const path& parfile ) const
 	{
 		SearchPoint params( info_ );
@@ -11,6 +11,11 @@
 #include "scone/optimization/Objective.h"
 #include "scone/model/Model.h"
 #include "scone/core/Factories.h"
+#include "CompiledParams.h"
+
+#include <mutex>
+#include <vector>
+#include <atomic>
 
 namespace scone
 {
@@ -27,17 +32,80 @@ namespace scone
 		virtual void AdvanceSimulationTo( Model& m, TimeInSeconds t ) const = 0;
 		virtual TimeInSeconds GetDuration() const = 0;
 		virtual fitness_t GetResult( Model& m ) const = 0;
+		virtual fitness_t GetResultBound( Model& m ) const;
 		virtual PropNode GetReport( Model& m ) const = 0;
 
 		virtual ModelUP CreateModelFromParams( Params& point ) const;
 		ModelUP CreateModelFromParFile( const path& parfile ) const;
 
+		/// Get a model with controllers created from par, which is reset from a previously released model if reuse_models is set.
+		/// If set, rollout_props are used instead of the model props of the objective.
+		ModelUP AcquireModel( Params& par, const PropNode* rollout_props = nullptr ) const;
+
+		/// Same as AcquireModel(), but parameters are consumed by index after the first model has been constructed (if compile_parameters is set).
+		ModelUP AcquireCompiledModel( const SearchPoint& point, const PropNode* rollout_props = nullptr ) const;
+
+		/// Return a model after evaluation, so it can be reused by AcquireModel().
+		void ReleaseModel( ModelUP model ) const;
+
+		/// Simulate point up to time and capture the state of the model, see EvaluateFromCheckpoint().
+		ModelCheckpoint CreateCheckpoint( const SearchPoint& point, TimeInSeconds time ) const;
+
+		/// Evaluate point, continuing from a checkpoint instead of simulating from the start.
+		/** Controllers and measures are created using the parameters of point, after which their state is restored from the checkpoint.
+		This gives the same result as evaluate() only if point does not affect the simulation before the time of the checkpoint. */
+		result<fitness_t> EvaluateFromCheckpoint( const SearchPoint& point, const ModelCheckpoint& cp, const xo::stop_token& st ) const;
+
+		/// Reuse models between evaluations by resetting them instead of creating new ones (if supported by the model); default = 1.
+		bool reuse_models;
+
+		/// Number of rollouts per evaluation, each using a different ''random_seed_offset'' for the model; default = 1.
+		/** All search points of a generation use the same seeds (common random numbers), which reduces ranking noise.
+		Each generation uses new seeds, so that the optimization does not overfit to a fixed set of random sequences
+		(except with AsyncCmaOptimizer, which has no generations and keeps the same seeds).
+		The rollouts of an evaluation run sequentially; search points are still evaluated in parallel.
+		Use this with controllers that have a random_seed, such as NoiseController or PerturbationController. */
+		size_t rollouts;
+
+		/// How to combine the results of the rollouts: ''mean'', ''worst'' or ''cvar'' (average of the worst ''cvar_fraction''); default = mean.
+		String rollout_aggregate;
+
+		/// Fraction of worst rollouts that is averaged when ''rollout_aggregate'' = cvar; default = 0.25.
+		double cvar_fraction;
+
+		/// Stop evaluations as soon as their result can no longer be among the best ''mu'' of a generation (minimized objectives only, not with AsyncCmaOptimizer); default = 0.
+		bool early_termination;
+
+		/// Look up parameters by index after the first model construction, instead of by name; default = 1.
+		/** The parameters requested during the first construction are recorded, subsequent constructions are expected to request the same parameters in the same order. */
+		bool compile_parameters;
+
+		/// Compare the full names of compiled parameters with those of the first construction; default = 0 (1 in debug builds).
+		/** A hash of each name is always compared, this option also catches the (unlikely) case of a hash collision. */
+		bool validate_compiled_parameters;
+
+		/// Start a new generation, in which the best ''mu'' results are used for early termination and rollouts use new seeds
+		void BeginGeneration( size_t mu ) const;
+		/// Start a new generation with a given seed offset, used to start the same generation in the objectives of worker processes
+		void BeginGeneration( size_t mu, int rollout_seed_offset ) const;
+		int GetRolloutSeedOffset() const { return rollout_seed_offset_; }
+		/// Check if the optimizer should call BeginGeneration(), which is required for early_termination and rollouts
+		bool UsesGenerations() const { return early_termination || rollouts > 1; }
+		size_t GetTruncatedEvaluationCount() const { return truncated_evaluations_; }
+
 		virtual std::vector<path> WriteResults( const path& file_base ) override;
 
 		const Model& GetModel() const { return *model_; }
 		Model& GetModel() { return *model_; }
 
 	protected:
+		void CreateControllers( Model& model, Params& par ) const;
+		ModelUP CreateRolloutModel( Params& par, const PropNode* rollout_props ) const;
+		ModelUP PopPooledModel() const;
+		void ResetModel( Model& model, Params& par, const PropNode* rollout_props ) const;
+		result<fitness_t> EvaluateRollouts( const SearchPoint& point, const xo::stop_token& st ) const;
+		fitness_t AggregateRollouts( std::vector< fitness_t > results ) const;
+
 		FactoryProps model_props;
 		FactoryProps controller_props;
 		FactoryProps measure_props;
@@ -46,6 +114,25 @@ namespace scone
 		String signature_; // cached variable, because we need to create a model to get the signature
 		virtual String GetClassSignature() const override { return signature_; }
 		TimeInSeconds evaluation_step_size_;
+
+		// models that can be reused in evaluate(), one for each concurrent evaluation
+		mutable std::vector< ModelUP > model_pool_;
+		mutable std::mutex model_pool_mutex_;
+
+		// parameter sequences of created and reset models, see compile_parameters
+		mutable ParamSequence create_param_sequence_;
+		mutable ParamSequence reset_param_sequence_;
+
+	private:
+		void AddGenerationResult( fitness_t fitness ) const;
+
+		// best mu results of the current generation, used for early termination
+		mutable std::vector< fitness_t > generation_results_;
+		mutable size_t generation_mu_;
+		mutable std::mutex generation_mutex_;
+		mutable std::atomic< fitness_t > generation_cutoff_;
+		mutable std::atomic< size_t > truncated_evaluations_;
+		mutable std::atomic< int > rollout_seed_offset_; // added to the random_seed_offset of the model, changes every generation
 	};
 
 	/// Create ModelObjective from a PropNode
@@ -30,12 +30,13 @@ namespace scone
 {
 	std::mutex g_status_output_mutex;
 
-	Optimizer::Optimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir ) :
+	Optimizer::Optimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir, s_ptr< Objective > shared_objective ) :
 		HasSignature( props ),
 		max_threads( 1 ),
 		thread_priority( (int)xo::thread_priority::lowest ),
 		m_LastFileOutputGen( 0 ),
-		m_Objective( CreateObjective( FindFactoryProps( GetObjectiveFactory(), props, "Objective" ), scenario_dir ) ),
+		m_Objective( shared_objective ? shared_objective : s_ptr< Objective >( CreateObjective( FindFactoryProps( GetObjectiveFactory(), props, "Objective" ), scenario_dir ) ) ),
+		m_SharedObjective( shared_objective != nullptr ),
 		m_BestFitness( m_Objective->info().worst_fitness() ),
 		output_mode_( no_output ),
 		scenario_pn_copy_( scenario_pn )
@@ -65,10 +66,13 @@ namespace scone
 		INIT_PROP( props, window_size, 500 );
 		INIT_PROP( props, min_progress_samples, window_size );
 
-		// initialize parameters from file
+		// find init_file, which is also needed with a shared objective, because PrepareOutputFolder() copies it
 		if ( use_init_file && !init_file.empty() )
-		{
 			init_file = FindFile( init_file );
+
+		// initialize parameters from file (shared objectives are initialized by their owner)
+		if ( use_init_file && !init_file.empty() && !m_SharedObjective )
+		{
 			auto result = GetObjective().info().import_mean_std( init_file,
 				use_init_file_std, init_file_std_factor, init_file_std_offset,
 				init_file_include, init_file_exclude );
@@ -157,6 +161,8 @@ namespace scone
 				SCONE_ERROR( "Could not copy external resource: " + f.str() );
 
 		// now that all files are copied, we should use these during evaluation
-		GetObjective().SetExternalResourceDir( GetOutputFolder() );
+		// a shared objective keeps the resource dir set by its owner, which is used by all optimizers
+		if ( !m_SharedObjective )
+			GetObjective().SetExternalResourceDir( GetOutputFolder() );
 	}
 }
@@ -18,11 +18,14 @@
 
 namespace scone
 {
+	class StatusChannel;
+
 	/// Base class for Optimizers.
 	class SCONE_API Optimizer : public HasSignature
 	{
 	public:
-		Optimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir );
+		/// Creates a new Objective, unless shared_objective is set; a shared Objective is used as-is and does not import init_file.
+		Optimizer( const PropNode& props, const PropNode& scenario_pn, const path& scenario_dir, s_ptr< Objective > shared_objective = nullptr );
 		Optimizer( const Optimizer& ) = delete;
 		Optimizer& operator=( const Optimizer& ) = delete;
 
@@ -78,6 +81,9 @@ namespace scone
 		const Objective& GetObjective() const { return *m_Objective; }
 		virtual void Run() = 0;
 
+		/// Stop a running optimization, can be called from a different thread.
+		virtual void Interrupt() = 0;
+
 		// get the results output folder (creates it if it doesn't exist)
 		const path& GetOutputFolder() const;
 
@@ -94,6 +100,10 @@ namespace scone
 		template< typename T > void OutputStatus( const String& key, const T& value ) const;
 		std::deque<PropNode> GetStatusMessages() const;
 
+		/// Write the status of each generation as binary records instead of text messages (used by CmaOptimizerSpot).
+		void SetStatusChannel( s_ptr< StatusChannel > channel ) { status_channel_ = std::move( channel ); }
+		const s_ptr< StatusChannel >& GetStatusChannel() const { return status_channel_; }
+
 		const String& id() const { return id_; }
 
 		mutable size_t m_LastFileOutputGen;
@@ -104,7 +114,8 @@ namespace scone
 		void PrepareOutputFolder();
 
 	protected:
-		ObjectiveUP m_Objective;
+		s_ptr< Objective > m_Objective; // can be shared between optimizers, e.g. in CmaPoolOptimizer
+		bool m_SharedObjective; // the objective is owned (and its resource dir set) by another optimizer
 		virtual String GetClassSignature() const override;
 
 		// current status
@@ -113,6 +124,7 @@ namespace scone
 		OutputMode output_mode_;
 		mutable std::deque<PropNode> status_queue_; // #todo: move this to reporter
 		mutable std::mutex status_queue_mutex_;
+		s_ptr< StatusChannel > status_channel_;
 
 		mutable path output_folder_;
 		mutable String id_;
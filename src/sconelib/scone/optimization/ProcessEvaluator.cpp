@@ -0,0 +1,621 @@
+/*
+** ProcessEvaluator.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "ProcessEvaluator.h"
+
+#include "scone/core/Exception.h"
+#include "scone/core/Factories.h"
+#include "scone/core/Log.h"
+#include "scone/core/Settings.h"
+#include "scone/core/string_tools.h"
+#include "ModelObjective.h"
+#include "Optimizer.h"
+#include "xo/filesystem/filesystem.h"
+#include "xo/serialization/prop_node_serializer_zml.h"
+#include "xo/system/error_code.h"
+#include "xo/system/system_tools.h"
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#	define NOMINMAX
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#	include <io.h>
+#else
+#	include <csignal>
+#	include <fcntl.h>
+#	include <poll.h>
+#	include <sched.h>
+#	include <sys/types.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+namespace scone
+{
+	namespace
+	{
+		// each message consists of a header, followed by size bytes of payload:
+		// ScenarioMessage: scenario text (no response, errors are reported when evaluating)
+		// EvaluateMessage: parameter values (double), response is ResultMessage or ErrorMessage
+		// ResultMessage: fitness (double)
+		// ErrorMessage: error text
+		// ForgetMessage: no payload, the worker releases the objective of the scenario (no response)
+		// GenerationMessage: GenerationPayload, the worker starts a new generation in the objective of the scenario (no response)
+		enum MessageType : std::uint32_t { ScenarioMessage = 1, EvaluateMessage = 2, ResultMessage = 3, ErrorMessage = 4, QuitMessage = 5, ForgetMessage = 6, GenerationMessage = 7 };
+		struct GenerationPayload
+		{
+			std::uint64_t mu;
+			std::int64_t rollout_seed_offset;
+		};
+		struct MessageHeader
+		{
+			std::uint32_t type;
+			std::uint32_t size;
+			std::uint64_t scenario_id;
+		};
+
+		using clock = std::chrono::steady_clock;
+		constexpr auto no_deadline = clock::time_point::max();
+		constexpr auto worker_quit_timeout = std::chrono::seconds( 5 );
+		enum class ReadStatus { Ok, Failed, TimedOut };
+
+#ifdef _WIN32
+		using pipe_t = HANDLE;
+		// wait until data is available, returns false if the deadline has passed
+		bool WaitForData( pipe_t p, clock::time_point deadline ) {
+			// anonymous pipes do not support overlapped IO, so poll until data is available
+			for ( DWORD available = 0; PeekNamedPipe( p, nullptr, 0, nullptr, &available, nullptr ); Sleep( 1 ) ) {
+				if ( available > 0 )
+					return true;
+				if ( clock::now() >= deadline )
+					return false;
+			}
+			return true; // errors are reported by ReadFile()
+		}
+		ReadStatus ReadBytes( pipe_t p, void* data, size_t size, clock::time_point deadline ) {
+			for ( auto* ptr = static_cast<char*>( data ); size > 0; ) {
+				if ( deadline != no_deadline && !WaitForData( p, deadline ) )
+					return ReadStatus::TimedOut;
+				DWORD n = 0;
+				if ( !ReadFile( p, ptr, DWORD( size ), &n, nullptr ) || n == 0 )
+					return ReadStatus::Failed;
+				ptr += n;
+				size -= n;
+			}
+			return ReadStatus::Ok;
+		}
+		bool WriteBytes( pipe_t p, const void* data, size_t size ) {
+			for ( auto* ptr = static_cast<const char*>( data ); size > 0; ) {
+				DWORD n = 0;
+				if ( !WriteFile( p, ptr, DWORD( size ), &n, nullptr ) || n == 0 )
+					return false;
+				ptr += n;
+				size -= n;
+			}
+			return true;
+		}
+#else
+		using pipe_t = int;
+		// wait until data is available, returns false if the deadline has passed
+		bool WaitForData( pipe_t p, clock::time_point deadline ) {
+			for ( ;; ) {
+				auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>( deadline - clock::now() ).count();
+				if ( remaining <= 0 )
+					return false;
+				pollfd pfd{ p, POLLIN, 0 };
+				auto n = poll( &pfd, 1, int( std::min< long long >( remaining, INT_MAX ) ) );
+				if ( n < 0 && errno == EINTR )
+					continue;
+				return n != 0; // errors and hangups are reported by read()
+			}
+		}
+		ReadStatus ReadBytes( pipe_t p, void* data, size_t size, clock::time_point deadline ) {
+			for ( auto* ptr = static_cast<char*>( data ); size > 0; ) {
+				if ( deadline != no_deadline && !WaitForData( p, deadline ) )
+					return ReadStatus::TimedOut;
+				auto n = read( p, ptr, size );
+				if ( n < 0 && errno == EINTR )
+					continue;
+				if ( n <= 0 )
+					return ReadStatus::Failed;
+				ptr += n;
+				size -= size_t( n );
+			}
+			return ReadStatus::Ok;
+		}
+		bool WriteBytes( pipe_t p, const void* data, size_t size ) {
+			for ( auto* ptr = static_cast<const char*>( data ); size > 0; ) {
+				auto n = write( p, ptr, size );
+				if ( n < 0 && errno == EINTR )
+					continue;
+				if ( n <= 0 )
+					return false;
+				ptr += n;
+				size -= size_t( n );
+			}
+			return true;
+		}
+#endif
+
+		bool WriteMessage( pipe_t p, MessageType type, std::uint64_t scenario_id, const void* data = nullptr, size_t size = 0 ) {
+			MessageHeader h{ type, std::uint32_t( size ), scenario_id };
+			return WriteBytes( p, &h, sizeof( h ) ) && WriteBytes( p, data, size );
+		}
+
+		ReadStatus ReadMessage( pipe_t p, MessageHeader& h, std::vector< char >& payload, clock::time_point deadline = no_deadline ) {
+			if ( auto s = ReadBytes( p, &h, sizeof( h ), deadline ); s != ReadStatus::Ok )
+				return s;
+			payload.resize( h.size );
+			return ReadBytes( p, payload.data(), payload.size(), deadline );
+		}
+
+		// process creation is serialized, so that workers don't inherit each other's pipes
+		std::mutex g_worker_start_mutex;
+	}
+
+	// connection to a single worker process
+	struct ProcessEvaluator::Worker
+	{
+		Worker( const path& exe, int node ) : executable( exe ), numa_node( node ) { Start(); }
+		~Worker() { Stop( false ); }
+
+		void Start();
+		void Stop( bool kill );
+		void Restart() { Stop( true ); Start(); }
+
+		// evaluate values with the objective of scenario s, a timeout of 0 waits indefinitely
+		// returns Failed if the worker has stopped responding and TimedOut if it has not responded in time
+		ReadStatus Evaluate( const Scenario& s, const spot::par_vec& values, double timeout, result<fitness_t>& r );
+
+		// release the objective of a scenario, if it has been sent to this worker
+		void Forget( std::uint64_t scenario_id );
+
+		std::mutex mutex; // locked while the worker is used, because evaluate() can be called concurrently
+		path executable;
+		int numa_node; // -1 for no pinning
+		std::map< std::uint64_t, std::uint64_t > scenarios; // scenarios that have been sent to this worker, with their last sent generation
+		std::vector< char > payload;
+#ifdef _WIN32
+		HANDLE process = nullptr;
+#else
+		pid_t pid = -1;
+#endif
+		pipe_t to_worker;
+		pipe_t from_worker;
+	};
+
+	void ProcessEvaluator::Worker::Start()
+	{
+		auto lock = std::scoped_lock( g_worker_start_mutex );
+		scenarios.clear();
+#ifdef _WIN32
+		SECURITY_ATTRIBUTES sa{ sizeof( SECURITY_ATTRIBUTES ), nullptr, TRUE };
+		HANDLE child_in = nullptr, child_out = nullptr;
+		SCONE_ERROR_IF( !CreatePipe( &child_in, &to_worker, &sa, 0 ) || !CreatePipe( &from_worker, &child_out, &sa, 0 ), "Could not create worker pipes" );
+		SetHandleInformation( to_worker, HANDLE_FLAG_INHERIT, 0 );
+		SetHandleInformation( from_worker, HANDLE_FLAG_INHERIT, 0 );
+
+		STARTUPINFOA si{};
+		si.cb = sizeof( si );
+		si.dwFlags = STARTF_USESTDHANDLES;
+		si.hStdInput = child_in;
+		si.hStdOutput = child_out;
+		si.hStdError = GetStdHandle( STD_ERROR_HANDLE );
+		PROCESS_INFORMATION pi{};
+		String cmd = "\"" + executable.str() + "\" --worker";
+		bool ok = CreateProcessA( nullptr, &cmd[ 0 ], nullptr, nullptr, TRUE, CREATE_SUSPENDED | CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi );
+		CloseHandle( child_in );
+		CloseHandle( child_out );
+		SCONE_ERROR_IF( !ok, "Could not start " + executable.str() );
+
+		ULONGLONG mask = 0;
+		if ( numa_node >= 0 && GetNumaNodeProcessorMask( UCHAR( numa_node ), &mask ) && mask != 0 )
+			SetProcessAffinityMask( pi.hProcess, DWORD_PTR( mask ) );
+		ResumeThread( pi.hThread );
+		CloseHandle( pi.hThread );
+		process = pi.hProcess;
+#else
+		// prepare everything before fork(), the child process should only call exec
+		String exe = executable.str();
+		char worker_arg[] = "--worker";
+		char* argv[] = { &exe[ 0 ], worker_arg, nullptr };
+		cpu_set_t cpus;
+		CPU_ZERO( &cpus );
+		bool pin = false;
+		if ( numa_node >= 0 )
+		{
+			// cpulist contains comma separated ranges, e.g. 0-7,16-23
+			std::ifstream str( "/sys/devices/system/node/node" + std::to_string( numa_node ) + "/cpulist" );
+			for ( int first, last; str >> first; )
+			{
+				last = first;
+				if ( str.peek() == '-' )
+					str.ignore() >> last;
+				for ( int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu )
+					CPU_SET( cpu, &cpus ), pin = true;
+				if ( str.peek() == ',' )
+					str.ignore();
+			}
+		}
+
+		int in[ 2 ], out[ 2 ];
+		SCONE_ERROR_IF( pipe( in ) != 0 || pipe( out ) != 0, "Could not create worker pipes" );
+		fcntl( in[ 1 ], F_SETFD, FD_CLOEXEC );
+		fcntl( out[ 0 ], F_SETFD, FD_CLOEXEC );
+		pid = fork();
+		if ( pid == 0 )
+		{
+			dup2( in[ 0 ], 0 );
+			dup2( out[ 1 ], 1 );
+			close( in[ 0 ] );
+			close( out[ 1 ] );
+			if ( pin )
+				sched_setaffinity( 0, sizeof( cpus ), &cpus );
+			execv( argv[ 0 ], argv );
+			_exit( 127 );
+		}
+		close( in[ 0 ] );
+		close( out[ 1 ] );
+		to_worker = in[ 1 ];
+		from_worker = out[ 0 ];
+		if ( pid < 0 )
+		{
+			close( to_worker );
+			close( from_worker );
+			SCONE_ERROR( "Could not start " + exe );
+		}
+#endif
+	}
+
+	void ProcessEvaluator::Worker::Stop( bool kill )
+	{
+#ifdef _WIN32
+		if ( process )
+		{
+			if ( !kill )
+				WriteMessage( to_worker, QuitMessage, 0 );
+			CloseHandle( to_worker );
+			CloseHandle( from_worker );
+
+			// give the worker some time to quit, terminate it if it doesn't
+			const auto quit_ms = DWORD( std::chrono::milliseconds( worker_quit_timeout ).count() );
+			if ( kill || WaitForSingleObject( process, quit_ms ) != WAIT_OBJECT_0 )
+			{
+				TerminateProcess( process, 1 );
+				if ( WaitForSingleObject( process, quit_ms ) != WAIT_OBJECT_0 )
+					log::warning( "Could not terminate evaluation worker" );
+			}
+			CloseHandle( process );
+			process = nullptr;
+		}
+#else
+		if ( pid > 0 )
+		{
+			if ( !kill )
+				WriteMessage( to_worker, QuitMessage, 0 );
+			close( to_worker );
+			close( from_worker );
+
+			// give the worker some time to quit, kill it if it doesn't
+			bool exited = false;
+			for ( auto deadline = clock::now() + worker_quit_timeout; !kill && !exited && clock::now() < deadline; )
+			{
+				exited = waitpid( pid, nullptr, WNOHANG ) != 0;
+				if ( !exited )
+					std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+			}
+			if ( !exited )
+			{
+				::kill( pid, SIGKILL );
+				waitpid( pid, nullptr, 0 );
+			}
+			pid = -1;
+		}
+#endif
+	}
+
+	ReadStatus ProcessEvaluator::Worker::Evaluate( const Scenario& s, const spot::par_vec& values, double timeout, result<fitness_t>& r )
+	{
+		auto it = scenarios.find( s.id );
+		if ( it == scenarios.end() )
+		{
+			if ( !WriteMessage( to_worker, ScenarioMessage, s.id, s.text.data(), s.text.size() ) )
+				return ReadStatus::Failed;
+			it = scenarios.emplace( s.id, 0 ).first;
+		}
+
+		// workers that have missed generations only need the most recent one
+		if ( it->second != s.generation )
+		{
+			GenerationPayload g{ s.generation_mu, s.rollout_seed_offset };
+			if ( !WriteMessage( to_worker, GenerationMessage, s.id, &g, sizeof( g ) ) )
+				return ReadStatus::Failed;
+			it->second = s.generation;
+		}
+
+		if ( !WriteMessage( to_worker, EvaluateMessage, s.id, values.data(), values.size() * sizeof( double ) ) )
+			return ReadStatus::Failed;
+
+		MessageHeader h;
+		auto deadline = timeout > 0 ? clock::now() + std::chrono::duration_cast<clock::duration>( std::chrono::duration< double >( timeout ) ) : no_deadline;
+		if ( auto status = ReadMessage( from_worker, h, payload, deadline ); status != ReadStatus::Ok )
+			return status;
+
+		if ( h.type == ResultMessage && payload.size() == sizeof( double ) )
+		{
+			double fitness;
+			std::memcpy( &fitness, payload.data(), sizeof( double ) );
+			r = fitness;
+		}
+		else if ( h.type == ErrorMessage )
+			r = xo::error_message( String( payload.begin(), payload.end() ) );
+		else return ReadStatus::Failed; // invalid response
+		return ReadStatus::Ok;
+	}
+
+	void ProcessEvaluator::Worker::Forget( std::uint64_t scenario_id )
+	{
+		// if the worker has crashed, this is noticed at the next evaluation
+		if ( scenarios.erase( scenario_id ) > 0 )
+			WriteMessage( to_worker, ForgetMessage, scenario_id );
+	}
+
+	ProcessEvaluator::ProcessEvaluator( size_t worker_count, size_t numa_nodes, const path& executable ) :
+		max_retries( 2 ),
+		evaluation_timeout( 600 ),
+		worker_count_( 0 ),
+		numa_nodes_( 0 ),
+		restart_count_( 0 )
+	{
+#ifdef _WIN32
+		executable_ = executable.empty() ? xo::get_application_dir() / "sconecmd.exe" : executable;
+#else
+		signal( SIGPIPE, SIG_IGN ); // writing to a crashed worker should fail instead of terminating the process
+		executable_ = executable.empty() ? xo::get_application_dir() / "sconecmd" : executable;
+#endif
+		SCONE_ERROR_IF( !xo::file_exists( executable_ ), "Could not find worker executable " + executable_.str() );
+		SetWorkerCount( worker_count, numa_nodes );
+	}
+
+	ProcessEvaluator::~ProcessEvaluator()
+	{}
+
+	void ProcessEvaluator::SetWorkerCount( size_t worker_count, size_t numa_nodes )
+	{
+		if ( worker_count == 0 )
+			worker_count = std::max< size_t >( 1, std::thread::hardware_concurrency() );
+		if ( worker_count == worker_count_ && numa_nodes == numa_nodes_ )
+			return;
+
+		auto lock = std::unique_lock( workers_mutex_ );
+		if ( worker_count == worker_count_ && numa_nodes == numa_nodes_ )
+			return; // changed by another thread
+		if ( numa_nodes != numa_nodes_ )
+			workers_.clear(); // workers are pinned when they are started
+		while ( workers_.size() > worker_count )
+			workers_.pop_back();
+		for ( index_t i = workers_.size(); i < worker_count; ++i )
+			workers_.push_back( std::make_unique< Worker >( executable_, numa_nodes > 0 ? int( i % numa_nodes ) : -1 ) );
+		worker_count_ = worker_count;
+		numa_nodes_ = numa_nodes;
+
+		if ( numa_nodes > 0 )
+			log::info( "Using ", worker_count, " evaluation workers on ", numa_nodes, " NUMA nodes" );
+		else log::info( "Using ", worker_count, " evaluation workers" );
+	}
+
+	void ProcessEvaluator::AddScenario( const spot::objective& o, const PropNode& scenario_pn, const path& scenario_dir )
+	{
+		static std::atomic< std::uint64_t > scenario_count{ 0 };
+		xo::error_code ec;
+		std::ostringstream str;
+		str << scenario_dir.str() << '\n' << xo::prop_node_serializer_zml_concise( scenario_pn, &ec );
+		SCONE_ERROR_IF( !ec.good(), "Could not serialize scenario: " + ec.message() );
+
+		auto lock = std::scoped_lock( scenarios_mutex_ );
+		if ( auto it = scenarios_.find( &o ); it != scenarios_.end() )
+			++it->second.use_count; // shared objective, see CmaPoolOptimizer
+		else scenarios_[ &o ] = Scenario{ ++scenario_count, str.str(), 1 };
+	}
+
+	void ProcessEvaluator::BeginGeneration( const spot::objective& o, size_t mu, int rollout_seed_offset )
+	{
+		auto lock = std::scoped_lock( scenarios_mutex_ );
+		auto it = scenarios_.find( &o );
+		SCONE_ERROR_IF( it == scenarios_.end(), "ProcessEvaluator cannot start a generation for objectives without a scenario" );
+		auto& s = it->second;
+		++s.generation;
+		s.generation_mu = mu;
+		s.rollout_seed_offset = rollout_seed_offset;
+	}
+
+	void ProcessEvaluator::RemoveScenario( const spot::objective& o )
+	{
+		std::uint64_t id = 0;
+		{
+			auto lock = std::scoped_lock( scenarios_mutex_ );
+			auto it = scenarios_.find( &o );
+			if ( it == scenarios_.end() || --it->second.use_count > 0 )
+				return;
+			id = it->second.id;
+			scenarios_.erase( it );
+		}
+
+		auto lock = std::shared_lock( workers_mutex_ );
+		for ( auto& w : workers_ )
+		{
+			auto worker_lock = std::scoped_lock( w->mutex );
+			w->Forget( id );
+		}
+	}
+
+	ProcessEvaluator::Scenario ProcessEvaluator::GetScenario( const spot::objective& o )
+	{
+		auto lock = std::scoped_lock( scenarios_mutex_ );
+		auto it = scenarios_.find( &o );
+		SCONE_ERROR_IF( it == scenarios_.end(), "ProcessEvaluator cannot evaluate objectives without a scenario" );
+		return it->second;
+	}
+
+	std::vector< result<fitness_t> > ProcessEvaluator::evaluate( const spot::objective& o, const spot::search_point_vec& point_vec, const xo::stop_token& st, spot::priority_t prio )
+	{
+		const auto scenario = GetScenario( o );
+		std::vector< result<fitness_t> > results( point_vec.size(), xo::error_message( "Optimization canceled" ) );
+
+		// each worker is driven by a thread that evaluates the next available search point
+		// workers are shared with concurrent calls (e.g. from CmaPoolOptimizer), so each evaluation locks its worker
+		auto lock = std::shared_lock( workers_mutex_ );
+		std::atomic< size_t > next_point{ 0 };
+		auto worker_thread = [&]( Worker& w ) {
+			for ( size_t idx = next_point++; idx < point_vec.size() && !st.stop_requested(); idx = next_point++ )
+			{
+				auto worker_lock = std::scoped_lock( w.mutex );
+				results[ idx ] = EvaluateOnWorker( w, scenario, point_vec[ idx ] );
+			}
+		};
+
+		std::vector< std::thread > threads;
+		for ( index_t i = 0; i < workers_.size() && i < point_vec.size(); ++i )
+			threads.emplace_back( worker_thread, std::ref( *workers_[ i ] ) );
+		for ( auto& t : threads )
+			t.join();
+
+		return results;
+	}
+
+	result<fitness_t> ProcessEvaluator::EvaluateOnWorker( Worker& w, const Scenario& s, const spot::search_point& point )
+	{
+		result<fitness_t> r = xo::error_message( "Evaluation worker failed" );
+		const double timeout = evaluation_timeout;
+		for ( size_t attempt = 0; attempt <= max_retries; ++attempt )
+		{
+			auto status = w.Evaluate( s, point.values(), timeout, r );
+			if ( status == ReadStatus::Ok )
+				return r;
+
+			// the worker crashed or is stuck, start a new one
+			if ( status == ReadStatus::TimedOut )
+				log::warning( "Evaluation worker did not respond within ", timeout, "s, restarting" );
+			else log::warning( "Evaluation worker stopped responding, restarting" );
+			++restart_count_;
+			try { w.Restart(); }
+			catch ( const std::exception& e ) { return xo::error_message( e.what() ); }
+
+			// a search point that timed out would most likely time out again, so it is not retried
+			if ( status == ReadStatus::TimedOut )
+				return xo::error_message( "Evaluation timed out after " + to_str( timeout ) + "s" );
+		}
+		return r;
+	}
+
+	int ProcessEvaluator::RunWorker()
+	{
+		// use a private copy of stdout for the protocol, and redirect stdout to stderr,
+		// so that output from the simulation (e.g. OpenSim messages) can't interfere
+#ifdef _WIN32
+		pipe_t in = GetStdHandle( STD_INPUT_HANDLE ), out = nullptr;
+		DuplicateHandle( GetCurrentProcess(), GetStdHandle( STD_OUTPUT_HANDLE ), GetCurrentProcess(), &out, 0, FALSE, DUPLICATE_SAME_ACCESS );
+		_dup2( 2, 1 );
+		SetStdHandle( STD_OUTPUT_HANDLE, GetStdHandle( STD_ERROR_HANDLE ) );
+#else
+		pipe_t in = 0, out = dup( 1 );
+		dup2( 2, 1 );
+#endif
+
+		// workers evaluate sequentially, and should never start workers of their own
+		GetSconeSettings().set< int >( "optimizer.evaluator", 0 );
+
+		// objectives are kept for subsequent evaluations, together with the props they refer to
+		struct WorkerScenario
+		{
+			PropNode scenario_pn;
+			OptimizerUP optimizer;
+			String error;
+		};
+		std::map< std::uint64_t, WorkerScenario > scenarios;
+
+		MessageHeader h;
+		std::vector< char > payload;
+		while ( ReadMessage( in, h, payload ) == ReadStatus::Ok && h.type != QuitMessage )
+		{
+			if ( h.type == ScenarioMessage )
+			{
+				auto& s = scenarios[ h.scenario_id ];
+				try
+				{
+					auto text = String( payload.begin(), payload.end() );
+					auto dir_end = text.find( '\n' );
+					SCONE_ERROR_IF( dir_end == String::npos, "Invalid scenario message" );
+					xo::error_code ec;
+					std::istringstream str( text.substr( dir_end + 1 ) );
+					xo::prop_node_serializer_zml zml( s.scenario_pn, &ec );
+					str >> zml;
+					SCONE_ERROR_IF( !ec.good(), "Could not read scenario: " + ec.message() );
+					s.optimizer = CreateOptimizer( s.scenario_pn, path( text.substr( 0, dir_end ) ) );
+				}
+				catch ( const std::exception& e )
+				{
+					s.error = e.what();
+				}
+			}
+			else if ( h.type == ForgetMessage )
+			{
+				scenarios.erase( h.scenario_id );
+			}
+			else if ( h.type == GenerationMessage )
+			{
+				// errors in the scenario are reported when evaluating
+				auto it = scenarios.find( h.scenario_id );
+				if ( it != scenarios.end() && it->second.optimizer && payload.size() == sizeof( GenerationPayload ) )
+				{
+					GenerationPayload g;
+					std::memcpy( &g, payload.data(), sizeof( g ) );
+					if ( auto* mo = dynamic_cast<ModelObjective*>( &it->second.optimizer->GetObjective() ) )
+						mo->BeginGeneration( size_t( g.mu ), int( g.rollout_seed_offset ) );
+				}
+			}
+			else if ( h.type == EvaluateMessage )
+			{
+				String error;
+				double fitness = 0.0;
+				try
+				{
+					auto it = scenarios.find( h.scenario_id );
+					SCONE_ERROR_IF( it == scenarios.end(), "Unknown scenario" );
+					SCONE_ERROR_IF( !it->second.optimizer, it->second.error );
+					auto& obj = it->second.optimizer->GetObjective();
+					spot::par_vec values( payload.size() / sizeof( double ) );
+					std::memcpy( values.data(), payload.data(), values.size() * sizeof( double ) );
+					SCONE_ERROR_IF( values.size() != obj.dim(), "Invalid number of parameters" );
+					auto r = obj.evaluate( SearchPoint( obj.info(), values ), xo::stop_token() );
+					if ( r )
+						fitness = r.value();
+					else error = r.error().message();
+				}
+				catch ( const std::exception& e )
+				{
+					error = e.what();
+				}
+
+				bool ok = error.empty() ?
+					WriteMessage( out, ResultMessage, h.scenario_id, &fitness, sizeof( fitness ) ) :
+					WriteMessage( out, ErrorMessage, h.scenario_id, error.data(), error.size() );
+				if ( !ok )
+					break;
+			}
+		}
+		return 0;
+	}
+}
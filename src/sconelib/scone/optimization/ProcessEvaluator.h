@@ -0,0 +1,95 @@
+/*
+** ProcessEvaluator.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "scone/core/platform.h"
+#include "scone/core/types.h"
+#include "scone/core/PropNode.h"
+#include "Objective.h"
+#include "spot/evaluator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace scone
+{
+	/// Evaluator that distributes search points over a pool of persistent sconecmd worker processes.
+	/** Each worker receives the scenario of an objective once, after which it keeps the objective (and its models) for
+	subsequent evaluations. Search points and results are passed through pipes using a compact binary protocol.
+	Workers that crash are restarted, after which their search point is evaluated again.
+	Workers that do not respond within ''evaluation_timeout'' are killed and restarted.
+	Generations are forwarded to the ModelObjective of each worker, so rollouts use the same seeds in all workers.
+	Early termination then uses the results of each worker separately, which truncates fewer evaluations, but never one that
+	could be among the best ''mu'' of a generation.
+	Workers can be distributed over NUMA nodes, in which case each worker only runs on the processors of its node. */
+	class SCONE_API ProcessEvaluator : public spot::evaluator
+	{
+	public:
+		/// Create worker_count workers (0 = hardware concurrency), pinned to numa_nodes nodes (0 = no pinning).
+		ProcessEvaluator( size_t worker_count, size_t numa_nodes = 0, const path& executable = path() );
+		ProcessEvaluator( const ProcessEvaluator& ) = delete;
+		ProcessEvaluator& operator=( const ProcessEvaluator& ) = delete;
+		virtual ~ProcessEvaluator();
+
+		/// Start or stop workers to match worker_count (0 = hardware concurrency) and numa_nodes; waits for running evaluations if they change.
+		void SetWorkerCount( size_t worker_count, size_t numa_nodes = 0 );
+
+		/// Register the scenario from which objective o was created; it is sent to the workers that evaluate o.
+		/** Registering an objective that is already registered only increases its use count. */
+		void AddScenario( const spot::objective& o, const PropNode& scenario_pn, const path& scenario_dir );
+
+		/// Decrease the use count of the scenario of objective o; if it becomes zero, workers release the objective of the scenario.
+		void RemoveScenario( const spot::objective& o );
+
+		/// Start a new generation in the ModelObjective of the workers that evaluate o, see ModelObjective::BeginGeneration().
+		/** Workers receive the generation before their next evaluation of o. */
+		void BeginGeneration( const spot::objective& o, size_t mu, int rollout_seed_offset );
+
+		virtual std::vector< result<fitness_t> > evaluate( const spot::objective& o, const spot::search_point_vec& point_vec, const xo::stop_token& st, spot::priority_t prio ) override;
+
+		/// Number of workers that were restarted after they crashed.
+		size_t GetRestartCount() const { return restart_count_; }
+
+		/// Number of times a search point is evaluated again after its worker crashed; default = 2.
+		size_t max_retries;
+
+		/// Time [s] after which an evaluation is aborted and its worker is restarted, 0 = no timeout; default = 600.
+		std::atomic< double > evaluation_timeout;
+
+		/// Serve evaluation requests from stdin / stdout, returns when the connection is closed (see sconecmd --worker).
+		static int RunWorker();
+
+	private:
+		struct Worker;
+		struct Scenario
+		{
+			std::uint64_t id;
+			String text; // scenario_dir and scenario_pn as zml, separated by a newline
+			size_t use_count;
+			std::uint64_t generation = 0; // incremented by BeginGeneration(), workers start at 0
+			size_t generation_mu = 0;
+			int rollout_seed_offset = 0;
+		};
+		Scenario GetScenario( const spot::objective& o );
+		result<fitness_t> EvaluateOnWorker( Worker& w, const Scenario& s, const spot::search_point& point );
+
+		path executable_;
+		std::vector< u_ptr< Worker > > workers_;
+		std::atomic< size_t > worker_count_;
+		std::atomic< size_t > numa_nodes_;
+		std::shared_mutex workers_mutex_; // exclusive when workers are added or removed
+		std::map< const spot::objective*, Scenario > scenarios_;
+		std::mutex scenarios_mutex_;
+		std::atomic< size_t > restart_count_;
+	};
+}
@@ -33,6 +33,7 @@ namespace scone
 		virtual void AdvanceSimulationTo( Model& m, TimeInSeconds t ) const override;
 		virtual TimeInSeconds GetDuration() const override { return max_duration; }
 		virtual fitness_t GetResult( Model& m ) const override { return m.GetMeasure()->GetWeightedResult( m ); }
+		virtual fitness_t GetResultBound( Model& m ) const override { return m.GetMeasure()->GetWeightedResultBound( m ); }
 		virtual PropNode GetReport( Model& m ) const override { return m.GetMeasure()->GetReport(); }
 	};
 }
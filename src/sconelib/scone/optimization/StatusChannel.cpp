@@ -0,0 +1,254 @@
+/*
+** StatusChannel.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "StatusChannel.h"
+
+#include "scone/core/Exception.h"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#	define NOMINMAX
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace scone
+{
+	namespace
+	{
+		constexpr char status_channel_magic[ 8 ] = { 'S', 'C', 'O', 'N', 'E', 'S', 'T', 'C' };
+		constexpr std::uint32_t status_channel_version = 2;
+
+		String to_string( const char* s, size_t max_size ) { return String( s, strnlen( s, max_size ) ); }
+	}
+
+	// file header, followed by capacity records
+	struct StatusChannel::Header
+	{
+		char magic[ 8 ];
+		std::uint32_t version;
+		std::uint32_t record_size;
+		std::uint64_t capacity;
+		std::atomic< std::uint64_t > write_count; // number of records that have been written
+		std::atomic< std::uint64_t > begin_count; // number of records of which writing has started
+	};
+	static_assert( std::atomic< std::uint64_t >::is_always_lock_free, "StatusChannel requires lock-free 64-bit atomics" );
+
+	bool StatusRecord::SetId( const String& s )
+	{
+		std::strncpy( id, s.c_str(), sizeof( id ) - 1 );
+		return s.size() < sizeof( id );
+	}
+
+	bool StatusRecord::SetText( const String& s )
+	{
+		std::strncpy( text, s.c_str(), sizeof( text ) - 1 );
+		return s.size() < sizeof( text );
+	}
+
+	PropNode StatusRecord::ToPropNode() const
+	{
+		PropNode pn;
+		if ( id[ 0 ] != 0 )
+			pn[ "id" ] = to_string( id, sizeof( id ) );
+		switch ( type )
+		{
+		case Start:
+			pn.set( "folder", to_string( text, sizeof( text ) ) );
+			pn.set( "dim", dim );
+			pn.set( "sigma", sigma );
+			pn.set( "lambda", lambda );
+			pn.set( "mu", mu );
+			pn.set( "max_generations", max_generations );
+			pn.set( "minimize", ( flags & Minimize ) != 0 );
+			pn.set( "window_size", window_size );
+			break;
+		case Generation:
+			pn.set( "step", step );
+			pn.set( "step_best", step_best );
+			pn.set( "step_median", step_median );
+			pn.set( "trend_offset", trend_offset );
+			pn.set( "trend_slope", trend_slope );
+			pn.set( "progress", progress );
+			pn.set( "predicted_fitness", predicted_fitness );
+			pn.set( "time", time );
+			pn.set( "number_of_evaluations", number_of_evaluations );
+			pn.set( "evaluations_per_sec", evaluations_per_sec );
+			if ( flags & NewBest )
+			{
+				pn.set( "best", best );
+				pn.set( "best_gen", step );
+			}
+			break;
+		case Finished:
+			pn.set( "finished", to_string( text, sizeof( text ) ) );
+			break;
+		default: SCONE_THROW( "Invalid status record type" );
+		}
+		return pn;
+	}
+
+	StatusChannel::StatusChannel( const path& file, Mode mode, size_t capacity ) :
+		file_( file ),
+		mode_( mode ),
+		capacity_( capacity ),
+		data_( nullptr ),
+		size_( 0 ),
+		read_count_( 0 ),
+		lost_records_( 0 )
+#ifdef _WIN32
+		, file_handle_( INVALID_HANDLE_VALUE ),
+		mapping_( nullptr )
+#endif
+	{
+		if ( mode_ == WriteMode )
+		{
+			SCONE_ERROR_IF( capacity_ == 0, "StatusChannel capacity must be larger than 0" );
+			size_ = sizeof( Header ) + capacity_ * sizeof( StatusRecord );
+#ifdef _WIN32
+			file_handle_ = CreateFileA( file.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+				nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+			SCONE_ERROR_IF( file_handle_ == INVALID_HANDLE_VALUE, "Could not create " + file.str() );
+			mapping_ = CreateFileMappingA( file_handle_, nullptr, PAGE_READWRITE, DWORD( std::uint64_t( size_ ) >> 32 ), DWORD( size_ ), nullptr );
+			if ( mapping_ )
+				data_ = static_cast<char*>( MapViewOfFile( mapping_, FILE_MAP_WRITE, 0, 0, size_ ) );
+#else
+			int fd = open( file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+			SCONE_ERROR_IF( fd == -1, "Could not create " + file.str() );
+			if ( ftruncate( fd, off_t( size_ ) ) == 0 )
+			{
+				void* ptr = mmap( nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+				data_ = ptr != MAP_FAILED ? static_cast<char*>( ptr ) : nullptr;
+			}
+			close( fd );
+#endif
+			if ( !data_ )
+			{
+				Unmap();
+				SCONE_ERROR( "Could not map " + file.str() );
+			}
+
+			// the magic is written last, so readers don't use the file before it is initialized
+			auto* h = new( data_ ) Header();
+			h->version = status_channel_version;
+			h->record_size = sizeof( StatusRecord );
+			h->capacity = capacity_;
+			h->write_count.store( 0 );
+			h->begin_count.store( 0 );
+			std::atomic_thread_fence( std::memory_order_release );
+			std::memcpy( h->magic, status_channel_magic, sizeof( h->magic ) );
+		}
+		else
+		{
+#ifdef _WIN32
+			file_handle_ = CreateFileA( file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+				nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+			SCONE_ERROR_IF( file_handle_ == INVALID_HANDLE_VALUE, "Could not open " + file.str() );
+			LARGE_INTEGER size;
+			GetFileSizeEx( file_handle_, &size );
+			size_ = static_cast<size_t>( size.QuadPart );
+			mapping_ = size_ >= sizeof( Header ) ? CreateFileMappingA( file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr ) : nullptr;
+			if ( mapping_ )
+				data_ = static_cast<char*>( MapViewOfFile( mapping_, FILE_MAP_READ, 0, 0, 0 ) );
+#else
+			int fd = open( file.c_str(), O_RDONLY );
+			SCONE_ERROR_IF( fd == -1, "Could not open " + file.str() );
+			struct stat st;
+			if ( fstat( fd, &st ) == 0 && size_t( st.st_size ) >= sizeof( Header ) )
+			{
+				size_ = static_cast<size_t>( st.st_size );
+				void* ptr = mmap( nullptr, size_, PROT_READ, MAP_SHARED, fd, 0 );
+				data_ = ptr != MAP_FAILED ? static_cast<char*>( ptr ) : nullptr;
+			}
+			close( fd );
+#endif
+			const auto* h = data_ ? &GetHeader() : nullptr;
+			const bool valid = h && std::memcmp( h->magic, status_channel_magic, sizeof( h->magic ) ) == 0
+				&& h->version == status_channel_version && h->record_size == sizeof( StatusRecord )
+				&& h->capacity > 0 && size_ >= sizeof( Header ) + h->capacity * sizeof( StatusRecord );
+			if ( !valid )
+			{
+				Unmap();
+				SCONE_ERROR( "Invalid status file " + file.str() );
+			}
+			std::atomic_thread_fence( std::memory_order_acquire );
+			capacity_ = h->capacity;
+		}
+	}
+
+	StatusChannel::~StatusChannel()
+	{
+		Unmap();
+	}
+
+	StatusRecord* StatusChannel::GetRecords() const
+	{
+		return reinterpret_cast<StatusRecord*>( data_ + sizeof( Header ) );
+	}
+
+	void StatusChannel::Write( const StatusRecord& r )
+	{
+		SCONE_ASSERT( mode_ == WriteMode );
+		auto lock = std::scoped_lock( write_mutex_ );
+		auto& h = GetHeader();
+		auto n = h.write_count.load( std::memory_order_relaxed );
+		h.begin_count.store( n + 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+		std::memcpy( GetRecords() + n % capacity_, &r, sizeof( StatusRecord ) );
+		h.write_count.store( n + 1, std::memory_order_release );
+	}
+
+	std::vector< StatusRecord > StatusChannel::Read()
+	{
+		SCONE_ASSERT( mode_ == ReadMode );
+		std::vector< StatusRecord > records;
+		auto& h = GetHeader();
+		auto n = h.write_count.load( std::memory_order_acquire );
+		if ( n - read_count_ > capacity_ )
+		{
+			// records were overwritten before we could read them
+			lost_records_ += n - capacity_ - read_count_;
+			read_count_ = n - capacity_;
+		}
+
+		for ( ; read_count_ < n; ++read_count_ )
+		{
+			StatusRecord r;
+			std::memcpy( &r, GetRecords() + read_count_ % capacity_, sizeof( StatusRecord ) );
+
+			// discard the record if the writer has started overwriting it while it was being copied
+			std::atomic_thread_fence( std::memory_order_acquire );
+			if ( h.begin_count.load( std::memory_order_relaxed ) > read_count_ + capacity_ )
+				++lost_records_;
+			else records.push_back( r );
+		}
+		return records;
+	}
+
+	void StatusChannel::Unmap()
+	{
+#ifdef _WIN32
+		if ( data_ ) UnmapViewOfFile( data_ );
+		if ( mapping_ ) CloseHandle( mapping_ );
+		if ( file_handle_ != INVALID_HANDLE_VALUE ) CloseHandle( file_handle_ );
+		mapping_ = nullptr;
+		file_handle_ = INVALID_HANDLE_VALUE;
+#else
+		if ( data_ ) munmap( data_, size_ );
+#endif
+		data_ = nullptr;
+	}
+}
@@ -0,0 +1,92 @@
+/*
+** StatusChannel.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include "scone/core/platform.h"
+#include "scone/core/types.h"
+#include "scone/core/PropNode.h"
+#include "xo/filesystem/path.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace scone
+{
+	/// Fixed-layout status update of a single optimization, see StatusChannel.
+	struct SCONE_API StatusRecord
+	{
+		enum Type : std::uint32_t { Start = 1, Generation = 2, Finished = 3 };
+		enum Flags : std::uint32_t { NewBest = 1, Minimize = 2 };
+
+		std::uint32_t type = 0;
+		std::uint32_t flags = 0;
+		char id[ 256 ] = {};
+		char text[ 512 ] = {}; // output folder for Start, message for Finished
+
+		// Start
+		std::uint64_t dim = 0, lambda = 0, mu = 0, max_generations = 0, window_size = 0;
+		double sigma = 0;
+
+		// Generation
+		std::uint64_t step = 0, number_of_evaluations = 0;
+		double step_best = 0, step_median = 0, trend_offset = 0, trend_slope = 0, progress = 0;
+		double predicted_fitness = 0, time = 0, evaluations_per_sec = 0, best = 0;
+
+		/// Copy s into id or text, returns false if s was truncated because it does not fit.
+		bool SetId( const String& s );
+		bool SetText( const String& s );
+
+		/// Convert to a PropNode with the same keys as the text status messages of CmaOptimizerReporter.
+		PropNode ToPropNode() const;
+	};
+
+	/// Ring buffer of StatusRecords in a memory mapped file, for passing optimization status between processes.
+	/** There is a single writing process, which overwrites the oldest records when the buffer is full.
+	Readers poll the file without locking, records that are overwritten before they are read are skipped. */
+	class SCONE_API StatusChannel
+	{
+	public:
+		enum Mode { WriteMode, ReadMode };
+
+		/// Create a new file in WriteMode, or open an existing file in ReadMode (throws if the file is not valid).
+		StatusChannel( const path& file, Mode mode, size_t capacity = 256 );
+		StatusChannel( const StatusChannel& ) = delete;
+		StatusChannel& operator=( const StatusChannel& ) = delete;
+		~StatusChannel();
+
+		/// Add a record, can be called from multiple threads (WriteMode only).
+		void Write( const StatusRecord& r );
+
+		/// Get the records that were written since the previous call (ReadMode only).
+		std::vector< StatusRecord > Read();
+
+		const path& GetFile() const { return file_; }
+		size_t GetLostRecordCount() const { return lost_records_; }
+
+	private:
+		struct Header;
+		Header& GetHeader() const { return *reinterpret_cast<Header*>( data_ ); }
+		StatusRecord* GetRecords() const;
+		void Unmap();
+
+		path file_;
+		Mode mode_;
+		size_t capacity_;
+		char* data_;
+		size_t size_;
+		std::uint64_t read_count_;
+		size_t lost_records_;
+		std::mutex write_mutex_;
+#ifdef _WIN32
+		void* file_handle_;
+		void* mapping_;
+#endif
+	};
+}
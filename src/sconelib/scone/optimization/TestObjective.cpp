@@ -9,7 +9,9 @@
 #include "TestObjective.h"
 
 #include "spot_test/test_functions.h"
+#include "xo/numerical/math.h"
 #include "xo/string/string_tools.h"
+#include "scone/core/Exception.h"
 #include "scone/core/string_tools.h"
 
 namespace scone
@@ -22,22 +24,53 @@ namespace scone
 		return 418.9829 * v.size() - sum;
 	}
 
+	double sphere( const spot::par_vec& v )
+	{
+		double sum = 0.0;
+		for ( index_t i = 0; i < v.size(); ++i )
+			sum += v[ i ] * v[ i ];
+		return sum;
+	}
+
+	double rosenbrock( const spot::par_vec& v )
+	{
+		double sum = 0.0;
+		for ( index_t i = 0; i + 1 < v.size(); ++i )
+			sum += 100 * xo::squared( v[ i + 1 ] - v[ i ] * v[ i ] ) + xo::squared( 1 - v[ i ] );
+		return sum;
+	}
+
 	TestObjective::TestObjective( const PropNode& pn, const path& find_file_folder ) :
 	Objective( pn, find_file_folder )
 	{
 		INIT_PROP( pn, dim_, 10 );
+		INIT_PROP( pn, function_, String( "schwefel" ) );
+		SCONE_ERROR_IF( function_ != "schwefel" && function_ != "sphere" && function_ != "rosenbrock", "Invalid function: " + function_ );
 
+		// initial distributions do not contain the optimum at their mean
 		for ( index_t i = 0; i < dim_; ++i )
-			info_.add( ParInfo( stringf( "P%d", i ), 0, 200, -500, 500 ) );
+		{
+			if ( function_ == "sphere" )
+				info_.add( ParInfo( stringf( "P%d", i ), 1, 1, -10, 10 ) );
+			else if ( function_ == "rosenbrock" )
+				info_.add( ParInfo( stringf( "P%d", i ), 0, 0.5, -5, 5 ) );
+			else info_.add( ParInfo( stringf( "P%d", i ), 0, 200, -500, 500 ) );
+		}
 	}
 
 	fitness_t TestObjective::evaluate( const SearchPoint& point ) const
 	{
-		return schwefel( point.values() );
+		if ( function_ == "sphere" )
+			return sphere( point.values() );
+		else if ( function_ == "rosenbrock" )
+			return rosenbrock( point.values() );
+		else return schwefel( point.values() );
 	}
 
 	String TestObjective::GetClassSignature() const
 	{
-		return stringf( "T%d", dim_ );
+		if ( function_ == "schwefel" )
+			return stringf( "T%d", dim_ );
+		else return stringf( "T%d.", dim_ ) + function_;
 	}
 }
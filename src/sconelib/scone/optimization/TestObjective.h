@@ -12,7 +12,7 @@
 
 namespace scone
 {
-	/// Objective used for testing, evaluates a multi-dimensional Schwefel function.
+	/// Objective used for testing, evaluates a multi-dimensional Schwefel, sphere or Rosenbrock function.
 	class SCONE_API TestObjective : public Objective
 	{
 	public:
@@ -22,6 +22,9 @@ namespace scone
 		/// Dimension of the objective function
 		size_t dim_;
 
+		/// Function to evaluate: ''schwefel'', ''sphere'' or ''rosenbrock''; default = schwefel.
+		String function_;
+
 		virtual fitness_t evaluate( const SearchPoint& point ) const override;
 
 	protected:
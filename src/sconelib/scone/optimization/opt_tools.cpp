@@ -18,8 +18,17 @@
 #include "xo/serialization/char_stream.h"
 #include "xo/utility/irange.h"
 #include "xo/container/container_algorithms.h"
+#include "xo/string/pattern_matcher.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
 
 using xo::timer;
+namespace fs = std::filesystem;
 
 namespace scone
 {
@@ -78,4 +87,147 @@ namespace scone
 		auto folder = file.parent_path();
 		return xo::find_file( { path( file ).replace_extension( "scone" ), folder / "config.scone", folder / "config.xml" } );
 	}
+
+	// generation prefix of a .par file, compared as number because it is not zero-padded (9999_x.par < 10000_x.par)
+	std::pair< unsigned long long, String > ParFileOrder( const fs::path& file )
+	{
+		auto name = file.filename().string();
+		return { std::strtoull( name.c_str(), nullptr, 10 ), name };
+	}
+
+	// add the most recent .par file of folder and its subfolders, .par files are prefixed with the generation
+	void FindLatestParFiles( const fs::path& folder, std::vector< path >& par_files )
+	{
+		fs::path latest;
+		std::vector< fs::path > subfolders;
+		for ( const auto& entry : fs::directory_iterator( folder ) )
+		{
+			if ( entry.is_directory() )
+				subfolders.push_back( entry.path() );
+			else if ( entry.path().extension() == ".par" && ( latest.empty() || ParFileOrder( latest ) < ParFileOrder( entry.path() ) ) )
+				latest = entry.path();
+		}
+		if ( !latest.empty() )
+			par_files.emplace_back( latest.string() );
+
+		std::sort( subfolders.begin(), subfolders.end() );
+		for ( const auto& f : subfolders )
+			FindLatestParFiles( f, par_files );
+	}
+
+	std::vector< path > FindParFiles( const std::vector< String >& files_or_folders )
+	{
+		std::vector< path > par_files;
+		for ( const auto& arg : files_or_folders )
+		{
+			if ( fs::is_directory( arg ) )
+				FindLatestParFiles( fs::path( arg ), par_files );
+			else if ( arg.find_first_of( "*?" ) != String::npos )
+			{
+				// wildcards are matched against the files in the folder of the pattern
+				auto pattern = fs::path( arg );
+				auto folder = pattern.has_parent_path() ? pattern.parent_path() : fs::path( "." );
+				xo::pattern_matcher pm( pattern.filename().string() );
+				std::vector< fs::path > matches;
+				for ( const auto& entry : fs::directory_iterator( folder ) )
+					if ( entry.is_regular_file() && pm( entry.path().filename().string() ) )
+						matches.push_back( entry.path() );
+				std::sort( matches.begin(), matches.end() );
+				for ( const auto& m : matches )
+					par_files.emplace_back( m.string() );
+			}
+			else par_files.emplace_back( arg );
+		}
+		return par_files;
+	}
+
+	PropNode EvaluateScenarioBatch( const std::vector< path >& par_files, size_t thread_count,
+		const std::function< PropNode( const path& ) >& load_scenario )
+	{
+		// load each scenario once, the scenario props must outlive the objective
+		struct Scenario {
+			PropNode props;
+			OptimizerUP optimizer;
+			ModelObjective* objective = nullptr;
+			String error;
+		};
+		std::map< path, Scenario > scenarios;
+		std::vector< std::pair< path, Scenario* > > jobs;
+		for ( const auto& par_file : par_files )
+		{
+			auto scenario_file = FindScenario( par_file );
+			auto [it, is_new] = scenarios.try_emplace( scenario_file );
+			if ( is_new )
+			{
+				log::debug( "Loading ", scenario_file );
+				auto& s = it->second;
+				try
+				{
+					s.props = load_scenario( scenario_file );
+					s.optimizer = CreateOptimizer( s.props, scenario_file.parent_path() );
+					s.objective = dynamic_cast<ModelObjective*>( &s.optimizer->GetObjective() );
+					SCONE_ERROR_IF( !s.objective, "Scenario " + scenario_file.str() + " does not have a ModelObjective" );
+					LogUnusedProperties( s.props );
+				}
+				catch ( const std::exception& e )
+				{
+					s.error = e.what();
+				}
+			}
+			jobs.emplace_back( par_file, &it->second );
+		}
+
+		// evaluate the jobs on a pool of threads, results are written by each thread
+		std::atomic< size_t > next_job{ 0 }, failed{ 0 };
+		std::atomic< double > simulation_time{ 0.0 };
+		auto worker = [&]() {
+			for ( auto idx = next_job++; idx < jobs.size(); idx = next_job++ )
+			{
+				const auto& [par_file, scenario] = jobs[ idx ];
+				try
+				{
+					SCONE_ERROR_IF( !scenario->objective, scenario->error );
+					auto& mo = *scenario->objective;
+					SearchPoint params( mo.info() );
+					params.import_values( par_file );
+					auto model = mo.AcquireModel( params );
+					model->SetStoreData( true );
+					timer tmr;
+					mo.EvaluateModel( *model, xo::stop_token() );
+					auto duration = tmr().seconds();
+					model->WriteResults( par_file );
+					log::info( "Evaluated ", par_file, "; result=", mo.GetResult( *model ), " performance=", model->GetTime() / duration, "x real-time" );
+					for ( auto t = simulation_time.load(); !simulation_time.compare_exchange_weak( t, t + model->GetTime() ); );
+					mo.ReleaseModel( std::move( model ) );
+				}
+				catch ( const std::exception& e )
+				{
+					log::error( "Could not evaluate ", par_file, ": ", e.what() );
+					++failed;
+				}
+			}
+		};
+
+		if ( thread_count == 0 )
+			thread_count = std::max< size_t >( 1, std::thread::hardware_concurrency() );
+		thread_count = std::min( thread_count, jobs.size() );
+		timer tmr;
+		std::vector< std::thread > threads;
+		for ( index_t i = 1; i < thread_count; ++i )
+			threads.emplace_back( worker );
+		worker(); // the current thread evaluates as well
+		for ( auto& t : threads )
+			t.join();
+		auto duration = tmr().seconds();
+
+		PropNode summary;
+		summary.set( "evaluations", jobs.size() - failed );
+		summary.set( "failed", failed.load() );
+		summary.set( "scenarios", scenarios.size() );
+		summary.set( "threads", thread_count );
+		summary.set( "duration", duration );
+		summary.set( "evaluations per second", ( jobs.size() - failed ) / duration );
+		summary.set( "performance (x real-time)", simulation_time / duration );
+		return summary;
+	}
 }
@@ -16,6 +16,9 @@
 #include "scone/core/types.h"
 #include "scone/optimization/Optimizer.h"
 
+#include <functional>
+#include <vector>
+
 namespace scone
 {
 	/// Log unused properties
@@ -26,4 +29,14 @@ namespace scone
 
 	/// Returns .scone file for a given .par file, or returns argument if already .scone.
 	SCONE_API path FindScenario( const path& scenario_or_par_file );
+
+	/// Returns the .par files for a list of files, wildcard patterns and folders.
+	/// For folders, the most recent .par file of the folder and each of its subfolders is used.
+	SCONE_API std::vector< path > FindParFiles( const std::vector< String >& files_or_folders );
+
+	/// Evaluate .par files concurrently using thread_count threads (0 = number of cores), results are written next to each .par file.
+	/// Each scenario is loaded once using load_scenario, its models are reused between the evaluations of that scenario.
+	/// Returns a summary with the number of evaluations and the throughput.
+	SCONE_API PropNode EvaluateScenarioBatch( const std::vector< path >& par_files, size_t thread_count,
+		const std::function< PropNode( const path& ) >& load_scenario );
 }
@@ -50,6 +50,9 @@ namespace scone
 		virtual bool ComputeControls( Model& model, double timestamp ) override;
 		virtual String GetClassSignature() const override;
 
+		// the state of a Lua script cannot be captured
+		virtual std::any GetInternalState() const override { SCONE_THROW( "ScriptController does not support checkpoints" ); }
+
 		u_ptr< class lua_script > script_;
 		std::function<void( struct LuaModel*, struct LuaParams*, double )> init_;
 		std::function<bool( struct LuaModel* )> update_;
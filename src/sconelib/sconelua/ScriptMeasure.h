@@ -55,6 +55,9 @@ namespace scone
 	protected:
 		virtual String GetClassSignature() const override;
 
+		// the state of a Lua script cannot be captured
+		virtual std::any GetInternalState() const override { SCONE_THROW( "ScriptMeasure does not support checkpoints" ); }
+
 	private:
 		u_ptr< class lua_script > script_;
 		std::function<void( struct LuaModel* )> init_;
@@ -87,7 +87,21 @@ namespace scone
 			"muscle_count", &LuaModel::muscle_count,
 			"body", &LuaModel::body,
 			"find_body", &LuaModel::find_body,
-			"body_count", &LuaModel::body_count
+			"body_count", &LuaModel::body_count,
+			"find_actuator_index", &LuaModel::find_actuator_index,
+			"find_dof_index", &LuaModel::find_dof_index,
+			"find_muscle_index", &LuaModel::find_muscle_index,
+			"find_body_index", &LuaModel::find_body_index,
+			"find_state_index", &LuaModel::find_state_index,
+			"find_sensor_index", &LuaModel::find_sensor_index,
+			"add_actuator_inputs", &LuaModel::add_actuator_inputs< sol::table >,
+			"add_actuator_inputs_at", &LuaModel::add_actuator_inputs_at< sol::table >,
+			"get_muscle_excitations", &LuaModel::get_muscle_excitations< sol::table >,
+			"get_muscle_activations", &LuaModel::get_muscle_activations< sol::table >,
+			"get_dof_positions", &LuaModel::get_dof_positions< sol::table >,
+			"get_dof_velocities", &LuaModel::get_dof_velocities< sol::table >,
+			"get_state_values", &LuaModel::get_state_values< sol::table >,
+			"get_sensor_values", &LuaModel::get_sensor_values< sol::table >
 			);
 
 		lua.new_usertype<LuaParams>( "LuaParams", sol::constructors<>(),
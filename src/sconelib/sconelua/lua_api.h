@@ -31,6 +31,20 @@ namespace scone
 		return *it;
 	}
 
+	template< typename T > int GetLuaIndexByName( const std::vector<T>& vec, const std::string& name ) {
+		auto it = std::find_if( vec.begin(), vec.end(), [&]( const T& item ) { return item->GetName() == name; } );
+		SCONE_ERROR_IF( it == vec.end(), "Could not find \"" + name + "\"" );
+		return static_cast<int>( it - vec.begin() ) + 1;
+	}
+
+	// fill a lua array with values [1..n], returns n
+	template< typename LuaTable, typename It, typename F > int FillLuaTable( LuaTable& t, It begin, It end, F get_value ) {
+		int idx = 0;
+		for ( auto it = begin; it != end; ++it )
+			t.raw_set( ++idx, get_value( *it ) );
+		return idx;
+	}
+
 	/// Access to scone logging and parameters
 	/** Use this for logging, or accessing parameters defined in scone. Lua example:
 	\verbatim
@@ -203,7 +217,24 @@ namespace scone
 	};
 
 	/// Model type for use in lua scripting.
-	/// See ScriptController and ScriptMeasure for details on scripting.
+	/** For best performance, look up indices once in init() and use the bulk functions in update(). Lua example:
+	\verbatim
+	function init( model, par, side )
+		targets = { model:find_actuator_index( "soleus_r" ), model:find_actuator_index( "tib_ant_r" ) }
+		inputs = { 0, 0 }
+		excitations = {}
+	end
+
+	function update( model )
+		model:get_muscle_excitations( excitations ) -- fills excitations[1..n]
+		inputs[ 1 ] = 0.1
+		inputs[ 2 ] = 0.5 * excitations[ targets[ 1 ] ]
+		model:add_actuator_inputs_at( targets, inputs )
+		return false
+	end
+	\endverbatim
+	See ScriptController and ScriptMeasure for details on scripting.
+	*/
 	struct LuaModel
 	{
 		LuaModel( Model& m ) : mod_( m ) {}
@@ -245,6 +276,72 @@ namespace scone
 		/// number of bodies
 		int body_count() { return static_cast<int>( mod_.GetBodies().size() ); }
 
+		/// get the index of the actuator with a specific name, for use with actuator() or add_actuator_inputs_at()
+		int find_actuator_index( LuaString name ) { return GetLuaIndexByName( mod_.GetActuators(), name ); }
+		/// get the index of the dof with a specific name, for use with dof()
+		int find_dof_index( LuaString name ) { return GetLuaIndexByName( mod_.GetDofs(), name ); }
+		/// get the index of the muscle with a specific name, for use with muscle()
+		int find_muscle_index( LuaString name ) { return GetLuaIndexByName( mod_.GetMuscles(), name ); }
+		/// get the index of the body with a specific name, for use with body()
+		int find_body_index( LuaString name ) { return GetLuaIndexByName( mod_.GetBodies(), name ); }
+		/// get the index of the state with a specific name, for use with get_state_values()
+		int find_state_index( LuaString name ) {
+			auto idx = mod_.GetState().GetIndex( name );
+			SCONE_ERROR_IF( idx == NoIndex, "Could not find \"" + string( name ) + "\"" );
+			return static_cast<int>( idx ) + 1;
+		}
+
+		/// get the index of the delayed sensor with a specific name, for use with get_sensor_values()
+		int find_sensor_index( LuaString name ) {
+			auto idx = mod_.GetSensorDelayStorage().GetChannelIndex( name );
+			SCONE_ERROR_IF( idx == NoIndex, "Could not find sensor \"" + string( name ) + "\"" );
+			return static_cast<int>( idx ) + 1;
+		}
+
+		// functions with table arguments are templates, so that this header does not depend on sol;
+		// they are instantiated with the sol table type in register_lua_wrappers()
+
+		/// add values[i] to the input of actuator i, for all values
+		template< typename LuaTable > void add_actuator_inputs( LuaTable values ) {
+			auto& acts = mod_.GetActuators();
+			auto n = std::min( values.size(), acts.size() );
+			for ( index_t i = 0; i < n; ++i )
+				acts[ i ]->AddInput( values.template raw_get<LuaNumber>( i + 1 ) );
+		}
+		/// add values[i] to the input of the actuator with index indices[i], for all indices
+		template< typename LuaTable > void add_actuator_inputs_at( LuaTable indices, LuaTable values ) {
+			auto n = indices.size();
+			for ( index_t i = 1; i <= n; ++i )
+				GetByLuaIndex( mod_.GetActuators(), indices.template raw_get<int>( i ) )->AddInput( values.template raw_get<LuaNumber>( i ) );
+		}
+		/// fill a table with the excitation of each muscle, returns the number of muscles
+		template< typename LuaTable > int get_muscle_excitations( LuaTable t ) {
+			return FillLuaTable( t, mod_.GetMuscles().begin(), mod_.GetMuscles().end(), []( const MuscleUP& m ) { return m->GetExcitation(); } );
+		}
+		/// fill a table with the activation of each muscle, returns the number of muscles
+		template< typename LuaTable > int get_muscle_activations( LuaTable t ) {
+			return FillLuaTable( t, mod_.GetMuscles().begin(), mod_.GetMuscles().end(), []( const MuscleUP& m ) { return m->GetActivation(); } );
+		}
+		/// fill a table with the position of each dof, returns the number of dofs
+		template< typename LuaTable > int get_dof_positions( LuaTable t ) {
+			return FillLuaTable( t, mod_.GetDofs().begin(), mod_.GetDofs().end(), []( const DofUP& d ) { return d->GetPos(); } );
+		}
+		/// fill a table with the velocity of each dof, returns the number of dofs
+		template< typename LuaTable > int get_dof_velocities( LuaTable t ) {
+			return FillLuaTable( t, mod_.GetDofs().begin(), mod_.GetDofs().end(), []( const DofUP& d ) { return d->GetVel(); } );
+		}
+		/// fill a table with all model state values, returns the number of states
+		template< typename LuaTable > int get_state_values( LuaTable t ) {
+			const auto& v = mod_.GetState().GetValues();
+			return FillLuaTable( t, v.begin(), v.end(), []( Real x ) { return x; } );
+		}
+		/// fill a table with the current (not delayed) value of each delayed sensor, sampled at the most recent sensor update;
+		/// use find_sensor_index() to get the index of a sensor; returns the number of sensors
+		template< typename LuaTable > int get_sensor_values( LuaTable t ) {
+			const auto& v = mod_.GetSensorValues();
+			return FillLuaTable( t, v.begin(), v.end(), []( Real x ) { return x; } );
+		}
+
 		Model& mod_;
 	};
 
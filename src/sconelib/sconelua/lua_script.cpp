@@ -5,14 +5,147 @@
 #include "scone/model/Actuator.h"
 #include "lua_api.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <mutex>
+
 namespace scone
 {
-	lua_script::lua_script( const path& script_file, const PropNode& pn, Params& par, Model& model ) :
-		script_file_( script_file )
+	// initial contents of a lua table, which can be restored after a script has changed it
+	struct lua_table_snapshot
+	{
+		lua_table_snapshot( const sol::table& t ) : table( t ) {
+			for ( const auto& kvp : table )
+				entries.emplace_back( kvp.first, kvp.second );
+		}
+
+		// remove all entries and restore the initial ones, without invoking metamethods
+		void restore() {
+			std::vector< sol::object > keys;
+			for ( const auto& kvp : table )
+				keys.push_back( kvp.first );
+			for ( const auto& key : keys )
+				table.raw_set( key, sol::lua_nil );
+			for ( const auto& [key, value] : entries )
+				table.raw_set( key, value );
+		}
+
+		sol::table table;
+		std::vector< std::pair< sol::object, sol::object > > entries;
+	};
+
+	// lua state with registered wrappers, including a snapshot of the initial globals, modules and library tables
+	struct lua_state
 	{
-		lua_.open_libraries( sol::lib::base, sol::lib::math, sol::lib::package, sol::lib::string );
-		register_lua_wrappers( lua_ );
+		lua_state() {
+			lua.open_libraries( sol::lib::base, sol::lib::math, sol::lib::package, sol::lib::string );
+			register_lua_wrappers( lua );
+			sol::table globals = lua[ "_G" ];
+			sol::table loaded = lua[ "package" ][ "loaded" ];
+			snapshots.emplace_back( globals );
+			snapshots.emplace_back( loaded );
+
+			// library tables (math, string, package) can be changed by scripts too; usertypes have a metatable and are skipped
+			for ( const auto& [key, value] : globals ) {
+				if ( value.get_type() == sol::type::table && !( key.is<std::string>() && key.as<std::string>() == "_G" ) ) {
+					auto t = value.as< sol::table >();
+					sol::object mt = t[ sol::metatable_key ];
+					if ( mt.get_type() != sol::type::table )
+						snapshots.emplace_back( t );
+				}
+			}
+		}
+
+		// remove all globals and modules added by a script and restore the initial globals and library tables
+		void reset() {
+			for ( auto& s : snapshots )
+				s.restore();
+
+			// properties are set through the scone usertype, which stores them outside its table
+			for ( const auto& key : scone_props )
+				lua[ "scone" ][ key ] = sol::lua_nil;
+			scone_props.clear();
+
+			lua.collect_garbage();
+		}
+
+		sol::state lua; // must be declared first, so it is destroyed last
+		std::vector< lua_table_snapshot > snapshots;
+		std::vector< std::string > scone_props;
+	};
+
+	namespace
+	{
+		// states are pooled per thread; a state can be used by any thread, but only by one at a time
+		constexpr size_t g_MaxPooledStates = 16;
+		thread_local std::vector< std::unique_ptr< lua_state > > t_StatePool;
+
+		std::unique_ptr< lua_state > acquire_state()
+		{
+			if ( !t_StatePool.empty() )
+			{
+				auto state = std::move( t_StatePool.back() );
+				t_StatePool.pop_back();
+				return state;
+			}
+			else return std::make_unique< lua_state >();
+		}
+
+		// compiled scripts, cached by file and modification time; the least recently used script is evicted when full
+		struct bytecode_entry
+		{
+			std::filesystem::file_time_type modification_time;
+			std::string bytecode;
+			size_t last_use;
+		};
+		constexpr size_t g_MaxCachedScripts = 64;
+		std::mutex g_BytecodeMutex;
+		std::map< std::string, bytecode_entry > g_BytecodeCache;
+		size_t g_BytecodeUseCount = 0;
+
+		std::string get_bytecode( sol::state& lua, const path& script_file )
+		{
+			std::error_code ec;
+			auto mtime = std::filesystem::last_write_time( script_file.str(), ec );
+			SCONE_ERROR_IF( ec, "Could not open " + script_file.str() + ": " + ec.message() );
+			{
+				std::scoped_lock lock( g_BytecodeMutex );
+				auto it = g_BytecodeCache.find( script_file.str() );
+				if ( it != g_BytecodeCache.end() && it->second.modification_time == mtime )
+				{
+					it->second.last_use = ++g_BytecodeUseCount;
+					return it->second.bytecode;
+				}
+			}
 
+			// compile outside the lock, the worst case is a file being compiled twice
+			auto script = lua.load_file( script_file.str() );
+			if ( !script.valid() )
+			{
+				sol::error err = script;
+				SCONE_ERROR( "Error in " + script_file.filename().str() + ": " + err.what() );
+			}
+			sol::protected_function func = script;
+			auto bytecode = std::string( func.dump().as_string_view() );
+
+			std::scoped_lock lock( g_BytecodeMutex );
+			if ( g_BytecodeCache.size() >= g_MaxCachedScripts && g_BytecodeCache.count( script_file.str() ) == 0 )
+			{
+				auto lru = std::min_element( g_BytecodeCache.begin(), g_BytecodeCache.end(),
+					[]( const auto& a, const auto& b ) { return a.second.last_use < b.second.last_use; } );
+				g_BytecodeCache.erase( lru );
+			}
+			g_BytecodeCache[ script_file.str() ] = { mtime, bytecode, ++g_BytecodeUseCount };
+			return bytecode;
+		}
+	}
+
+	lua_script::lua_script( const path& script_file, const PropNode& pn, Params& par, Model& model ) :
+		script_file_( script_file ),
+		state_( acquire_state() ),
+		lua_( state_->lua )
+	{
 		// find script file (folder can be different if playback)
 		auto folder = script_file_.has_parent_path() ? script_file_.parent_path() : path( "." );
 
@@ -22,10 +155,14 @@ namespace scone
 
 		// propagate all properties to scone namespace in lua script
 		for ( auto& prop : pn )
+		{
 			lua_[ "scone" ][ prop.first ] = prop.second.get<string>();
+			state_->scone_props.push_back( prop.first );
+		}
 
-		// load script
-		auto script = lua_.load_file( script_file_.str() );
+		// load precompiled script
+		auto bytecode = get_bytecode( lua_, script_file_ );
+		auto script = lua_.load( bytecode, "@" + script_file_.filename().str(), sol::load_mode::binary );
 		if ( !script.valid() )
 		{
 			sol::error err = script;
@@ -42,7 +179,19 @@ namespace scone
 	}
 
 	lua_script::~lua_script()
-	{}
+	{
+		// reset the state and return it to the pool of the current thread
+		try
+		{
+			state_->reset();
+			if ( t_StatePool.size() < g_MaxPooledStates )
+				t_StatePool.push_back( std::move( state_ ) );
+		}
+		catch ( std::exception& e )
+		{
+			log::warning( "Could not reset lua state: ", e.what() );
+		}
+	}
 
 	sol::function lua_script::find_function( const String& name )
 	{
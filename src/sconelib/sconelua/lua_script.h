@@ -8,6 +8,8 @@
 
 namespace scone
 {
+	struct lua_state;
+
 	class lua_script
 	{
 	public:
@@ -19,6 +21,8 @@ namespace scone
 		xo::path script_file_;
 
 	private:
-		sol::state lua_;
+		// initialized lua state from a per-thread pool, returned to the pool on destruction
+		std::unique_ptr< lua_state > state_;
+		sol::state& lua_;
 	};
 }
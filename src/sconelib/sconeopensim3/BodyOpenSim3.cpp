@@ -88,7 +88,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetOriginPos() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 
 		SimTK::Vec3 zero( 0.0, 0.0, 0.0 );
 		SimTK::Vec3 point;
@@ -100,7 +100,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetComPos() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 
 		// #todo: OSIM: find what is the most efficient (compare to linvel)
 		SimTK::Vec3 com;
@@ -130,7 +130,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetPosOfPointOnBody( Vec3 point ) const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 
 		const SimTK::MobilizedBody& mob = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
 		return from_osim( mob.findStationLocationInGround( m_Model.GetTkState(), SimTK::Vec3( point.x, point.y, point.z ) ) );
@@ -139,7 +139,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetComVel() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		// #todo: OSIM: find what is the most efficient (compare to linvel)
 		SimTK::Vec3 zero( 0.0, 0.0, 0.0 );
@@ -155,7 +155,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetOriginVel() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		// #todo: OSIM: see if we can do this more efficient
 		const SimTK::MobilizedBody& mob = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
@@ -166,7 +166,7 @@ namespace scone
 	{
 
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		// #todo: cache this baby (after profiling), because sensors evaluate it for each channel
 		auto& mb = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
@@ -176,7 +176,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetLinVelOfPointOnBody( Vec3 point ) const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		const SimTK::MobilizedBody& mob = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
 		return from_osim( mob.findStationVelocityInGround( m_Model.GetTkState(), SimTK::Vec3( point.x, point.y, point.z ) ) );
@@ -186,7 +186,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetComAcc() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		// #todo: OSIM: find what is the most efficient (compare to linvel)
 		SimTK::Vec3 zero( 0.0, 0.0, 0.0 );
@@ -202,7 +202,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetOriginAcc() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		// #todo: OSIM: see if we can do this more efficient
 		const SimTK::MobilizedBody& mob = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
@@ -212,7 +212,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetAngAcc() const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		// #todo: cache this baby (after profiling), because sensors evaluate it for each channel
 		auto& mb = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
@@ -222,7 +222,7 @@ namespace scone
 	Vec3 BodyOpenSim3::GetLinAccOfPointOnBody( Vec3 point ) const
 	{
 		// #todo: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		const SimTK::MobilizedBody& mob = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getIndex() );
 		return from_osim( mob.findStationAccelerationInGround( m_Model.GetTkState(), SimTK::Vec3( point.x, point.y, point.z ) ) );
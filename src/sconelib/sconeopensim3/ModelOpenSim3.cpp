@@ -38,13 +38,17 @@
 #include "spot/par_tools.h"
 
 #include <mutex>
+#include <set>
 
 using std::cout;
 using std::endl;
 
 namespace scone
 {
+	// initSystem() is not thread-safe in case an exception is thrown, which may happen for new model configurations
+	// configurations that have been initialized successfully before are initialized concurrently
 	std::mutex g_SimBodyMutex;
+	std::set< string > g_InitializedSystems;
 
 	xo::file_resource_cache< OpenSim::Model, std::string > g_ModelCache;
 	xo::file_resource_cache< OpenSim::Storage, std::string > g_StorageCache;
@@ -69,6 +73,7 @@ namespace scone
 		m_pTkState( nullptr ),
 		m_pProbe( 0 ),
 		m_pControllerDispatcher( nullptr ),
+		m_CanReset( true ),
 		m_PrevIntStep( -1 ),
 		m_PrevTime( 0.0 ),
 		m_Mass( 0.0 ),
@@ -77,6 +82,7 @@ namespace scone
 		SCONE_PROFILE_FUNCTION( GetProfiler() );
 
 		String probe_class;
+		bool fixed_configuration = true; // false if the OpenSim system may differ between models with the same file
 
 		INIT_PROP( props, integration_accuracy, 0.001 );
 		INIT_PROP( props, integration_method, String( "SemiExplicitEuler2" ) );
@@ -129,8 +135,14 @@ namespace scone
 			//SCONE_PROFILE_SCOPE( GetProfiler(), "SetupOpenSimParameters" );
 
 			// change model properties
+			// models with optimized properties cannot be reset, because this requires a call to initSystem()
 			if ( auto* model_pars = props.try_get_child( "Properties" ) )
+			{
+				auto par_count = par.dim();
 				SetProperties( *model_pars, par );
+				fixed_configuration = false; // properties may differ between scenarios
+				m_CanReset &= par.dim() == par_count;
+			}
 
 			// create controller dispatcher (ownership is automatically passed to OpenSim::Model)
 			m_pControllerDispatcher = new ControllerDispatcher( *this );
@@ -163,16 +175,23 @@ namespace scone
 					// modelComponent takes ownership of the stateComponent
 					auto modelComponent = new OpenSim::StateComponentOpenSim3(stateComponent.release());
 					m_pOsimModel->addComponent(modelComponent);
+					fixed_configuration = false;
+					m_CanReset = false;
 				}
 			}
 		}
 
 		// Initialize the system
-		// This is not thread-safe in case an exception is thrown, so we add a mutex guard
+		// This is not thread-safe in case an exception is thrown, so we add a mutex guard for new configurations
 		{
 			SCONE_PROFILE_SCOPE( GetProfiler(), "InitSystem" );
-			std::scoped_lock lock( g_SimBodyMutex );
+			auto system_key = model_file.str() + ( enable_external_forces ? ";external_forces;" : ";" ) + probe_class;
+			std::unique_lock lock( g_SimBodyMutex );
+			if ( fixed_configuration && g_InitializedSystems.count( system_key ) )
+				lock.unlock();
 			m_pTkState = &m_pOsimModel->initSystem();
+			if ( fixed_configuration && lock.owns_lock() )
+				g_InitializedSystems.insert( system_key );
 		}
 
 		// create model component wrappers and sensors
@@ -221,41 +240,17 @@ namespace scone
 				AddExternalResource( state_init_file );
 			}
 
-			// update state variables if they are being optimized
-			if ( initial_state_offset )
-			{
-				auto inc_pat = xo::pattern_matcher( initial_state_offset_include, ";" );
-				auto ex_pat = xo::pattern_matcher( initial_state_offset_exclude + ";*.activation;*.fiber_length", ";" );
-				for ( index_t i = 0; i < m_State.GetSize(); ++i )
-				{
-					const String& state_name = m_State.GetName( i );
-					if ( inc_pat( state_name ) && !ex_pat( state_name ) )
-					{
-						auto par_name = initial_state_offset_symmetric ? GetNameNoSide( state_name ) : state_name;
-						m_State[ i ] += par.get( par_name + ".offset", *initial_state_offset );
-					}
-				}
-			}
+			// keep initial state for Reset()
+			m_pInitialTkState = std::make_unique<SimTK::State>( GetTkState() );
+			m_InitialStateValues = m_State.GetValues();
 
-			// apply and fix state
-			if ( !initial_load_dof.empty() && initial_load > 0 && !GetContactGeometries().empty() )
-			{
-				CopyStateToTk();
-				FixTkState( initial_load * GetBW() );
-				CopyStateFromTk();
-			}
+			InitState( par );
 		}
 
 		// Realize acceleration because controllers may need it and in this way the results are consistent
 		{
 			SCONE_PROFILE_SCOPE( GetProfiler(), "RealizeSystem" );
-			// Create a manager to run the simulation. Can change manager options to save run time and memory or print more information
-			m_pOsimManager = std::make_unique<OpenSim::Manager>( *m_pOsimModel, *m_pTkIntegrator );
-			m_pOsimManager->setWriteToStorage( false );
-			m_pOsimManager->setPerformAnalyses( false );
-			m_pOsimManager->setInitialTime( 0.0 );
-			m_pOsimManager->setFinalTime( 0.0 );
-
+			CreateManager();
 			m_pOsimModel->getMultibodySystem().realize( GetTkState(), SimTK::Stage::Acceleration );
 		}
 
@@ -266,6 +261,100 @@ namespace scone
 
 	ModelOpenSim3::~ModelOpenSim3() {}
 
+	void ModelOpenSim3::InitState( Params& par )
+	{
+		// update state variables if they are being optimized
+		if ( initial_state_offset )
+		{
+			auto inc_pat = xo::pattern_matcher( initial_state_offset_include, ";" );
+			auto ex_pat = xo::pattern_matcher( initial_state_offset_exclude + ";*.activation;*.fiber_length", ";" );
+			for ( index_t i = 0; i < m_State.GetSize(); ++i )
+			{
+				const String& state_name = m_State.GetName( i );
+				if ( inc_pat( state_name ) && !ex_pat( state_name ) )
+				{
+					auto par_name = initial_state_offset_symmetric ? GetNameNoSide( state_name ) : state_name;
+					m_State[ i ] += par.get( par_name + ".offset", *initial_state_offset );
+				}
+			}
+		}
+
+		// apply and fix state
+		if ( !initial_load_dof.empty() && initial_load > 0 && !GetContactGeometries().empty() )
+		{
+			CopyStateToTk();
+			FixTkState( initial_load * GetBW() );
+			CopyStateFromTk();
+		}
+	}
+
+	void ModelOpenSim3::CreateManager()
+	{
+		// Create a manager to run the simulation. Can change manager options to save run time and memory or print more information
+		m_pOsimManager = std::make_unique<OpenSim::Manager>( *m_pOsimModel, *m_pTkIntegrator );
+		m_pOsimManager->setWriteToStorage( false );
+		m_pOsimManager->setPerformAnalyses( false );
+		m_pOsimManager->setInitialTime( 0.0 );
+		m_pOsimManager->setFinalTime( 0.0 );
+	}
+
+	void ModelOpenSim3::Reset( const PropNode& props, Params& par )
+	{
+		SCONE_PROFILE_FUNCTION( GetProfiler() );
+
+		Model::Reset( props, par );
+
+		// restore the initial SimTK state, this way we don't need to call initSystem()
+		m_pTkTimeStepper.reset();
+		m_pTkIntegrator->resetAllStatistics();
+		m_PrevIntStep = -1;
+		m_PrevTime = 0.0;
+		m_pOsimModel->updWorkingState() = *m_pInitialTkState;
+		SetTkState( m_pOsimModel->updWorkingState() );
+		m_State.SetValues( m_InitialStateValues );
+		InitState( par );
+
+		CreateManager();
+		m_pOsimModel->getMultibodySystem().realize( GetTkState(), SimTK::Stage::Acceleration );
+
+		// recreate controllers defined inside the model
+		CreateControllers( props, par );
+	}
+
+	ModelCheckpoint ModelOpenSim3::CreateCheckpoint() const
+	{
+		auto cp = Model::CreateCheckpoint();
+		cp.simulator_state = std::make_shared< const SimTK::State >( GetTkState() );
+		return cp;
+	}
+
+	void ModelOpenSim3::RestoreCheckpoint( const ModelCheckpoint& cp )
+	{
+		SCONE_PROFILE_FUNCTION( GetProfiler() );
+
+		Model::RestoreCheckpoint( cp );
+
+		// restore the SimTK state and restart integration from there, similar to Reset()
+		m_pTkTimeStepper.reset();
+		m_pTkIntegrator->resetAllStatistics();
+		m_PrevIntStep = -1;
+		m_PrevTime = cp.time;
+		m_pOsimModel->updWorkingState() = *std::any_cast< const std::shared_ptr< const SimTK::State >& >( cp.simulator_state );
+		SetTkState( m_pOsimModel->updWorkingState() );
+		m_State.SetValues( cp.state_values );
+
+		CreateManager();
+		m_pOsimManager->setInitialTime( cp.time );
+		m_pOsimModel->getMultibodySystem().realize( GetTkState(), SimTK::Stage::Acceleration );
+
+		// initialize the time-stepper here, so that AdvanceSimulationTo() does not store the restored frame again
+		if ( use_fixed_control_step_size )
+		{
+			m_pTkTimeStepper = std::make_unique< SimTK::TimeStepper >( m_pOsimModel->getMultibodySystem(), *m_pTkIntegrator );
+			m_pTkTimeStepper->initialize( GetTkState() );
+		}
+	}
+
 	void ModelOpenSim3::CreateModelWrappers( const PropNode& pn, Params& par )
 	{
 		SCONE_ASSERT( m_pOsimModel && m_Bodies.empty() && m_Joints.empty() && m_Dofs.empty() && m_Actuators.empty() && m_Muscles.empty() );
@@ -493,6 +582,20 @@ namespace scone
 		return from_osim( m_pOsimModel->getGravity() );
 	}
 
+	void ModelOpenSim3::RealizeSensorStage( SensorStage stage )
+	{
+		// the state is usually already realized (e.g. after AdvanceSimulationTo), in which case nothing needs to be done
+		static const SimTK::Stage tk_stages[] = { SimTK::Stage::Time, SimTK::Stage::Position, SimTK::Stage::Velocity, SimTK::Stage::Dynamics, SimTK::Stage::Acceleration };
+		RealizeTkState( tk_stages[ static_cast< int >( stage ) ] );
+	}
+
+	void ModelOpenSim3::RealizeTkState( SimTK::Stage stage ) const
+	{
+		// SimTK invalidates the realized stages when the state changes, so this check is always safe
+		if ( m_pTkState->getSystemStage() < stage )
+			m_pOsimModel->getMultibodySystem().realize( *m_pTkState, stage );
+	}
+
 	void ControllerDispatcher::computeControls( const SimTK::State& s, SimTK::Vector &controls ) const
 	{
 		// see 'catch' statement below for explanation try {} catch {} is needed
@@ -96,6 +96,12 @@ namespace scone
 
 		virtual void RequestTermination() override;
 
+		virtual bool CanReset() const override { return m_CanReset; }
+		virtual void Reset( const PropNode& props, Params& par ) override;
+		virtual bool CanCheckpoint() const override { return true; }
+		virtual ModelCheckpoint CreateCheckpoint() const override;
+		virtual void RestoreCheckpoint( const ModelCheckpoint& cp ) override;
+
 		virtual double GetTime() const override;
 		virtual double GetPreviousTime() const override;
 		virtual int GetIntegrationStep() const override;
@@ -110,6 +116,8 @@ namespace scone
 		SimTK::State& GetTkState() { return *m_pTkState; }
 		const SimTK::State& GetTkState() const { return *m_pTkState; }
 		void SetTkState( SimTK::State& s ) { m_pTkState = &s; }
+		/// Realize the state up to stage, unless it is already realized (e.g. by SampleSensors)
+		void RealizeTkState( SimTK::Stage stage ) const;
 
 		virtual const String& GetName() const override;
 
@@ -126,11 +134,16 @@ namespace scone
 		virtual void SetController( ControllerUP c ) override;
 		void InitializeOpenSimMuscleActivations( double override_activation = 0.0 );
 
+	protected:
+		virtual void RealizeSensorStage( SensorStage stage ) override;
+
 	private:
 		void InitStateFromTk();
 		void CopyStateFromTk();
 		void CopyStateToTk();
 		void ReadState( const path& file );
+		void InitState( Params& par );
+		void CreateManager();
 		void FixTkState( double force_threshold = 0.1, double fix_accuracy = 0.1 );
 
 		void CreateModelWrappers( const PropNode& pn, Params& par );
@@ -152,6 +165,9 @@ namespace scone
 		ControllerDispatcher* m_pControllerDispatcher; // owned by OpenSim::Model
 
 		State m_State; // model state
+		std::unique_ptr< SimTK::State > m_pInitialTkState; // used for Reset()
+		std::vector< Real > m_InitialStateValues; // used for Reset()
+		bool m_CanReset;
 		int m_PrevIntStep;
 		double m_PrevTime;
 
@@ -51,7 +51,7 @@ namespace scone
 	{
 		// OpenSim: why can't I just use getWorkingState()?
 		// OpenSim: why must I update to Dynamics for getForce()?
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Dynamics );
+		m_Model.RealizeTkState( SimTK::Stage::Dynamics );
 		return m_osMus.getForce( m_Model.GetTkState() );
 	}
 
@@ -62,13 +62,13 @@ namespace scone
 
 	Real MuscleOpenSim3::GetLength() const
 	{
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 		return m_osMus.getLength( m_Model.GetTkState() );
 	}
 
 	Real MuscleOpenSim3::GetVelocity() const
 	{
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 		return m_osMus.getLengtheningSpeed( m_Model.GetTkState() );
 	}
 
@@ -94,7 +94,7 @@ namespace scone
 
 	Real MuscleOpenSim3::GetNormalizedFiberLength() const
 	{
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 		return m_osMus.getNormalizedFiberLength( m_Model.GetTkState() );
 	}
 
@@ -189,7 +189,7 @@ namespace scone
 
 	std::vector< Vec3 > MuscleOpenSim3::GetMusclePath() const
 	{
-		//m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		//m_Model.RealizeTkState( SimTK::Stage::Velocity );
 		//m_osMus.getGeometryPath().updateGeometry( m_Model.GetTkState() );
 		auto& pps = m_osMus.getGeometryPath().getCurrentPath( m_Model.GetTkState() );
 		std::vector< Vec3 > points( pps.getSize() );
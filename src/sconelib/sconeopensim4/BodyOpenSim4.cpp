@@ -44,7 +44,7 @@ namespace scone
 	{
 		SCONE_PROFILE_FUNCTION;
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 
 		SimTK::Vec3 zero( 0.0, 0.0, 0.0 );
 		SimTK::Vec3 point;
@@ -57,7 +57,7 @@ namespace scone
 	{
 		SCONE_PROFILE_FUNCTION;
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 
 		// TODO: OSIM: find what is the most efficient (compare to linvel)
 		// TODO: validate this!
@@ -85,7 +85,7 @@ namespace scone
 	scone::Vec3 scone::BodyOpenSim4::GetPosOfPointOnBody( Vec3 point ) const
 	{
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 
 		const SimTK::MobilizedBody& mob = m_osBody.getModel().getMultibodySystem().getMatterSubsystem().getMobilizedBody( m_osBody.getMobilizedBodyIndex() );
 		return from_osim( mob.findStationLocationInGround( m_Model.GetTkState(), SimTK::Vec3( point.x, point.y, point.z ) ) );
@@ -96,7 +96,7 @@ namespace scone
 	{
 		SCONE_PROFILE_FUNCTION;
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		// TODO: OSIM: find what is the most efficient (compare to linvel)
 		SimTK::Vec3 zero( 0.0, 0.0, 0.0 );
@@ -113,7 +113,7 @@ namespace scone
 		SCONE_PROFILE_FUNCTION;
 
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		// TODO: OSIM: see if we can do this more efficient
 		const SimTK::MobilizedBody& mob = m_osBody.getMobilizedBody();
@@ -125,7 +125,7 @@ namespace scone
 		SCONE_PROFILE_FUNCTION;
 
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		// TODO: cache this baby (after profiling), because sensors evaluate it for each channel
 		const auto& mb = m_osBody.getMobilizedBody();
@@ -135,7 +135,7 @@ namespace scone
 	scone::Vec3 scone::BodyOpenSim4::GetLinVelOfPointOnBody( Vec3 point ) const
 	{
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 
 		const SimTK::MobilizedBody& mob = m_osBody.getMobilizedBody();
 		return from_osim( mob.findStationVelocityInGround( m_Model.GetTkState(), SimTK::Vec3( point.x, point.y, point.z ) ) );
@@ -146,7 +146,7 @@ namespace scone
 	{
 		SCONE_PROFILE_FUNCTION;
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		// TODO: OSIM: find what is the most efficient (compare to linvel)
 		SimTK::Vec3 zero( 0.0, 0.0, 0.0 );
@@ -163,7 +163,7 @@ namespace scone
 		SCONE_PROFILE_FUNCTION;
 
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		// TODO: OSIM: see if we can do this more efficient
 		const SimTK::MobilizedBody& mob = m_osBody.getMobilizedBody();
@@ -175,7 +175,7 @@ namespace scone
 		SCONE_PROFILE_FUNCTION;
 
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		// TODO: cache this baby (after profiling), because sensors evaluate it for each channel
 		const SimTK::MobilizedBody& mb = m_osBody.getMobilizedBody();
@@ -185,7 +185,7 @@ namespace scone
 	scone::Vec3 scone::BodyOpenSim4::GetLinAccOfPointOnBody( Vec3 point ) const
 	{
 		// TODO: see if we need to do this call to realize every time (maybe do it once before controls are updated)
-		m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Acceleration );
+		m_Model.RealizeTkState( SimTK::Stage::Acceleration );
 
 		const SimTK::MobilizedBody& mob = m_osBody.getMobilizedBody();
 		return from_osim( mob.findStationAccelerationInGround( m_Model.GetTkState(), SimTK::Vec3( point.x, point.y, point.z ) ) );
@@ -264,13 +264,13 @@ namespace scone
 	{
 		if ( m_ForceIndex != -1 )
 		{
-			m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Dynamics );
+			m_Model.RealizeTkState( SimTK::Stage::Dynamics );
 			int num_dyn = m_osBody.getModel().getMultibodySystem().getNumRealizationsOfThisStage( SimTK::Stage::Dynamics );
 
 			if ( m_LastNumDynamicsRealizations != num_dyn )
 			{
 				// TODO: find out if this can be done less clumsy in OpenSim
-				m_osBody.getModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Dynamics );
+				m_Model.RealizeTkState( SimTK::Stage::Dynamics );
 				OpenSim::Array<double> forces = m_osBody.getModel().getForceSet().get( m_ForceIndex ).getRecordValues( m_Model.GetTkState() );
 				for ( int i = 0; i < forces.size(); ++i )
 					m_ContactForceValues[ i ] = forces[ i ];
@@ -33,13 +33,17 @@
 
 #include <thread>
 #include <mutex>
+#include <set>
 
 using std::cout;
 using std::endl;
 
 namespace scone
 {
+	// initSystem() is not thread-safe in case an exception is thrown, which may happen for new model configurations
+	// configurations that have been initialized successfully before are initialized concurrently
 	std::mutex g_SimBodyMutex;
+	std::set< string > g_InitializedSystems;
 
 	xo::file_resource_cache< OpenSim::Model > g_ModelCache( []( const path& p ) { return new OpenSim::Model( p.string() ); } );
 	xo::file_resource_cache< OpenSim::Storage > g_StorageCache( []( const path& p ) { return new OpenSim::Storage( p.string() ); } );
@@ -64,6 +68,7 @@ namespace scone
 		m_pOsimModel( nullptr ),
 		m_pTkState( nullptr ),
 		m_pControllerDispatcher( nullptr ),
+		m_CanReset( true ),
 		m_PrevIntStep( -1 ),
 		m_PrevTime( 0.0 ),
 		m_pProbe( 0 ),
@@ -75,6 +80,7 @@ namespace scone
 		path model_file;
 		path state_init_file;
 		String probe_class;
+		bool fixed_configuration = true; // false if the OpenSim system may differ between models with the same file
 
 		INIT_PROP( props, integration_accuracy, 0.001 );
 		INIT_PROP( props, integration_method, String( "SemiExplicitEuler2" ) );
@@ -122,8 +128,14 @@ namespace scone
 			SCONE_PROFILE_SCOPE( "SetupOpenSimParameters" );
 
 			// change model properties
+			// models with optimized properties cannot be reset, because this requires a call to initSystem()
 			if ( auto* model_pars = props.try_get_child( "OpenSimProperties" ) )
+			{
+				auto par_count = par.dim();
 				SetOpenSimProperties( *model_pars, par );
+				fixed_configuration = false; // properties may differ between scenarios
+				m_CanReset &= par.dim() == par_count;
+			}
 
 			// create controller dispatcher (ownership is automatically passed to OpenSim::Model)
 			m_pControllerDispatcher = new ControllerDispatcher( *this );
@@ -148,19 +160,25 @@ namespace scone
 		}
 
 		// Initialize the system
-		// This is not thread-safe in case an exception is thrown, so we add a mutex guard
+		// This is not thread-safe in case an exception is thrown, so we add a mutex guard for new configurations
 		{
 			SCONE_PROFILE_SCOPE( "InitSystem" );
-			g_SimBodyMutex.lock();
+			auto system_key = model_file.str() + ( create_body_forces ? ";body_forces;" : ";" ) + probe_class;
+			std::unique_lock lock( g_SimBodyMutex );
+			if ( fixed_configuration && g_InitializedSystems.count( system_key ) )
+				lock.unlock();
 			m_pTkState = &m_pOsimModel->initSystem();
-			g_SimBodyMutex.unlock();
+			if ( fixed_configuration && lock.owns_lock() )
+				g_InitializedSystems.insert( system_key );
 		}
 
 		// create model component wrappers and sensors
 		{
 			SCONE_PROFILE_SCOPE( "CreateWrappers" );
 			CreateModelWrappers( props, par );
+			auto par_count = par.dim();
 			SetModelProperties( props, par );
+			m_CanReset &= par.dim() == par_count;
 		}
 
 		{
@@ -208,49 +226,17 @@ namespace scone
 				AddExternalResource( state_init_file );
 			}
 
-			// update state variables if they are being optimized
-			auto sio = props.try_get_child( "state_init_optimization" );
-			auto offset = sio ? sio->try_get_child( "offset" ) : props.try_get_child( "initial_state_offset" );
-			if ( offset )
-			{
-				bool symmetric = sio ? sio->get( "symmetric", false ) : props.get( "initial_state_offset_symmetric", false );
-				auto inc_pat = xo::pattern_matcher( sio ? sio->get< String >( "include_states", "*" ) : props.get< String >( "initial_state_offset_include", "*" ), ";" );
-				auto ex_pat = xo::pattern_matcher(
-					( sio ? sio->get< String >( "exclude_states", "" ) : props.get< String >( "initial_state_offset_exclude", "" ) ) + ";*.activation;*.fiber_length", ";" );
-				for ( index_t i = 0; i < m_State.GetSize(); ++i )
-				{
-					const String& state_name = m_State.GetName( i );
-					if ( inc_pat( state_name ) && !ex_pat( state_name ) )
-					{
-						auto par_name = symmetric ? GetNameNoSide( state_name ) : state_name;
-						m_State[ i ] += par.get( par_name + ".offset", *offset );
-					}
-				}
-			}
+			// keep initial state for Reset()
+			m_pInitialTkState = std::unique_ptr< SimTK::State >( new SimTK::State( GetTkState() ) );
+			m_InitialStateValues = m_State.GetValues();
 
-			// apply and fix state
-			if ( !initial_load_dof.empty() && initial_load > 0 && !GetContactGeometries().empty() )
-			{
-				CopyStateToTk();
-				FixTkState( initial_load * GetBW() );
-				CopyStateFromTk();
-			}
+			InitState( props, par );
 		}
 
 		// Realize acceleration because controllers may need it and in this way the results are consistent
 		{
 			SCONE_PROFILE_SCOPE( "RealizeSystem" );
-			// Create a manager to run the simulation. Can change manager options to save run time and memory or print more information
-			m_pOsimManager = std::unique_ptr< OpenSim::Manager >( new OpenSim::Manager( *m_pOsimModel ) );
-			m_pOsimManager->setWriteToStorage( false );
-			m_pOsimManager->setPerformAnalyses( false );
-			// m_pOsimManager->setInitialTime( 0.0 );
-			// m_pOsimManager->setFinalTime( 0.0 );
-
-			m_pOsimManager->setIntegratorMethod(OpenSim::Manager::IntegratorMethod(m_integratorMethod));
-			m_pOsimManager->setIntegratorAccuracy( integration_accuracy );
-			m_pOsimManager->setIntegratorMaximumStepSize( max_step_size );
-
+			CreateManager();
 			m_pOsimModel->getMultibodySystem().realize( GetTkState(), SimTK::Stage::Acceleration );
 		}
 
@@ -262,6 +248,104 @@ namespace scone
 
 	ModelOpenSim4::~ModelOpenSim4() {}
 
+	void ModelOpenSim4::InitState( const PropNode& props, Params& par )
+	{
+		// update state variables if they are being optimized
+		auto sio = props.try_get_child( "state_init_optimization" );
+		auto offset = sio ? sio->try_get_child( "offset" ) : props.try_get_child( "initial_state_offset" );
+		if ( offset )
+		{
+			bool symmetric = sio ? sio->get( "symmetric", false ) : props.get( "initial_state_offset_symmetric", false );
+			auto inc_pat = xo::pattern_matcher( sio ? sio->get< String >( "include_states", "*" ) : props.get< String >( "initial_state_offset_include", "*" ), ";" );
+			auto ex_pat = xo::pattern_matcher(
+				( sio ? sio->get< String >( "exclude_states", "" ) : props.get< String >( "initial_state_offset_exclude", "" ) ) + ";*.activation;*.fiber_length", ";" );
+			for ( index_t i = 0; i < m_State.GetSize(); ++i )
+			{
+				const String& state_name = m_State.GetName( i );
+				if ( inc_pat( state_name ) && !ex_pat( state_name ) )
+				{
+					auto par_name = symmetric ? GetNameNoSide( state_name ) : state_name;
+					m_State[ i ] += par.get( par_name + ".offset", *offset );
+				}
+			}
+		}
+
+		// apply and fix state
+		if ( !initial_load_dof.empty() && initial_load > 0 && !GetContactGeometries().empty() )
+		{
+			CopyStateToTk();
+			FixTkState( initial_load * GetBW() );
+			CopyStateFromTk();
+		}
+	}
+
+	void ModelOpenSim4::CreateManager()
+	{
+		// Create a manager to run the simulation. Can change manager options to save run time and memory or print more information
+		m_pOsimManager = std::unique_ptr< OpenSim::Manager >( new OpenSim::Manager( *m_pOsimModel ) );
+		m_pOsimManager->setWriteToStorage( false );
+		m_pOsimManager->setPerformAnalyses( false );
+		m_pOsimManager->setIntegratorMethod( OpenSim::Manager::IntegratorMethod( m_integratorMethod ) );
+		m_pOsimManager->setIntegratorAccuracy( integration_accuracy );
+		m_pOsimManager->setIntegratorMaximumStepSize( max_step_size );
+	}
+
+	void ModelOpenSim4::Reset( const PropNode& props, Params& par )
+	{
+		SCONE_PROFILE_FUNCTION;
+
+		Model::Reset( props, par );
+
+		// restore the initial SimTK state, this way we don't need to call initSystem()
+		m_pTkTimeStepper.reset();
+		m_pTkIntegrator->resetAllStatistics();
+		m_PrevIntStep = -1;
+		m_PrevTime = 0.0;
+		m_pOsimModel->updWorkingState() = *m_pInitialTkState;
+		SetTkState( m_pOsimModel->updWorkingState() );
+		m_State.SetValues( m_InitialStateValues );
+		InitState( props, par );
+
+		CreateManager();
+		m_pOsimModel->getMultibodySystem().realize( GetTkState(), SimTK::Stage::Acceleration );
+
+		// recreate controllers defined inside the model
+		CreateControllers( props, par );
+	}
+
+	ModelCheckpoint ModelOpenSim4::CreateCheckpoint() const
+	{
+		auto cp = Model::CreateCheckpoint();
+		cp.simulator_state = std::make_shared< const SimTK::State >( GetTkState() );
+		return cp;
+	}
+
+	void ModelOpenSim4::RestoreCheckpoint( const ModelCheckpoint& cp )
+	{
+		SCONE_PROFILE_FUNCTION;
+
+		Model::RestoreCheckpoint( cp );
+
+		// restore the SimTK state and restart integration from there, similar to Reset()
+		m_pTkTimeStepper.reset();
+		m_pTkIntegrator->resetAllStatistics();
+		m_PrevIntStep = -1;
+		m_PrevTime = cp.time;
+		m_pOsimModel->updWorkingState() = *std::any_cast< const std::shared_ptr< const SimTK::State >& >( cp.simulator_state );
+		SetTkState( m_pOsimModel->updWorkingState() );
+		m_State.SetValues( cp.state_values );
+
+		CreateManager();
+		m_pOsimModel->getMultibodySystem().realize( GetTkState(), SimTK::Stage::Acceleration );
+
+		// initialize the time-stepper here, so that AdvanceSimulationTo() does not store the restored frame again
+		if ( use_fixed_control_step_size )
+		{
+			m_pTkTimeStepper = std::unique_ptr< SimTK::TimeStepper >( new SimTK::TimeStepper( m_pOsimModel->getMultibodySystem(), *m_pTkIntegrator ) );
+			m_pTkTimeStepper->initialize( GetTkState() );
+		}
+	}
+
 	void ModelOpenSim4::CreateModelWrappers( const PropNode& pn, Params& par )
 	{
 		SCONE_ASSERT( m_pOsimModel && m_Bodies.empty() && m_Joints.empty() && m_Dofs.empty() && m_Actuators.empty() && m_Muscles.empty() );
@@ -429,6 +513,20 @@ namespace scone
 		return from_osim( m_pOsimModel->getGravity() );
 	}
 
+	void ModelOpenSim4::RealizeSensorStage( SensorStage stage )
+	{
+		// the state is usually already realized (e.g. after AdvanceSimulationTo), in which case nothing needs to be done
+		static const SimTK::Stage tk_stages[] = { SimTK::Stage::Time, SimTK::Stage::Position, SimTK::Stage::Velocity, SimTK::Stage::Dynamics, SimTK::Stage::Acceleration };
+		RealizeTkState( tk_stages[ static_cast< int >( stage ) ] );
+	}
+
+	void ModelOpenSim4::RealizeTkState( SimTK::Stage stage ) const
+	{
+		// SimTK invalidates the realized stages when the state changes, so this check is always safe
+		if ( m_pTkState->getSystemStage() < stage )
+			m_pOsimModel->getMultibodySystem().realize( *m_pTkState, stage );
+	}
+
 	bool is_body_equal( BodyUP& body, OpenSim::Body& osBody )
 	{
 		return dynamic_cast<BodyOpenSim4&>( *body ).m_osBody == osBody;
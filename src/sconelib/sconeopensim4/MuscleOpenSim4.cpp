@@ -53,7 +53,7 @@ namespace scone
 		SCONE_PROFILE_FUNCTION;
 		// OpenSim: why can't I just use getWorkingState()?
 		// OpenSim: why must I update to Dynamics for getForce()?
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Dynamics );
+		m_Model.RealizeTkState( SimTK::Stage::Dynamics );
 		// TODO is this correct?
 		return m_osMus.getActuation( m_Model.GetTkState() );
 
@@ -68,14 +68,14 @@ namespace scone
 	scone::Real scone::MuscleOpenSim4::GetLength() const
 	{
 		SCONE_PROFILE_FUNCTION;
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 		return m_osMus.getLength( m_Model.GetTkState() );
 	}
 
 	scone::Real MuscleOpenSim4::GetVelocity() const
 	{
 		SCONE_PROFILE_FUNCTION;
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		m_Model.RealizeTkState( SimTK::Stage::Velocity );
 		return m_osMus.getLengtheningSpeed( m_Model.GetTkState() );
 	}
 
@@ -106,7 +106,7 @@ namespace scone
 	scone::Real MuscleOpenSim4::GetNormalizedFiberLength() const
 	{
 		SCONE_PROFILE_FUNCTION;
-		m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Position );
+		m_Model.RealizeTkState( SimTK::Stage::Position );
 		return m_osMus.getNormalizedFiberLength( m_Model.GetTkState() );
 	}
 
@@ -182,7 +182,7 @@ namespace scone
 	std::vector< Vec3 > scone::MuscleOpenSim4::GetMusclePath() const
 	{
 		SCONE_PROFILE_FUNCTION;
-		//m_Model.GetOsimModel().getMultibodySystem().realize( m_Model.GetTkState(), SimTK::Stage::Velocity );
+		//m_Model.RealizeTkState( SimTK::Stage::Velocity );
 		//m_osMus.getGeometryPath().updateGeometry( m_Model.GetTkState() );
 		auto& pps = m_osMus.getGeometryPath().getCurrentPath( m_Model.GetTkState() );
 		std::vector< Vec3 > points( pps.getSize() );
@@ -9,6 +9,9 @@
 #include "xo/serialization/prop_node_serializer_zml.h"
 #include "xo/string/string_tools.h"
 
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
 #include <sstream>
 
 namespace scone
@@ -18,9 +21,12 @@ namespace scone
 		process_( nullptr ),
 		send_process_closed_mesage_( false )
 	{
+		static int task_count = 0;
+		status_file_ = path_from_qt( QDir::temp().filePath( QString( "scone_status_%1_%2.bin" ).arg( QCoreApplication::applicationPid() ).arg( ++task_count ) ) );
+
 		QString program = to_qt( xo::get_application_dir() / SCONE_SCONECMD_EXECUTABLE );
 		QStringList args;
-		args << "-o" << scenario_file_ << "-s" << "-q" << "-l" << "7" << options_;
+		args << "-o" << scenario_file_ << "-s" << "-q" << "-l" << "7" << "--status_file" << to_qt( status_file_ ) << options_;
 
 		process_ = new QProcess();
 		process_->setReadChannel( QProcess::StandardOutput );
@@ -30,7 +36,7 @@ namespace scone
 
 		scone::log::info( "Optimizing scenario ", scenario_file_.toStdString() );
 
-		while ( !process_->waitForReadyRead( 1000 ) )
+		while ( !process_->waitForReadyRead( 1000 ) && !xo::file_exists( status_file_ ) )
 			scone::log::debug( "Waiting for process to start" );
 	}
 
@@ -45,6 +51,9 @@ namespace scone
 			}
 			delete process_;
 		}
+
+		status_channel_.reset();
+		QFile::remove( to_qt( status_file_ ) );
 	}
 
 	bool OptimizerTaskExternal::interrupt()
@@ -67,16 +76,29 @@ namespace scone
 	std::deque<PropNode> OptimizerTaskExternal::getMessages()
 	{
 		std::deque<PropNode> messages;
+
+		// binary status records, which don't need parsing
+		if ( !status_channel_ && xo::file_exists( status_file_ ) )
+		{
+			try { status_channel_ = std::make_unique<StatusChannel>( status_file_, StatusChannel::ReadMode ); }
+			catch ( const std::exception& e ) { log::trace( "Status file not ready: ", e.what() ); } // try again next time
+		}
+		if ( status_channel_ )
+		{
+			for ( const auto& r : status_channel_->Read() )
+				messages.push_back( r.ToPropNode() );
+		}
+
+		// text messages (prefixed with '*'), used for messages that don't have a binary record
 		while ( process_->canReadLine() )
 		{
 			xo::error_code ec;
 			char buf[ 4096 ];
-			string msg;
-			while ( msg.empty() || !xo::str_begins_with( msg, '*' ) )
-			{
-				process_->readLine( buf, sizeof( buf ) - 1 );
-				msg = buf;
-			}
+			if ( process_->readLine( buf, sizeof( buf ) - 1 ) <= 0 )
+				break;
+			string msg = buf;
+			if ( !xo::str_begins_with( msg, '*' ) )
+				continue;
 			std::stringstream str( msg.substr( 1 ) );
 			xo::prop_node pn;
 			xo::prop_node_serializer_zml zml( pn, &ec );
@@ -4,6 +4,7 @@
 #include "OptimizerTask.h"
 #include "xo/filesystem/path.h"
 #include "scone/core/types.h"
+#include "scone/optimization/StatusChannel.h"
 
 namespace scone
 {
@@ -20,5 +21,9 @@ namespace scone
 	protected:
 		QProcess* process_;
 		bool send_process_closed_mesage_;
+
+		// binary status records written by sconecmd, opened once the file has been created
+		path status_file_;
+		u_ptr<StatusChannel> status_channel_;
 	};
 }
@@ -3,7 +3,6 @@
 #include "xo/serialization/serialize.h"
 #include "scone/core/Factories.h"
 #include "scone/optimization/opt_tools.h"
-#include "spot/optimizer.h"
 
 namespace scone
 {
@@ -52,7 +51,7 @@ namespace scone
 	{
 		if ( has_optimizer_ )
 		{
-			dynamic_cast<spot::optimizer&>( *optimizer_ ).interrupt();
+			optimizer_->Interrupt();
 			return true;
 		}
 		else return false;
@@ -39,13 +39,14 @@ std::vector< std::pair< float, float > > SconeStorageDataModel::getSeries( int i
 	{
 		series.reserve( storage->GetFrameCount() ); // this may be a little much, but ensures no reallocation
 		double last_time = timeStart() - 2 * min_interval;
-		for ( size_t i = 0; i < storage->GetFrameCount(); ++i )
+		const auto& times = storage->GetTimes();
+		const auto* values = storage->GetChannelValues( idx ); // only this channel is accessed
+		for ( size_t i = 0; i < times.size(); ++i )
 		{
-			auto& f = storage->GetFrame( i );
-			if ( f.GetTime() - last_time >= min_interval )
+			if ( times[ i ] - last_time >= min_interval )
 			{
-				series.emplace_back( static_cast<float>( f.GetTime() ), static_cast<float>( f[ idx ] ) );
-				last_time = f.GetTime();
+				series.emplace_back( static_cast<float>( times[ i ] ), static_cast<float>( values[ i ] ) );
+				last_time = times[ i ];
 			}
 		}
 	}
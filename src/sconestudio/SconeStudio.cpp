@@ -47,7 +47,6 @@
 #include "vis-osg/osg_tools.h"
 #include "vis/plane.h"
 #include "help_tools.h"
-#include "xo/thread/thread_priority.h"
 #include "file_tools.h"
 
 using namespace scone;
@@ -228,7 +227,7 @@ bool SconeStudio::init()
 	resultsModel = new ResultsFileSystemModel( nullptr );
 	ui.resultsBrowser->setModel( resultsModel );
 	ui.resultsBrowser->setNumColumns( 1 );
-	ui.resultsBrowser->setRoot( to_qt( results_folder ), "*.par;*.sto" );
+	ui.resultsBrowser->setRoot( to_qt( results_folder ), "*.par;*.sto;*.stob" );
 	ui.resultsBrowser->header()->setFrameStyle( QFrame::NoFrame | QFrame::Plain );
 	ui.resultsBrowser->setSelectionMode( QAbstractItemView::ExtendedSelection );
 	ui.resultsBrowser->setSelectionBehavior( QAbstractItemView::SelectRows );
@@ -305,7 +304,7 @@ void SconeStudio::activateBrowserItem( QModelIndex idx )
 		ui.playControl->reset();
 		if ( createScenario( info.absoluteFilePath() ) )
 		{
-			if ( scenario_->IsEvaluating() ) // .par or .sto
+			if ( scenario_->IsEvaluating() ) // .par or .sto / .stob
 				evaluate();
 
 			ui.playControl->setRange( 0, scenario_->GetMaxTime() );
@@ -361,29 +360,27 @@ void SconeStudio::evaluate()
 	dlg.show();
 	QApplication::processEvents();
 
-	xo::scoped_thread_priority prio_raiser( xo::thread_priority::highest );
-
-	const double step_size = 0.01;
-	const xo::time visual_update = 250_ms;
-	xo::time prev_visual_time = xo::time() - visual_update;
+	// simulate on a background thread, while showing the streamed results at display rate
+	const auto visual_update = std::chrono::milliseconds( 40 );
 	xo::timer real_time;
-	for ( double t = step_size; scenario_->IsEvaluating(); t += step_size )
+	scenario_->StartEvaluation();
+	while ( scenario_->IsEvaluating() )
 	{
-		auto rt = real_time();
-		if ( rt - prev_visual_time >= visual_update )
+		std::this_thread::sleep_for( visual_update );
+		scenario_->UpdateEvaluation();
+		if ( !scenario_->IsEvaluating() )
+			break;
+
+		// update 3D visuals and progress bar
+		auto t = scenario_->GetTime();
+		setTime( t, true );
+		dlg.setValue( int( 1000 * t / scenario_->GetMaxTime() ) );
+		if ( dlg.wasCanceled() )
 		{
-			// update 3D visuals and progress bar
-			setTime( t, true );
-			dlg.setValue( int( 1000 * t / scenario_->GetMaxTime() ) );
-			if ( dlg.wasCanceled() )
-			{
-				// user pressed cancel: update data so that user can see results so far
-				scenario_->AbortEvaluation();
-				break;
-			}
-			prev_visual_time = rt;
+			// user pressed cancel: update data so that user can see results so far
+			scenario_->AbortEvaluation();
+			break;
 		}
-		else setTime( t, false );
 	}
 
 	// report duration
@@ -664,7 +661,7 @@ bool SconeStudio::createScenario( const QString& any_file )
 	try
 	{
 		// create scenario and update viewer
-		scenario_ = std::make_unique< StudioModel >( scene_, path_from_qt( any_file ) );
+		scenario_ = std::make_unique< StudioModel >( scene_, path_from_qt( any_file ), scenario_cache_ );
 		updateViewSettings();
 
 		// update analysis and parview
@@ -131,6 +131,7 @@ private:
 
 	// model
 	std::unique_ptr< scone::StudioModel > scenario_;
+	std::shared_ptr< scone::StudioScenario > scenario_cache_; // reused after scenario_ is destroyed
 	bool createScenario( const QString& any_file );
 	bool createAndVerifyActiveScenario( bool always_create );
 
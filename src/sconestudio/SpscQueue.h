@@ -0,0 +1,62 @@
+/*
+** SpscQueue.h
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace scone
+{
+	/// Lock-free bounded queue for passing items from a single producer thread to a single consumer thread.
+	/** The producer only writes tail_ and the consumer only writes head_, so no locks are needed.
+	One slot is kept empty to distinguish a full queue from an empty one.
+	Items are exchanged with the queue slots instead of being moved, so that buffers owned by items
+	(e.g. vectors) are recycled between producer and consumer, instead of being reallocated. */
+	template< typename T >
+	class SpscQueue
+	{
+	public:
+		SpscQueue( size_t capacity ) : buffer_( capacity + 1 ), head_( 0 ), tail_( 0 ) {}
+
+		/// Swap item into the queue (producer only); returns false and leaves item untouched if the queue is full.
+		/// On success, item receives the previous contents of the slot, which were left there by pop().
+		bool push( T& item ) {
+			auto tail = tail_.load( std::memory_order_relaxed );
+			auto next = increment( tail );
+			if ( next == head_.load( std::memory_order_acquire ) )
+				return false;
+			std::swap( buffer_[ tail ], item );
+			tail_.store( next, std::memory_order_release );
+			return true;
+		}
+
+		/// Swap the oldest item out of the queue (consumer only); returns false if the queue is empty.
+		/// The previous contents of item are left in the slot, to be reused by push().
+		bool pop( T& item ) {
+			auto head = head_.load( std::memory_order_relaxed );
+			if ( head == tail_.load( std::memory_order_acquire ) )
+				return false;
+			std::swap( item, buffer_[ head ] );
+			head_.store( increment( head ), std::memory_order_release );
+			return true;
+		}
+
+		bool empty() const { return head_.load( std::memory_order_acquire ) == tail_.load( std::memory_order_acquire ); }
+		size_t capacity() const { return buffer_.size() - 1; }
+
+	private:
+		size_t increment( size_t idx ) const { return idx + 1 < buffer_.size() ? idx + 1 : 0; }
+
+		std::vector< T > buffer_;
+		alignas( 64 ) std::atomic< size_t > head_; // next item to pop, written by consumer
+		alignas( 64 ) std::atomic< size_t > tail_; // next slot to push, written by producer
+	};
+}
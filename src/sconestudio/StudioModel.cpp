@@ -25,62 +25,101 @@
 #include "xo/shape/sphere.h"
 #include "xo/serialization/serialize.h"
 #include "xo/shape/shape_tools.h"
+#include "xo/thread/thread_priority.h"
 
 #include "StudioSettings.h"
 
 #include <QMessageBox>
 #include "qt_convert.h"
 
+#include <sstream>
+
 namespace scone
 {
-	StudioModel::StudioModel( vis::scene& s, const path& file ) :
-		status_( Status::Initializing )
+	namespace
+	{
+		// get the optimizer for a scenario, reusing the cached one if the scenario has not changed and no other model uses it
+		// this way, browsing the results of a single optimization does not create a new objective (and model) each time
+		std::shared_ptr< StudioScenario > AcquireScenario( const path& scenario_file, const path& dir, std::shared_ptr< StudioScenario >& cached_scenario )
+		{
+			auto pn = xo::load_file_with_include( scenario_file, "INCLUDE" );
+			std::stringstream str;
+			str << pn;
+			if ( cached_scenario && cached_scenario.use_count() == 1 && cached_scenario->scenario_file == scenario_file && cached_scenario->dir == dir && cached_scenario->scenario_str == str.str() )
+			{
+				log::debug( "Using cached objective for ", scenario_file );
+				return cached_scenario;
+			}
+
+			auto s = std::make_shared< StudioScenario >();
+			s->scenario_file = scenario_file;
+			s->dir = dir;
+			s->scenario_str = str.str();
+			s->scenario_pn = std::move( pn );
+			s->optimizer = CreateOptimizer( s->scenario_pn, dir );
+			s->info = s->optimizer->GetObjective().info();
+			return cached_scenario = s;
+		}
+	}
+
+	StudioModel::StudioModel( vis::scene& s, const path& file, std::shared_ptr< StudioScenario >& scenario_cache ) :
+		vis_model_( nullptr ),
+		status_( Status::Initializing ),
+		frame_queue_( 4096 ),
+		streamed_frames_( 0 ),
+		streamed_channels_( 0 ),
+		abort_evaluation_( false ),
+		evaluation_finished_( false ),
+		evaluation_time_( 0.0 )
 	{
-		// create the objective from par file or config file
+		// get the objective from par file or config file
 		filename_ = file;
 		scenario_filename_ = FindScenario( file );
-		scenario_pn_ = xo::load_file_with_include( FindScenario( file ), "INCLUDE" );
-		optimizer_ = CreateOptimizer( scenario_pn_, file.parent_path() );
-		objective_ = &optimizer_->GetObjective();
+		scenario_ = AcquireScenario( scenario_filename_, file.parent_path(), scenario_cache );
+		objective_ = &scenario_->optimizer->GetObjective();
+		objective_->info() = scenario_->info; // undo the import of a previous .par file
 		model_objective_ = dynamic_cast<ModelObjective*>( objective_ );
 
 		if ( model_objective_ )
 		{
 			try
 			{
-				// create model from par or with default parameters
-				const auto file_type = file.extension_no_dot();
-				if ( file_type == "par" )
-				{
-					model_objective_->info().import_mean_std( file, true );
-					model_ = model_objective_->CreateModelFromParFile( file );
-				}
-				else  // #todo: use ModelObjective::model_ instead? Needs proper parameter initialization
-				{
-					auto par = SearchPoint( model_objective_->info() );
-					model_ = model_objective_->CreateModelFromParams( par );
-				}
+				// visualize the model of the objective, results are shown by setting its state
+				vis_model_ = &model_objective_->GetModel();
 
-				if ( file_type == "sto" )
+				const auto file_type = file.extension_no_dot();
+				if ( file_type == "sto" || file_type == StorageBinExtension )
 				{
-					// file is a .sto, load results
+					// file is a .sto or binary storage, load results (no need to create a model)
 					xo::timer t;
 					log::debug( "Reading ", file );
-					ReadStorageSto( storage_, file );
+					ReadStorage( storage_, file );
 					InitStateDataIndices();
 					log::trace( "Read ", file, " in ", t(), " seconds" );
 					status_ = Status::Ready;
 				}
 				else
 				{
-					// file is a .par or .scone, setup for evaluation
+					// file is a .par or .scone, create model from par or with default parameters
+					if ( file_type == "par" )
+					{
+						model_objective_->info().import_mean_std( file, true );
+						model_ = model_objective_->CreateModelFromParFile( file );
+					}
+					else
+					{
+						auto par = SearchPoint( model_objective_->info() );
+						model_ = model_objective_->CreateModelFromParams( par );
+					}
+
+					// setup for evaluation
 					status_ = Status::Evaluating;
 					model_->SetStoreData( true );
 					EvaluateTo( 0 ); // evaluate one step so we can init vis
 				}
 
 				// create and init visualizer
-				vis_ = std::make_unique<ModelVis>( *model_, s );
+				vis_ = std::make_unique<ModelVis>( *vis_model_, s );
 				UpdateVis( 0 );
 			}
 			catch ( const std::exception& e )
@@ -97,14 +136,15 @@ namespace scone
 	}
 
 	StudioModel::~StudioModel()
-	{}
+	{
+		StopEvaluationThread();
+	}
 
 	void StudioModel::InitStateDataIndices()
 	{
-		SCONE_ASSERT( model_ );
-		SCONE_ASSERT( state_data_index.empty() );
+		SCONE_ASSERT( vis_model_ );
 		SCONE_ERROR_IF( storage_.IsEmpty(), "Could not find any data" );
-		model_state = model_->GetState();
+		model_state = vis_model_->GetState();
 		state_data_index.resize( model_state.GetSize() );
 		for ( size_t state_idx = 0; state_idx < state_data_index.size(); state_idx++ )
 		{
@@ -116,20 +156,20 @@ namespace scone
 
 	void StudioModel::UpdateVis( TimeInSeconds time )
 	{
-		if ( model_ && vis_ )
+		if ( vis_model_ && vis_ )
 		{
-			SCONE_PROFILE_FUNCTION( model_->GetProfiler() );
+			SCONE_PROFILE_FUNCTION( vis_model_->GetProfiler() );
 			try
 			{
-				if ( !storage_.IsEmpty() && !state_data_index.empty() )
+				if ( HasData() )
 				{
 					// update model state from data
 					for ( index_t i = 0; i < model_state.GetSize(); ++i )
 						model_state[ i ] = storage_.GetInterpolatedValue( time, state_data_index[ i ] );
-					model_->SetState( model_state, time );
+					vis_model_->SetState( model_state, time );
 				}
 
-				vis_->Update( *model_ );
+				vis_->Update( *vis_model_ );
 			}
 			catch ( std::exception& e )
 			{
@@ -140,11 +180,19 @@ namespace scone
 
 	void StudioModel::EvaluateTo( TimeInSeconds t )
 	{
+		if ( IsEvaluatingInBackground() )
+			return; // data is received through UpdateEvaluation()
+
 		if ( model_ && IsEvaluating() )
 		{
 			try
 			{
-				model_objective_->AdvanceSimulationTo( *model_, t );
+				// earlier frames are already in storage_, only simulate forward
+				if ( t >= model_->GetTime() )
+					model_objective_->AdvanceSimulationTo( *model_, t );
+				evaluation_time_ = model_->GetTime();
+				StreamFrames();
+				ReceiveFrames();
 				if ( model_->HasSimulationEnded() )
 					FinalizeEvaluation();
 			}
@@ -156,10 +204,103 @@ namespace scone
 		else log::warning( "Unexpected call to StudioModel::EvaluateTo()" );
 	}
 
+	void StudioModel::StartEvaluation()
+	{
+		SCONE_ASSERT( model_ && IsEvaluating() && !IsEvaluatingInBackground() );
+		abort_evaluation_ = false;
+		evaluation_finished_ = false;
+		evaluation_error_.clear();
+		evaluation_thread_ = std::thread( &StudioModel::EvaluationThread, this );
+	}
+
+	void StudioModel::UpdateEvaluation()
+	{
+		if ( IsEvaluatingInBackground() )
+		{
+			// check before receiving, so that we get all frames if the thread has finished
+			bool finished = evaluation_finished_;
+			ReceiveFrames();
+			if ( finished )
+			{
+				StopEvaluationThread();
+				if ( !evaluation_error_.empty() )
+					InvokeError( evaluation_error_ );
+				else FinalizeEvaluation();
+			}
+		}
+	}
+
+	void StudioModel::StopEvaluationThread()
+	{
+		if ( evaluation_thread_.joinable() )
+		{
+			abort_evaluation_ = true;
+			evaluation_thread_.join();
+		}
+	}
+
+	void StudioModel::EvaluationThread()
+	{
+		// model_ is only accessed by this thread until it is joined
+		xo::scoped_thread_priority prio_raiser( xo::thread_priority::highest );
+		try
+		{
+			const TimeInSeconds step_size = 0.01;
+			while ( !abort_evaluation_ && !model_->HasSimulationEnded() )
+			{
+				model_objective_->AdvanceSimulationTo( *model_, model_->GetTime() + step_size );
+				evaluation_time_ = model_->GetTime();
+				while ( !StreamFrames() && !abort_evaluation_ )
+					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) ); // wait for the ui to catch up
+			}
+		}
+		catch ( const std::exception& e )
+		{
+			evaluation_error_ = e.what();
+		}
+		evaluation_finished_ = true;
+	}
+
+	bool StudioModel::StreamFrames()
+	{
+		// push frames that were added to the model data since the previous call, returns false if the queue is full
+		const auto& data = model_->GetData();
+		for ( ; streamed_frames_ < data.GetFrameCount(); ++streamed_frames_ )
+		{
+			// values are copied into the buffers of the frame that was returned by the previous push
+			const auto& frame = data.GetFrame( streamed_frames_ );
+			auto& f = push_frame_;
+			f.time = frame.GetTime();
+			frame.GetValues().CopyTo( f.values );
+			if ( data.GetChannelCount() != streamed_channels_ )
+				f.labels = data.GetLabels();
+			else f.labels.clear();
+			if ( !frame_queue_.push( f ) )
+				return false;
+			streamed_channels_ = data.GetChannelCount();
+		}
+		return true;
+	}
+
+	void StudioModel::ReceiveFrames()
+	{
+		for ( auto& f = pop_frame_; frame_queue_.pop( f ); )
+		{
+			for ( index_t c = storage_.GetChannelCount(); c < f.labels.size(); ++c )
+				storage_.AddChannel( f.labels[ c ] );
+			auto& frame = storage_.AddFrame( f.time );
+			for ( index_t c = 0; c < f.values.size(); ++c )
+				frame[ c ] = f.values[ c ];
+		}
+		if ( state_data_index.empty() && !storage_.IsEmpty() )
+			InitStateDataIndices();
+	}
+
 	void StudioModel::AbortEvaluation()
 	{
 		try
 		{
+			StopEvaluationThread();
 			status_ = Status::Aborted;
 			storage_ = model_->GetData();
 			InitStateDataIndices();
@@ -185,8 +326,9 @@ namespace scone
 		{
 			try
 			{
-				// fetch data
+				// fetch all data, including the final frame
 				storage_ = model_->GetData();
+				evaluation_time_ = model_->GetTime();
 				InitStateDataIndices();
 
 				// show fitness results
@@ -236,14 +378,14 @@ namespace scone
 		if ( vis_ )
 		{
 			vis_->ApplyViewSettings( flags );
-			vis_->Update( *model_ );
+			vis_->Update( *vis_model_ );
 		}
 	}
 
 	Vec3 StudioModel::GetFollowPoint() const
 	{
-		auto com = model_->GetComPos();
-		if ( auto gp = model_->GetGroundPlane() )
+		auto com = vis_model_->GetComPos();
+		if ( auto gp = vis_model_->GetGroundPlane() )
 		{
 			auto l = xo::linef( xo::vec3f( com ), xo::vec3f::neg_unit_y() );
 			auto& p = std::get<xo::plane>( gp->GetShape() );
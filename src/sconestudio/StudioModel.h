@@ -18,26 +18,48 @@
 #include "scone/optimization/Optimizer.h"
 
 #include "ModelVis.h"
+#include "SpscQueue.h"
 #include "qt_convert.h"
 
+#include <atomic>
+#include <thread>
+
 namespace scone
 {
+	/// Scenario props and optimizer, which are reused by subsequent StudioModels that are opened from the same scenario file.
+	struct StudioScenario
+	{
+		path scenario_file;
+		path dir;
+		String scenario_str; // scenario props before they were used, to detect changes
+		PropNode scenario_pn; // optimizer refers to these props, so they are declared first
+		OptimizerUP optimizer;
+		ObjectiveInfo info; // parameter info before importing a .par file
+	};
+
 	class StudioModel
 	{
 	public:
-		StudioModel( vis::scene& s, const path& filename );
+		/// Reuses scenario_cache if it matches the scenario of filename and is not used by another StudioModel, otherwise replaces it.
+		StudioModel( vis::scene& s, const path& filename, std::shared_ptr< StudioScenario >& scenario_cache );
 		virtual ~StudioModel();
 
 		void UpdateVis( TimeInSeconds t );
 		void EvaluateTo( TimeInSeconds t );
 
+		/// Start simulating on a background thread; results are received through UpdateEvaluation().
+		void StartEvaluation();
+		/// Receive frames from the background thread and finalize the evaluation when it has finished.
+		void UpdateEvaluation();
+		bool IsEvaluatingInBackground() const { return evaluation_thread_.joinable(); }
+
 		void AbortEvaluation();
 
 		const Storage<>& GetData() { return storage_; }
-		bool HasModel() const { return bool( model_ ) && IsValid(); }
+		bool HasModel() const { return ( model_ || vis_model_ ) && IsValid(); }
 		bool HasData() const { return !storage_.IsEmpty() && !state_data_index.empty(); }
 
-		Model& GetModel() { return *model_; }
+		Model& GetModel() { return model_ ? *model_ : *vis_model_; }
 		const Objective& GetOjective() const { return *objective_; }
 		ModelObjective& GetModelObjective() const { return *model_objective_; }
 
@@ -45,7 +67,7 @@ namespace scone
 		bool IsReady() const { return status_ == Status::Ready; }
 		bool IsValid() const { return status_ != Status::Error; }
 
-		TimeInSeconds GetTime() const { return model_ ? model_->GetTime() : 0.0; }
+		TimeInSeconds GetTime() const { return evaluation_time_; }
 		TimeInSeconds GetMaxTime() const;
 
 		void ApplyViewSettings( const ModelVis::ViewSettings& f );
@@ -53,7 +75,7 @@ namespace scone
 
 		const path& GetFileName() const { return filename_; }
 		QString GetScenarioFileName() const { return to_qt( scenario_filename_ ); }
-		const PropNode& GetScenarioProps() const { return scenario_pn_; }
+		const PropNode& GetScenarioProps() const { return scenario_->scenario_pn; }
 
 		enum class Status { Initializing, Evaluating, Ready, Aborted, Error };
 		Status GetStatus() const { return status_; }
@@ -63,23 +85,45 @@ namespace scone
 	private:
 		void FinalizeEvaluation();
 		void InvokeError( const String& message );
+		void StopEvaluationThread();
+		void EvaluationThread();
+		bool StreamFrames();
+		void ReceiveFrames();
 
-		// visualizer
+		// visualizer, which shows the model of the objective so that it doesn't interfere with evaluation
 		u_ptr<ModelVis> vis_;
+		Model* vis_model_;
 
 		// model / scenario data
 		Storage<> storage_;
-		OptimizerUP optimizer_;
+		std::shared_ptr< StudioScenario > scenario_;
 		Objective* objective_;
 		ModelObjective* model_objective_;
-		ModelUP model_;
+		ModelUP model_; // only created for evaluation
 		path filename_;
 		path scenario_filename_;
-		PropNode scenario_pn_;
 
 		Status status_;
 
-		//bool is_evaluating_;
+		// frames that are passed from the evaluation thread to storage_
+		struct StreamedFrame
+		{
+			TimeInSeconds time;
+			std::vector< Real > values;
+			std::vector< String > labels; // only set when channels were added since the previous frame
+		};
+		SpscQueue< StreamedFrame > frame_queue_;
+		StreamedFrame push_frame_; // owned by the evaluation thread
+		StreamedFrame pop_frame_; // owned by the ui thread
+		size_t streamed_frames_;
+		size_t streamed_channels_;
+
+		// background evaluation
+		std::thread evaluation_thread_;
+		std::atomic< bool > abort_evaluation_;
+		std::atomic< bool > evaluation_finished_;
+		std::atomic< TimeInSeconds > evaluation_time_;
+		String evaluation_error_;
 
 		// model state
 		std::vector< size_t > state_data_index;
@@ -0,0 +1,132 @@
+/*
+** model_test.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "scone/model/SensorDelayBuffer.h"
+#include "scone/core/AllocationCounter.h"
+#include "scone/core/Log.h"
+#include "scone/core/string_tools.h"
+#include "scone/core/system_tools.h"
+#include "scone/optimization/ModelObjective.h"
+#include "scone/optimization/opt_tools.h"
+#include "xo/serialization/serialize.h"
+#include "xo/system/test_case.h"
+
+using namespace scone;
+
+XO_TEST_CASE( sensor_delay_buffer_test )
+{
+	SensorDelayBuffer buf;
+	buf.SetStepSize( 0.01 );
+	auto c0 = buf.AddChannel();
+	auto c1 = buf.AddChannel();
+	buf.Reserve( 0.035 );
+	XO_CHECK( buf.GetCapacity() >= 5 );
+
+	// channel 0 contains the frame index, channel 1 its negative
+	const size_t frames = 20;
+	for ( index_t f = 0; f < frames; ++f )
+	{
+		buf.AddFrame( f * 0.01 );
+		buf.Back( c0 ) = Real( f );
+		buf.Back( c1 ) = -Real( f );
+	}
+	XO_CHECK( buf.GetFrameCount() == frames );
+	XO_CHECK( buf.GetSize() == buf.GetCapacity() );
+	XO_CHECK( buf.GetSample( c0, 0 ) == 19 );
+	XO_CHECK( buf.GetSample( c1, 3 ) == -16 );
+
+	// reads beyond the oldest sample are clamped
+	XO_CHECK( buf.GetSample( c0, 1000 ) == Real( frames - buf.GetSize() ) );
+
+	// interpolated taps
+	auto tap = buf.GetTap( 0.035 );
+	XO_CHECK( tap.offset == 3 );
+	XO_CHECK( std::abs( tap.weight - 0.5 ) < 1e-9 );
+	XO_CHECK( std::abs( buf.GetValue( c0, tap ) - 15.5 ) < 1e-9 );
+	XO_CHECK( std::abs( buf.GetValue( c1, tap ) + 15.5 ) < 1e-9 );
+
+	// growing the buffer keeps the most recent frames
+	auto old_size = buf.GetSize();
+	buf.ReserveSamples( 16 );
+	XO_CHECK( buf.GetSize() == old_size );
+	XO_CHECK( buf.GetSample( c0, 0 ) == 19 );
+	XO_CHECK( buf.GetSample( c0, old_size - 1 ) == Real( frames - old_size ) );
+	auto c2 = buf.AddChannel();
+	XO_CHECK( buf.GetSample( c1, 2 ) == -17 );
+	XO_CHECK( buf.GetSample( c2, 0 ) == 0 );
+
+	buf.Clear();
+	XO_CHECK( buf.IsEmpty() && buf.GetFrameCount() == 0 );
+}
+
+XO_TEST_CASE( model_checkpoint_test )
+{
+	// continuing from a checkpoint before the first perturbation should give the result of a full evaluation
+	auto scenario_file = GetFolder( SCONE_ROOT_FOLDER ) / "scenarios/Tutorials/Tutorial 4c - Perturbed Gait.scone";
+	auto scenario_pn = xo::load_file_with_include( scenario_file, "INCLUDE" );
+	scenario_pn.get_child( "CmaOptimizer" ).get_child( "SimulationObjective" ).set( "max_duration", 6 );
+	auto optimizer = CreateOptimizer( scenario_pn, scenario_file.parent_path() );
+	auto& mo = dynamic_cast< ModelObjective& >( optimizer->GetObjective() );
+
+	SearchPoint point( mo.info() );
+	auto full = mo.evaluate( point, xo::stop_token() );
+	XO_CHECK( full );
+
+	// multiple continuations can be forked from the same checkpoint
+	auto cp = mo.CreateCheckpoint( point, 2.5 );
+	for ( int fork = 0; fork < 2; ++fork )
+	{
+		auto forked = mo.EvaluateFromCheckpoint( point, cp, xo::stop_token() );
+		XO_CHECK( forked );
+		if ( full && forked )
+			XO_CHECK_MESSAGE( std::abs( forked.value() - full.value() ) <= 1e-3 * std::abs( full.value() ),
+				"full=" + to_str( full.value() ) + " forked=" + to_str( forked.value() ) );
+	}
+}
+
+XO_TEST_CASE( model_allocation_test )
+{
+	// requires a build with SCONE_COUNT_ALLOCATIONS
+	if ( !IsAllocationCountingEnabled() )
+	{
+		log::info( "Skipping model_allocation_test, allocation counting is not enabled" );
+		return;
+	}
+
+	auto scenario_file = GetFolder( SCONE_ROOT_FOLDER ) / "scenarios/Tutorials/Tutorial 2a - Standing High Jump.scone";
+	auto scenario_pn = xo::load_file_with_include( scenario_file, "INCLUDE" );
+	auto optimizer = CreateOptimizer( scenario_pn, scenario_file.parent_path() );
+	auto& mo = dynamic_cast< ModelObjective& >( optimizer->GetObjective() );
+	SearchPoint point( mo.info() );
+
+	// the second run uses a model that is reset instead of created
+	for ( int run = 0; run < 2; ++run )
+	{
+		auto model = mo.AcquireModel( point );
+		model->SetBenchmarking( true );
+
+		// the arena block is owned by the model and kept after reset
+		auto allocs = GetThreadAllocationCount();
+		model->GetArena().allocate( 1024 );
+		XO_CHECK_MESSAGE( GetThreadAllocationCount() == allocs, "run=" + to_str( run ) );
+
+		// FeedForwardController uses the arena and does not allocate during simulation
+		model->AdvanceSimulationTo( model->GetSimulationEndTime() );
+		bool has_controller_allocs = false;
+		for ( const auto& [name, per_call] : model->GetBenchmarkAllocations() )
+		{
+			if ( name == "ControllerAllocations" )
+			{
+				has_controller_allocs = true;
+				XO_CHECK_MESSAGE( per_call == 0, "run=" + to_str( run ) + " allocations per call=" + to_str( per_call ) );
+			}
+		}
+		XO_CHECK( has_controller_allocs );
+		mo.ReleaseModel( std::move( model ) );
+	}
+}
@@ -8,8 +8,12 @@
 
 #include "scone/core/Factories.h"
 #include "scone/core/math.h"
+#include "scone/core/string_tools.h"
+#include "scone/core/system_tools.h"
 #include "scone/optimization/CmaOptimizerSpot.h"
+#include "scone/optimization/ModelObjective.h"
 #include "scone/optimization/Objective.h"
+#include "scone/optimization/ProcessEvaluator.h"
 #include "scone/optimization/opt_tools.h"
 
 #include "xo/filesystem/filesystem.h"
@@ -17,8 +21,33 @@
 #include "xo/serialization/serialize.h"
 #include "xo/system/test_case.h"
 
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
 using namespace scone;
 
+namespace
+{
+	// run an optimizer on a TestObjective function and return the best fitness
+	double optimize_test_function( const String& optimizer, const String& function, int dim, int max_generations )
+	{
+		PropNode pn;
+		auto& opt_pn = pn.add_child( optimizer );
+		opt_pn.set( "max_generations", max_generations );
+		opt_pn.set( "max_threads", 4 );
+		opt_pn.set( "flat_fitness_epsilon", 1e-12 );
+		opt_pn.set( "output_root", xo::temp_directory_path() / "SCONE/optimization_test" );
+		auto& obj_pn = opt_pn.add_child( "TestObjective" );
+		obj_pn.set( "dim", dim );
+		obj_pn.set( "function", function );
+
+		OptimizerUP o = CreateOptimizer( pn, xo::temp_directory_path() );
+		o->Run();
+		return o->GetBestFitness();
+	}
+}
+
 XO_TEST_CASE( optimization_test )
 {
 	auto test_folder = scone::GetFolder( scone::SCONE_ROOT_FOLDER ) / "resources/unittestdata/optimization_test";
@@ -30,3 +59,67 @@ XO_TEST_CASE( optimization_test )
 
 	XO_CHECK_MESSAGE( o->GetBestFitness() < 1000.0, to_str( o->GetBestFitness() ) );
 }
+
+XO_TEST_CASE( async_cma_optimizer_test )
+{
+	// AsyncCmaOptimizer should converge like CmaOptimizerSpot with the same number of updates
+	for ( auto&& [function, max_generations, threshold] : { std::tuple( "sphere", 300, 1e-8 ), std::tuple( "rosenbrock", 2000, 1e-6 ) } )
+	{
+		auto spot_fitness = optimize_test_function( "CmaOptimizerSpot", function, 10, max_generations );
+		auto async_fitness = optimize_test_function( "AsyncCmaOptimizer", function, 10, max_generations );
+		auto message = stringf( "%s: CmaOptimizerSpot=%g AsyncCmaOptimizer=%g", function, spot_fitness, async_fitness );
+		XO_CHECK_MESSAGE( spot_fitness < threshold, message );
+		XO_CHECK_MESSAGE( async_fitness < threshold, message );
+		XO_CHECK_MESSAGE( async_fitness < 100 * spot_fitness + 1e-12, message );
+	}
+}
+
+XO_TEST_CASE( process_evaluator_rollouts_test )
+{
+	// rollouts in worker processes should use the seeds of the current generation, like local rollouts
+	auto scenario_file = GetFolder( SCONE_ROOT_FOLDER ) / "scenarios/Tutorials/Tutorial 3b - Standing Balance - Motor Noise.scone";
+	auto scenario_pn = xo::load_file_with_include( scenario_file, "INCLUDE" );
+	auto& obj_pn = scenario_pn.get_child( "CmaOptimizer" ).get_child( "SimulationObjective" );
+	obj_pn.set( "max_duration", 2 );
+	obj_pn.set( "rollouts", 2 );
+	auto optimizer = CreateOptimizer( scenario_pn, scenario_file.parent_path() );
+	auto& mo = dynamic_cast< ModelObjective& >( optimizer->GetObjective() );
+
+	ProcessEvaluator pe( 2 );
+	pe.AddScenario( mo, scenario_pn, scenario_file.parent_path() );
+	const spot::search_point_vec points( 3, SearchPoint( mo.info() ) );
+	std::vector< double > generation_fitness;
+	for ( int generation = 0; generation < 2; ++generation )
+	{
+		mo.BeginGeneration( 2 );
+		pe.BeginGeneration( mo, 2, mo.GetRolloutSeedOffset() );
+		auto local = mo.evaluate( points.front(), xo::stop_token() );
+		auto remote = pe.evaluate( mo, points, xo::stop_token(), 0 );
+		XO_CHECK( local );
+		for ( auto& r : remote )
+		{
+			XO_CHECK_MESSAGE( r, r ? String() : r.error().message() );
+			if ( local && r )
+				XO_CHECK_MESSAGE( std::abs( r.value() - local.value() ) <= 1e-9 * std::abs( local.value() ),
+					"local=" + to_str( local.value() ) + " remote=" + to_str( r.value() ) );
+		}
+		if ( local )
+			generation_fitness.push_back( local.value() );
+	}
+	pe.RemoveScenario( mo );
+
+	// each generation uses new seeds
+	XO_CHECK( generation_fitness.size() == 2 && generation_fitness[ 0 ] != generation_fitness[ 1 ] );
+}
+
+XO_TEST_CASE( find_par_files_test )
+{
+	// the latest .par file has the highest generation, which is not zero-padded
+	auto folder = std::filesystem::temp_directory_path() / "SCONE/find_par_files_test";
+	std::filesystem::create_directories( folder );
+	for ( auto name : { "9999_1.000_1.000.par", "10000_2.000_2.000.par", "998_3.000_3.000.par" } )
+		std::ofstream( folder / name );
+	auto par_files = FindParFiles( { folder.string() } );
+	XO_CHECK( par_files.size() == 1 && par_files.front().filename().str() == "10000_2.000_2.000.par" );
+	std::filesystem::remove_all( folder );
+}
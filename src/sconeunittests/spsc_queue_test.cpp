@@ -0,0 +1,84 @@
+/*
+** spsc_queue_test.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "../sconestudio/SpscQueue.h"
+#include "xo/system/test_case.h"
+
+#include <thread>
+#include <vector>
+
+using namespace scone;
+
+XO_TEST_CASE( spsc_queue_swap_test )
+{
+	SpscQueue< std::vector< int > > q( 2 );
+	XO_CHECK( q.capacity() == 2 && q.empty() );
+
+	// push swaps the item with the (empty) slot
+	std::vector< int > item{ 1, 2, 3 };
+	XO_CHECK( q.push( item ) );
+	XO_CHECK( item.empty() );
+	item = { 4 };
+	XO_CHECK( q.push( item ) );
+
+	// a full queue leaves the item untouched
+	item = { 5 };
+	XO_CHECK( !q.push( item ) );
+	XO_CHECK( item == std::vector< int >{ 5 } );
+
+	// pop swaps the oldest item out, leaving the buffer of the popped-into item in the slot
+	std::vector< int > popped;
+	popped.reserve( 100 );
+	auto* recycled_data = popped.data();
+	XO_CHECK( q.pop( popped ) );
+	XO_CHECK( popped == ( std::vector< int >{ 1, 2, 3 } ) );
+	XO_CHECK( q.push( item ) );
+	XO_CHECK( q.pop( popped ) && popped == std::vector< int >{ 4 } );
+	XO_CHECK( q.pop( popped ) && popped == std::vector< int >{ 5 } );
+	XO_CHECK( !q.pop( popped ) && q.empty() );
+
+	// after wrapping around, the producer receives the buffer that was left in the first slot by the first pop
+	for ( int i = 0; i < 3; ++i )
+	{
+		std::vector< int > v{ i };
+		XO_CHECK( q.push( v ) );
+		XO_CHECK( q.pop( v ) && v == std::vector< int >{ i } );
+	}
+	std::vector< int > v{ 6 };
+	XO_CHECK( q.push( v ) );
+	XO_CHECK( v.data() == recycled_data && v.capacity() >= 100 );
+}
+
+XO_TEST_CASE( spsc_queue_thread_test )
+{
+	// all items arrive in order when producer and consumer run concurrently
+	const int item_count = 100000;
+	SpscQueue< std::vector< int > > q( 16 );
+	std::thread producer( [&]() {
+		std::vector< int > item;
+		for ( int i = 0; i < item_count; )
+		{
+			item.assign( 3, i );
+			if ( q.push( item ) )
+				++i;
+			else std::this_thread::yield();
+		}
+	} );
+
+	int errors = 0;
+	std::vector< int > item;
+	for ( int i = 0; i < item_count; )
+	{
+		if ( q.pop( item ) )
+			errors += item != std::vector< int >( 3, i++ );
+		else std::this_thread::yield();
+	}
+	producer.join();
+	XO_CHECK( errors == 0 );
+	XO_CHECK( q.empty() );
+}
@@ -0,0 +1,106 @@
+/*
+** status_channel_test.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "scone/optimization/StatusChannel.h"
+#include "xo/filesystem/filesystem.h"
+#include "xo/system/test_case.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace scone;
+
+namespace
+{
+	StatusRecord make_generation_record( size_t step )
+	{
+		StatusRecord r;
+		r.type = StatusRecord::Generation;
+		r.step = r.number_of_evaluations = step;
+		r.best = double( step );
+		r.SetId( "test" );
+		return r;
+	}
+
+	// a record is consistent if all fields were written by the same Write()
+	bool is_consistent( const StatusRecord& r )
+	{
+		return r.type == StatusRecord::Generation && r.number_of_evaluations == r.step && r.best == double( r.step );
+	}
+}
+
+XO_TEST_CASE( status_channel_overwrite_test )
+{
+	const auto file = xo::temp_directory_path() / "scone_status_channel_test.bin";
+	const size_t capacity = 8;
+	StatusChannel writer( file, StatusChannel::WriteMode, capacity );
+	StatusChannel reader( file, StatusChannel::ReadMode );
+
+	// records within capacity are all received
+	for ( size_t i = 0; i < 5; ++i )
+		writer.Write( make_generation_record( i ) );
+	auto records = reader.Read();
+	XO_CHECK( records.size() == 5 && reader.GetLostRecordCount() == 0 );
+	XO_CHECK( records.front().step == 0 && records.back().step == 4 );
+	XO_CHECK( reader.Read().empty() );
+
+	// records that are overwritten before reading are skipped and counted
+	for ( size_t i = 5; i < 25; ++i )
+		writer.Write( make_generation_record( i ) );
+	records = reader.Read();
+	XO_CHECK( records.size() == capacity );
+	XO_CHECK( reader.GetLostRecordCount() == 20 - capacity );
+	for ( index_t i = 0; i < records.size(); ++i )
+		XO_CHECK( records[ i ].step == 25 - capacity + i && is_consistent( records[ i ] ) );
+}
+
+XO_TEST_CASE( status_channel_concurrent_test )
+{
+	// records that are being overwritten while reading are discarded, all others are consistent and in order
+	const auto file = xo::temp_directory_path() / "scone_status_channel_concurrent_test.bin";
+	const size_t record_count = 200000;
+	StatusChannel writer( file, StatusChannel::WriteMode, 4 );
+	StatusChannel reader( file, StatusChannel::ReadMode );
+
+	std::atomic< bool > done = false;
+	std::thread writer_thread( [&]() {
+		for ( size_t i = 0; i < record_count; ++i )
+			writer.Write( make_generation_record( i ) );
+		done = true;
+	} );
+
+	size_t received = 0, inconsistent = 0, unordered = 0;
+	size_t next_step = 0;
+	for ( bool finished = false; !finished; )
+	{
+		finished = done; // read once more after the writer has finished
+		for ( auto& r : reader.Read() )
+		{
+			inconsistent += !is_consistent( r );
+			unordered += r.step < next_step;
+			next_step = r.step + 1;
+			++received;
+		}
+	}
+	writer_thread.join();
+
+	XO_CHECK( inconsistent == 0 );
+	XO_CHECK( unordered == 0 );
+	XO_CHECK( received + reader.GetLostRecordCount() == record_count );
+	XO_CHECK( next_step == record_count );
+}
+
+XO_TEST_CASE( status_record_overflow_test )
+{
+	// strings that don't fit are reported, so the writer can fall back to text messages
+	StatusRecord r;
+	XO_CHECK( r.SetText( String( sizeof( r.text ) - 1, 'x' ) ) );
+	XO_CHECK( !r.SetText( String( sizeof( r.text ), 'x' ) ) );
+	XO_CHECK( !r.SetId( String( sizeof( r.id ), 'x' ) ) );
+	XO_CHECK( r.id[ sizeof( r.id ) - 1 ] == 0 );
+}
@@ -0,0 +1,154 @@
+/*
+** storage_test.cpp
+**
+** Copyright (C) 2013-2019 Thomas Geijtenbeek and contributors. All rights reserved.
+**
+** This file is part of SCONE. For more information, see http://scone.software.
+*/
+
+#include "scone/core/Storage.h"
+#include "scone/core/StorageIo.h"
+#include "xo/filesystem/filesystem.h"
+#include "xo/system/test_case.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace scone;
+
+XO_TEST_CASE( storage_columnar_test )
+{
+	Storage<> sto;
+	auto a = sto.AddChannel( "a" );
+	for ( index_t f = 0; f < 100; ++f )
+	{
+		auto& frame = sto.AddFrame( 0.01 * f );
+		frame[ a ] = Real( f );
+		frame[ "b" ] = -Real( f ); // adds channel b on the first frame
+	}
+	auto b = sto.GetChannelIndex( "b" );
+	XO_CHECK( sto.GetChannelCount() == 2 && sto.GetFrameCount() == 100 );
+
+	// channels are contiguous
+	auto* bv = sto.GetChannelValues( b );
+	for ( index_t f = 0; f < 100; ++f )
+		XO_CHECK( bv[ f ] == -Real( f ) );
+
+	// adding a channel keeps existing data and sets the default value
+	auto c = sto.AddChannel( "c", 3.0 );
+	XO_CHECK( sto.GetFrame( 42 )[ a ] == 42 && sto.GetFrame( 42 )[ c ] == 3.0 );
+
+	// frame views
+	auto values = sto.GetFrame( 7 ).GetValues();
+	XO_CHECK( values.size() == 3 );
+	XO_CHECK( values[ 0 ] == 7 && values[ 1 ] == -7 && values[ 2 ] == 3 );
+	std::vector< Real > copy;
+	values.CopyTo( copy );
+	XO_CHECK( copy == values.ToVector() && copy.size() == 3 );
+
+	// interpolation
+	XO_CHECK( std::abs( sto.GetInterpolatedValue( 0.055, a ) - 5.5 ) < 1e-9 );
+	XO_CHECK( sto.GetInterpolatedValue( -1.0, b ) == 0 );
+	XO_CHECK( sto.GetInterpolatedValue( 10.0, b ) == -99 );
+
+	// copies are independent
+	auto sto2 = sto;
+	sto2.GetFrame( 0 )[ a ] = 1000;
+	XO_CHECK( sto.GetFrame( 0 )[ a ] == 0 && sto2.GetFrame( 0 )[ a ] == 1000 );
+	XO_CHECK( sto.GetSchemaId() != sto2.GetSchemaId() );
+
+	// slices
+	auto slice = sto.CopySlice( 1, 0, 10 );
+	XO_CHECK( slice.GetFrameCount() == 10 && slice.GetFrame( 2 )[ a ] == 21 );
+}
+
+XO_TEST_CASE( storage_external_data_test )
+{
+	// channel-major external values
+	auto owner = std::make_shared< std::vector< Real > >( std::vector< Real >{ 1, 2, 3, 10, 20, 30 } );
+	Storage<> sto;
+	const auto& csto = sto; // non-const access makes a channel writable
+	sto.SetExternalData( { "x", "y" }, { 0.0, 1.0, 2.0 }, owner->data(), owner );
+	XO_CHECK( sto.HasExternalData() );
+	XO_CHECK( sto.GetChannelValues( 1 ) == owner->data() + 3 );
+	XO_CHECK( csto.GetFrame( 2 )[ 1 ] == 30 );
+
+	// writing only copies the modified channel
+	sto.GetFrame( 0 )[ 0 ] = -1;
+	XO_CHECK( sto.HasExternalData() );
+	XO_CHECK( ( *owner )[ 0 ] == 1 && csto.GetFrame( 0 )[ 0 ] == -1 && csto.GetFrame( 1 )[ 0 ] == 2 );
+	XO_CHECK( sto.GetChannelValues( 1 ) == owner->data() + 3 );
+	XO_CHECK( csto.GetFrame( 1 ).GetValues()[ 1 ] == 20 );
+
+	// adding frames copies all data
+	sto.AddFrame( 3.0 )[ 1 ] = 40;
+	XO_CHECK( !sto.HasExternalData() );
+	XO_CHECK( sto.GetFrame( 0 )[ 0 ] == -1 && sto.GetFrame( 2 )[ 1 ] == 30 && sto.GetFrame( 3 )[ 1 ] == 40 );
+}
+
+XO_TEST_CASE( storage_bin_test )
+{
+	Storage<> sto;
+	for ( index_t f = 0; f < 50; ++f )
+	{
+		auto& frame = sto.AddFrame( 0.1 * f );
+		frame[ "a" ] = Real( f );
+		frame[ "b.with spaces" ] = 0.5 * f;
+	}
+
+	auto file = xo::temp_directory_path() / "scone_storage_bin_test.stob";
+	WriteStorage( sto, file, "test" );
+	Storage<> sto2;
+	ReadStorage( sto2, file );
+	XO_CHECK( sto2.HasExternalData() );
+	XO_CHECK( sto2.GetLabels() == sto.GetLabels() );
+	XO_CHECK( sto2.GetTimes() == sto.GetTimes() );
+	for ( index_t c = 0; c < sto.GetChannelCount(); ++c )
+		XO_CHECK( std::equal( sto.GetChannelValues( c ), sto.GetChannelValues( c ) + sto.GetFrameCount(), sto2.GetChannelValues( c ) ) );
+
+	// rewriting a file that is still mapped leaves the mapped data intact
+	Storage<> sto3;
+	sto3.AddFrame( 0.0 )[ "c" ] = 1.0;
+	WriteStorage( sto3, file, "test" );
+	XO_CHECK( sto2.GetFrameCount() == 50 && sto2.GetFrame( 49 )[ 0 ] == 49 );
+	Storage<> sto4;
+	ReadStorage( sto4, file );
+	XO_CHECK( sto4.GetFrameCount() == 1 && sto4.GetLabels() == sto3.GetLabels() );
+
+	// truncated files are rejected
+	auto trunc_file = xo::temp_directory_path() / "scone_storage_bin_test_truncated.stob";
+	{
+		std::ifstream in( file.str(), std::ios::binary );
+		String data( ( std::istreambuf_iterator< char >( in ) ), std::istreambuf_iterator< char >() );
+		std::ofstream out( trunc_file.str(), std::ios::binary );
+		out.write( data.data(), data.size() - 8 );
+	}
+	bool rejected = false;
+	try { ReadStorage( sto2, trunc_file ); }
+	catch ( std::exception& ) { rejected = true; }
+	XO_CHECK( rejected );
+
+	sto2.Clear();
+	std::remove( file.c_str() );
+	std::remove( trunc_file.c_str() );
+}
+
+XO_TEST_CASE( storage_cached_test )
+{
+	Storage<> sto;
+	sto.AddFrame( 0.0 )[ "a" ] = 1.0;
+	auto file = xo::temp_directory_path() / "scone_storage_cached_test.stob";
+	WriteStorage( sto, file, "test" );
+	auto sto1 = ReadStorageCached( file );
+	XO_CHECK( ReadStorageCached( file ) == sto1 );
+
+	// a file that is rewritten within the same second is read again
+	sto.GetFrame( 0 )[ 0 ] = 2.0;
+	WriteStorage( sto, file, "test" );
+	auto sto2 = ReadStorageCached( file );
+	XO_CHECK( sto2 != sto1 && sto2->GetFrame( 0 )[ 0 ] == 2.0 );
+
+	sto1.reset();
+	sto2.reset();
+	std::remove( file.c_str() );
+}